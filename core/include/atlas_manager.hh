@@ -5,8 +5,10 @@
 #ifndef ATLAS_MANAGER_HH
 #define ATLAS_MANAGER_HH
 
+// C++標準ライブラリ
+#include <atomic>       // std::atomic_bool
+
 // shark lib
-#include "mutex.hh"
 #include "audio_player.hh"  // オーディオ制御
 #if ATLAS_FORMAT == ATLAS_FULL_SPEC
 #include "motor_driver.hh"  // モーター制御
@@ -18,6 +20,13 @@
 #include "params.hh"    // パラメータ
 #include "state.hh"
 #include "view.hh"      // 画面表示
+#include "heap_monitor.hh"  // ヒープ使用状況
+#include "latency_probe.hh" // 遅延の計測
+#include "boot_profile.hh"  // 起動の時間
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+#include "launch_sequencer.hh"  // 射出シーケンサー
+#include "motor_calibration.hh" // SP較正
+#endif
 
 namespace atlas {
 //-----------------------------------------------------------------------------
@@ -36,16 +45,22 @@ public:
         @brief  モードの設定
         @param[in]  isAutoMode  オートモードか否か
     */
-    void setMode(bool isAutoMode);
+    inline void setMode(bool isAutoMode) noexcept {
+        _isAutoMode.store(isAutoMode);
+    }
 
     //! オートモードかどうかを返す
-    bool isAutoMode() const;
+    inline bool isAutoMode() const noexcept {
+        return _isAutoMode.load();
+    }
 
     //! マニュアルモードかどうかを返す
-    bool isManualMode() const;
+    inline bool isManualMode() const noexcept {
+        return !_isAutoMode.load();
+    }
 
     //! モードを切り替える
-    void switchMode();
+    void switchMode() noexcept;
 
     //! 統計情報を取得
     const Statistics& statistics() const noexcept;
@@ -61,6 +76,12 @@ public:
     // モーター制御インスタンス
 #if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
     shark::MotorDriver motors[NUM_MOTORS];
+
+    //! 射出シーケンサー
+    LaunchSequencer launcher;
+
+    //! SP較正
+    MotorCalibration calib;
 #endif
 
     //! 統計データ
@@ -75,15 +96,21 @@ public:
     //! 画面表示
     View view;
 
+    //! ヒープ使用状況
+    HeapMonitor heap;
+
+    //! 遅延の計測
+    LatencyProbes latency;
+
+    //! 起動の段階ごとの時刻
+    BootProfile boot;
+
 protected:
     AtlasManager();
 
 private:
-    //! オートモードかどうかのフラグ
-    bool _isAutoMode = true;
-
-    //! 排他制御
-    mutable shark::Mutex _mutexMode;
+    //! オートモードかどうかのフラグ（モードのループが頻繁に読むのでロックしない）
+    std::atomic_bool _isAutoMode {true};
 };
 
 extern AtlasManager& ATLAS;
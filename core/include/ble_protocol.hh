@@ -0,0 +1,341 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_BLE_PROTOCOL_HH
+#define ATLAS_BLE_PROTOCOL_HH
+
+// C++標準ライブラリ
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+// ATLAS
+#include "raw_record.hh"
+#include "setting.hh"
+
+/*
+    ATLASのGATTサービスのプロトコル
+
+    ファームウェアのコールバック（mode_manual.cc）と、ホスト（PC）のクライアント・
+    エミュレーター（tools/common/atlas_client.hh, atlas_emulator.hh）が共有する部分。
+    BLEのスタックにもOSにも依存しないので、ホストでもそのままビルドできる。
+
+    キャラクタリスティックの一覧は X(名前, UUID, プロパティ) の並びで、
+    途中に挿入・削除せず末尾に追加すること。
+*/
+#define ATLAS_CHARACTERISTICS(X) \
+    X(DEVINFO,   ATLAS_CHR_DEVINFO,   READ) \
+    X(HEAPINFO,  ATLAS_CHR_HEAPINFO,  READ) \
+    X(RENDER,    ATLAS_CHR_RENDER,    READ) \
+    X(LATENCY,   ATLAS_CHR_LATENCY,   READ | WRITE) \
+    X(TRACE,     ATLAS_CHR_TRACE,     NOTIFY) \
+    X(PARAMS,    ATLAS_CHR_PARAMS,    READ | WRITE) \
+    X(RESULT,    ATLAS_CHR_RESULT,    READ | WRITE) \
+    X(RAW_CTRL,  ATLAS_CHR_RAW_CTRL,  READ | WRITE) \
+    X(RAW_DATA,  ATLAS_CHR_RAW_DATA,  NOTIFY) \
+    X(SHOOT,     ATLAS_CHR_SHOOT,     WRITE) \
+    X(LAUNCH,    ATLAS_CHR_LAUNCH,    READ) \
+    X(CALIB,     ATLAS_CHR_CALIB,     READ | WRITE) \
+    X(SYNC,      ATLAS_CHR_SYNC,      WRITE) \
+    X(SWITCH,    ATLAS_CHR_SWITCH,    WRITE) \
+    X(BOOT,      ATLAS_CHR_BOOT,      READ)
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! キャラクタリスティック
+enum class Characteristic : std::uint8_t
+{
+#define ATLAS_CHARACTERISTIC_ENUM(name, uuid, props) name,
+    ATLAS_CHARACTERISTICS(ATLAS_CHARACTERISTIC_ENUM)
+#undef ATLAS_CHARACTERISTIC_ENUM
+    NUM_CHARACTERISTICS
+};
+
+//! キャラクタリスティックのプロパティ（ビットの組み合わせ）
+namespace property {
+constexpr std::uint8_t READ   = 0x01;   //!< 読み出し
+constexpr std::uint8_t WRITE  = 0x02;   //!< 書き込み（応答あり）
+constexpr std::uint8_t NOTIFY = 0x04;   //!< 通知
+} // namespace property
+
+//! キャラクタリスティックの定義
+struct CharacteristicSpec
+{
+    Characteristic id;          //!< キャラクタリスティック
+    const char* name;           //!< 名前
+    const char* uuid;           //!< UUID（大文字）
+    std::uint8_t properties;    //!< プロパティ
+};
+
+//! キャラクタリスティックの定義を返す
+const CharacteristicSpec& characteristicSpec(Characteristic chr) noexcept;
+
+//! UUID（大文字・小文字を問わない）からキャラクタリスティックを探す（なければ nullptr）
+const CharacteristicSpec* findCharacteristic(const char* uuid) noexcept;
+
+//=============================================================================
+// 生データの転送（RAW_CTRL / RAW_DATA）
+//=============================================================================
+/*
+    1. クライアントは RAW_CTRL を読んで生データファイルのサイズ（uint32）を得る
+    2. RAW_DATA を購読し、RAW_CTRL に開始コマンドを書き込む
+    3. ペリフェラルは [シーケンス番号 (uint16), データ] の通知を、
+       ACKを待たずに RAW_WINDOW_SIZE 個まで送る（シーケンス番号は転送ごとに0から）
+    4. クライアントは受信した通知のシーケンス番号を seq として、
+       (seq + 1) が RAW_WINDOW_SIZE の倍数のとき、または最後の通知で、
+       RAW_CTRL に seq（2バイト）を書き込んでACKする
+    5. データの長さはMTUで変わるので、クライアントは受信した順に連結する
+
+    切断などで途中で終わったときは、受信済みのバイト数を付けた再開コマンドを書き込むと、
+    その位置から送り直す（古いクライアントは使わないので、互換性は保たれる）。
+*/
+
+//! 送信ウィンドウ（ACKを待たずに送る通知の数）
+constexpr std::uint16_t RAW_WINDOW_SIZE = 10;
+
+//! 通知の先頭のシーケンス番号のバイト数
+constexpr std::uint16_t RAW_HEADER_SIZE = 2;
+
+//! 通知1つのデータの最大バイト数（3レコード分）
+constexpr std::uint16_t RAW_MAX_PAYLOAD = sizeof(RawRecord) * 3;
+
+//! ATTの通知のヘッダーのバイト数（オペコード1, ハンドル2）
+constexpr std::uint16_t ATT_NOTIFY_OVERHEAD = 3;
+
+//! ACKを待つ最大時間 [ms]（クライアントが応答しなくなったら転送をやめる）
+constexpr std::uint32_t RAW_ACK_TIMEOUT = 5000;
+
+static_assert(RAW_MAX_PAYLOAD + RAW_HEADER_SIZE + ATT_NOTIFY_OVERHEAD <= ATLAS_MTU_SIZE,
+              "raw data packet does not fit in ATLAS_MTU_SIZE");
+
+/*!
+    @brief  MTUで送れる通知1つのデータのバイト数
+    @param[in]  mtu  ATTのMTU（交換前は23）
+*/
+constexpr std::uint16_t rawPayloadSize(std::uint16_t mtu) noexcept
+{
+    const int room = static_cast<int>(mtu) - ATT_NOTIFY_OVERHEAD - RAW_HEADER_SIZE;
+    return room >= RAW_MAX_PAYLOAD ? RAW_MAX_PAYLOAD
+         : room > 0                ? static_cast<std::uint16_t>(room)
+         :                           1;
+}
+
+//! size バイトを送る通知の数
+constexpr std::uint32_t rawNumPackets(std::uint32_t size, std::uint16_t payloadSize) noexcept
+{
+    return (size + payloadSize - 1) / payloadSize;
+}
+
+/*!
+    @brief  RAW_CTRL への書き込み
+
+    ------------------------------------------------------------
+     長さ   内容
+    ------------------------------------------------------------
+      2     ACK（受信した通知のシーケンス番号, リトルエンディアン）
+      5     0x02 + 再開するバイト位置（uint32, リトルエンディアン）
+     その他 転送開始（Webアプリは 0x01 を書き込む）
+    ------------------------------------------------------------
+*/
+struct RawCtrlCommand
+{
+    //! コマンドの種類
+    enum class Type : std::uint8_t
+    {
+        INVALID,    //!< 不正（空の書き込み）
+        START,      //!< 先頭から転送する
+        ACK,        //!< 受信の確認
+        RESUME      //!< 途中から転送する
+    };
+
+    //! 再開コマンドの先頭のバイト
+    static constexpr std::uint8_t RESUME_CODE = 0x02;
+
+    //! 書き込みの最大バイト数
+    static constexpr std::size_t MAX_SIZE = 5;
+
+    Type type;              //!< 種類
+    std::uint16_t seq;      //!< ACKするシーケンス番号（ACK）
+    std::uint32_t offset;   //!< 再開するバイト位置（RESUME）
+
+    //! 書き込まれた値を解釈する
+    static RawCtrlCommand decode(const std::uint8_t* data, std::size_t size) noexcept;
+
+    /*!
+        @brief  書き込む値を作る
+        @param[out]  data  MAX_SIZE バイト以上の領域
+        @return      バイト数（INVALID なら0）
+    */
+    std::size_t encode(std::uint8_t* data) const noexcept;
+};
+
+static_assert(std::is_trivially_copyable_v<RawCtrlCommand>,
+              "'RawCtrlCommand' is not trivially copyable");
+
+/*!
+    @brief  生データの送信側（ペリフェラル）
+
+    通知・ファイル・待ちの実装は Port で差し替える（実機は NimBLE と SPIFFS、
+    ホストはエミュレーター）。ブロックするので、専用のタスクから呼ぶこと。
+*/
+class RawSender
+{
+public:
+    //! 送信に使う入出力
+    class Port
+    {
+    public:
+        //! データを size バイトまで読み込む（読めたバイト数を返す）
+        virtual std::size_t read(std::uint8_t* data, std::size_t size) = 0;
+
+        //! 通知を送る（送信バッファが一杯なら false）
+        virtual bool notify(const std::uint8_t* data, std::size_t size) = 0;
+
+        //! 送信バッファが空くまで少し待つ
+        virtual void waitTxSpace() = 0;
+
+        //! ACK・中断の知らせを timeout [ms] まで待つ（知らせがあれば true）
+        virtual bool waitAck(std::uint32_t timeout) = 0;
+
+        //! 受信したACKを1つ取り出す（なければ false）
+        virtual bool takeAck(std::uint16_t& seq) = 0;
+
+        //! 転送をやめるべきか（切断・購読の解除・新しいコマンド）
+        virtual bool aborted() = 0;
+
+        //! ACKで進んだ（トレース用。ACK済みのパケット数, 全パケット数）
+        virtual void acked(std::uint16_t, std::uint16_t) {}
+
+    protected:
+        ~Port() = default;
+    };
+
+    //! 転送の結果
+    enum class Status : std::uint8_t
+    {
+        DONE,       //!< 全てACKされた
+        ABORTED,    //!< 中断された
+        TIMEOUT,    //!< ACKが来なくなった
+        READ_ERROR, //!< データを読めなかった
+        NONE = 0xFF //!< 転送していない
+    };
+
+    //! 転送の結果と進み
+    struct Outcome
+    {
+        Status status;          //!< 結果
+        std::uint16_t sent;     //!< 送った通知の数
+        std::uint16_t acked;    //!< ACKされた通知の数
+        std::uint32_t bytes;    //!< ACKされたバイト数
+    };
+
+    /*!
+        @brief  size バイトを送る（シーケンス番号は0から）
+        @param[in]  port         入出力
+        @param[in]  size         送るバイト数（再開なら残りのバイト数）
+        @param[in]  payloadSize  通知1つのデータのバイト数（RAW_MAX_PAYLOAD 以下）
+    */
+    static Outcome run(Port& port, std::uint32_t size, std::uint16_t payloadSize);
+};
+
+/*!
+    @brief  RAW_CTRL の読み出し値（生データファイルのサイズと、直前の転送の結果）
+
+    先頭の size は従来の読み出し値（uint32）と同じなので、先頭の4バイトだけを読む
+    クライアントもそのまま使える。接続間隔・LLの最大ペイロード・PHYはペリフェラルが
+    知らされた値で、バルク転送の要求がセントラルに受け入れられたかどうかが分かる。
+
+    ------------------------------------------------------------
+     オフセット  幅    内容
+    ------------------------------------------------------------
+        0       4    生データファイルのバイト数
+        4       4    ACKされたバイト数
+        8       4    転送の時間 [ms]
+       12       4    スループット [bytes/s]
+       16       2    送った通知の数
+       18       2    転送の終わりの接続間隔 [1.25ms]
+       20       2    転送の終わりのLLの最大ペイロード [bytes]（送信側）
+       22       1    転送の終わりのPHY（1: 1M, 2: 2M, 3: Coded）
+       23       1    結果（RawSender::Status、0xFFなら転送していない）
+    ------------------------------------------------------------
+*/
+struct RawTransferReport
+{
+    std::uint32_t size;         //!< 生データファイルのバイト数
+    std::uint32_t bytes;        //!< ACKされたバイト数
+    std::uint32_t elapsed;      //!< 転送の時間 [ms]
+    std::uint32_t goodput;      //!< スループット [bytes/s]
+    std::uint16_t packets;      //!< 送った通知の数
+    std::uint16_t interval;     //!< 転送の終わりの接続間隔 [1.25ms]
+    std::uint16_t dataLength;   //!< 転送の終わりのLLの最大ペイロード [bytes]
+    std::uint8_t phy;           //!< 転送の終わりのPHY
+    std::uint8_t status;        //!< 結果
+
+    //! 転送していない状態にする
+    void clear() noexcept;
+
+    //! 転送の結果を記録する（スループットを求める）
+    void record(const RawSender::Outcome& outcome, std::uint32_t elapsedMs) noexcept;
+};
+
+static_assert(sizeof(RawTransferReport) == 24,
+              "Size of 'RawTransferReport' is not 24 bytes");
+
+static_assert(std::is_trivially_copyable_v<RawTransferReport>,
+              "'RawTransferReport' is not trivially copyable");
+
+/*!
+    @brief  生データの受信側（クライアント）
+
+    通知を受信した順に領域へ連結し、ACKを送るべきときを知らせる。
+*/
+class RawReceiver
+{
+public:
+    //! 通知を受け取った結果
+    enum class Event : std::uint8_t
+    {
+        NONE,   //!< 受信した（何もしなくてよい）
+        ACK,    //!< 受信した（ackSeq() をACKする）
+        DONE,   //!< 受信し終えた（ackSeq() をACKする）
+        INVALID //!< シーケンス番号の飛び・長すぎるデータ
+    };
+
+    /*!
+        @brief  受信を始める
+        @param[out]  buffer  ファイル全体の領域（size バイト）
+        @param[in]   size    ファイルのバイト数
+        @param[in]   offset  受信済みのバイト数（再開なら RawCtrlCommand::offset と同じ）
+    */
+    void begin(std::uint8_t* buffer, std::uint32_t size, std::uint32_t offset) noexcept;
+
+    //! 通知を受け取る
+    Event onPacket(const std::uint8_t* data, std::size_t size) noexcept;
+
+    //! 受信済みのバイト数
+    inline std::uint32_t received() const noexcept {
+        return _received;
+    }
+
+    //! 受信し終えたか
+    inline bool done() const noexcept {
+        return _received >= _size;
+    }
+
+    //! ACKするシーケンス番号（最後に受け取った通知）
+    inline std::uint16_t ackSeq() const noexcept {
+        return static_cast<std::uint16_t>(_nextSeq - 1);
+    }
+
+private:
+    std::uint8_t* _buffer = nullptr;
+    std::uint32_t _size = 0;
+    std::uint32_t _received = 0;
+    std::uint16_t _nextSeq = 0;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
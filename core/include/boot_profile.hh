@@ -0,0 +1,109 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_BOOT_PROFILE_HH
+#define ATLAS_BOOT_PROFILE_HH
+
+// C++標準ライブラリ
+#include <atomic>       // std::atomic_uint16_t, std::atomic_uint32_t
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+/*
+    起動の段階の一覧
+
+    X(名前, 説明) の並びの順番が段階の番号（BLEで送るレポートの並び）になる。
+    途中に挿入・削除せず末尾に追加すること。
+    FLASH_MOUNT, FILES_LOADED, AUDIO は裏のタスクが記録するので、他の段階と前後する。
+*/
+#define ATLAS_BOOT_STAGES(X) \
+    X(SETUP,         "setup() entered") \
+    X(DISPLAY,       "display started") \
+    X(SPLASH,        "splash requested") \
+    X(FLASH_MOUNT,   "flash mounted") \
+    X(FILES_LOADED,  "files loaded") \
+    X(MOTORS,        "motors configured") \
+    X(SWITCH,        "switch started") \
+    X(READY,         "ready (splash ends)") \
+    X(AUDIO,         "audio player started") \
+    X(BBP_CONNECTED, "first BBP connection") \
+    X(FIRST_LAUNCH,  "first launch command")
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 起動の段階
+enum class BootStage : std::uint8_t
+{
+#define ATLAS_BOOT_STAGE_ENUM(name, label) name,
+    ATLAS_BOOT_STAGES(ATLAS_BOOT_STAGE_ENUM)
+#undef ATLAS_BOOT_STAGE_ENUM
+    NUM_STAGES
+};
+
+/*!
+    @brief  起動の段階ごとの時刻のレポート（BLEで送信する）
+
+    時刻は起動からの時間（os::now() の下位32ビット）。まだ到達していない段階は0。
+    failed のビット k が立っていれば、段階 k は失敗した（ファイルがなく既定値を使った、
+    音声プレイヤーが応答しなかった、など）。
+*/
+struct BootReport
+{
+    static constexpr std::uint8_t NUM_STAGES = static_cast<std::uint8_t>(BootStage::NUM_STAGES);
+
+    std::uint8_t numStages;     //!< 段階の数
+    std::uint8_t reserved;      //!< 予約領域
+    std::uint16_t failed;       //!< 失敗した段階（ビット）
+    std::uint32_t stamps[NUM_STAGES];   //!< 段階ごとの時刻 [us]
+};
+
+static_assert(sizeof(BootReport) == 4 + 4 * BootReport::NUM_STAGES,
+              "Unexpected size of 'BootReport'");
+
+static_assert(BootReport::NUM_STAGES <= 16,
+              "'BootReport::failed' cannot hold all stages");
+
+static_assert(std::is_trivially_copyable_v<BootReport>,
+              "'BootReport' is not trivially copyable");
+
+/*!
+    @brief  起動の段階ごとの時刻を記録するクラス
+
+    起動は表示・ファイルの読み込み・音声プレイヤーの開始を別々のタスクで並行して行うので、
+    どのタスクからも記録できる。段階ごとに最初の1回だけを記録する（射出や接続のように
+    繰り返すものは、起動から最初の1回までの時間になる）。
+*/
+class BootProfile
+{
+public:
+    /*!
+        @brief  段階に到達したことを記録する（2回目以降は何もしない）
+        @param[in]  stage  段階
+        @param[in]  ok     成功したかどうか
+    */
+    void mark(BootStage stage, bool ok = true) noexcept;
+
+    /*!
+        @brief  段階ごとの時刻をシリアルに出力する（リリースビルドでは何もしない）
+
+        mark() は射出や接続の処理からも呼ばれるので、出力はここでまとめて行う。
+        裏のタスクが記録する段階は、まだ到達していなければ pending と出力する。
+    */
+    void print() const noexcept;
+
+    //! 段階に到達したかどうか
+    bool reached(BootStage stage) const noexcept;
+
+    //! レポートを返す
+    BootReport report() const noexcept;
+
+private:
+    std::atomic_uint32_t _stamps[BootReport::NUM_STAGES] {};
+    std::atomic_uint16_t _failed {0};
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -0,0 +1,67 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_HEAP_MONITOR_HH
+#define ATLAS_HEAP_MONITOR_HH
+
+// C++標準ライブラリ
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! ヒープの使用状況
+struct HeapSnapshot
+{
+    std::uint32_t freeHeap;     //!< 空きヒープ [bytes]
+    std::uint32_t minFreeHeap;  //!< 起動以来の最小空きヒープ [bytes]
+    std::uint32_t largestBlock; //!< 確保可能な最大の連続領域 [bytes]
+
+    //! 現在の使用状況を取得する
+    static HeapSnapshot now() noexcept;
+};
+
+static_assert(sizeof(HeapSnapshot) == 12,
+              "Size of 'HeapSnapshot' is not 12 bytes");
+
+/*!
+    @brief  ヒープ使用状況のレポート（BLEで送信する）
+
+    history はモード遷移ごとのリングバッファで、
+    最新の記録は history[(transitions - 1) % HISTORY_SIZE] に格納される。
+*/
+struct HeapReport
+{
+    static constexpr std::uint32_t HISTORY_SIZE = 8;
+
+    std::uint16_t transitions;  //!< 起動以来のモード遷移の回数
+    std::uint16_t reserved;     //!< 予約領域
+    HeapSnapshot current;       //!< 読み出し時点の使用状況
+    HeapSnapshot history[HISTORY_SIZE]; //!< モード遷移時の使用状況
+};
+
+static_assert(sizeof(HeapReport) == 112,
+              "Size of 'HeapReport' is not 112 bytes");
+
+static_assert(std::is_trivially_copyable_v<HeapReport>,
+              "'HeapReport' is not trivially copyable");
+
+//! モード遷移ごとのヒープ使用状況を記録するクラス
+class HeapMonitor
+{
+public:
+    //! モード遷移時の使用状況を記録する
+    void record() noexcept;
+
+    //! 現在の使用状況を含むレポートを返す
+    HeapReport report() const noexcept;
+
+private:
+    HeapReport _report {};
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -11,13 +11,13 @@
 // Arduino
 #include <Arduino.h> // PROGMEM
 
+// shark lib
+#include "packed_bitmap.hh"
+
 namespace atlas {
 namespace img {
 //-----------------------------------------------------------------------------
 
-//! さめ大臣ロゴ, 76x52px
-extern const std::uint8_t sharkMinisterLogo[] PROGMEM;
-
 //! オートモードでのベイバトルパスの接続を促すメッセージ, 119x22px
 extern const std::uint8_t promotion_BBP[] PROGMEM;
 
@@ -69,17 +69,23 @@ extern const std::uint8_t rangeSymbol [] PROGMEM;
 // 'crc-error', 98x26px
 extern const std::uint8_t crcError [] PROGMEM;
 
-// 'ELR_Canceled', 92x26px
-extern const std::uint8_t elrCanceled [] PROGMEM;
+// 以下は PackBits で圧縮した画像（images_packed.cc）。
+// core/assets/images のPBMから tools/image_pack で生成する。
+
+//! さめ大臣ロゴ, 76x52px
+extern const shark::PackedBitmap sharkMinisterLogo;
+
+//! 'ELR_Canceled', 92x26px
+extern const shark::PackedBitmap elrCanceled;
 
 //! カウントダウン用'Go-', 50x21px
-extern const std::uint8_t cndGo[] PROGMEM;
+extern const shark::PackedBitmap cndGo;
 
 //! カウントダウン用'Ready Set', 57x29px
-extern const std::uint8_t cndReadyset[] PROGMEM;
+extern const shark::PackedBitmap cndReadyset;
 
 //! カウントダウン用'Shoot!', 97x21px
-extern const std::uint8_t cndShoot[] PROGMEM;
+extern const shark::PackedBitmap cndShoot;
 
 //-----------------------------------------------------------------------------
 } // namespace img
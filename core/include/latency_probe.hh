@@ -0,0 +1,152 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_LATENCY_PROBE_HH
+#define ATLAS_LATENCY_PROBE_HH
+
+// C++標準ライブラリ
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+/*
+    計測点の一覧
+
+    X(名前, 説明) の並びの順番が計測点の番号（BLEで送るレポートの並び）になる。
+    途中に挿入・削除せず末尾に追加すること。
+*/
+#define ATLAS_LATENCY_PROBES(X) \
+    X(BBP_ANALYZE,    "first frame -> FINISHED") \
+    X(RESULT_UPDATE,  "Result::update") \
+    X(FLASH_WRITE,    "flash write") \
+    X(DISPLAY_FLUSH,  "display flush") \
+    X(SHOT_TO_STOP,   "shot -> motor stop")
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 計測点
+enum class Probe : std::uint8_t
+{
+#define ATLAS_PROBE_ENUM(name, label) name,
+    ATLAS_LATENCY_PROBES(ATLAS_PROBE_ENUM)
+#undef ATLAS_PROBE_ENUM
+    NUM_PROBES
+};
+
+/*!
+    @brief  1つの計測点の遅延のヒストグラム（BLEで送信する）
+
+    buckets[0] は 0〜1us、buckets[k] は 2^k 〜 2^(k+1)-1 us の回数
+    （最後のビンはそれ以上をすべて含む。65535回で飽和する）。
+    p50 / p99 はビンの中で対数の目盛りで補間した値（誤差はビンの幅の範囲）。
+*/
+struct LatencyHistogram
+{
+    static constexpr std::uint8_t NUM_BUCKETS = 24;
+
+    std::uint32_t count;    //!< 計測回数
+    std::uint32_t min;      //!< 最小 [us]
+    std::uint32_t max;      //!< 最大 [us]
+    std::uint32_t p50;      //!< 中央値 [us]
+    std::uint32_t p99;      //!< 99パーセンタイル [us]
+    std::uint16_t buckets[NUM_BUCKETS]; //!< 対数（2のべき）のビンごとの回数
+};
+
+static_assert(sizeof(LatencyHistogram) == 68,
+              "Size of 'LatencyHistogram' is not 68 bytes");
+
+//! 全計測点のレポート（BLEで送信する）
+struct LatencyReport
+{
+    static constexpr std::uint8_t NUM_PROBES = static_cast<std::uint8_t>(Probe::NUM_PROBES);
+
+    std::uint8_t numProbes;     //!< 計測点の数
+    std::uint8_t numBuckets;    //!< ビンの数
+    std::uint16_t reserved;     //!< 予約領域
+    LatencyHistogram probes[NUM_PROBES];    //!< 計測点ごとのヒストグラム
+};
+
+static_assert(sizeof(LatencyReport) == 4 + 68 * LatencyReport::NUM_PROBES,
+              "Unexpected size of 'LatencyReport'");
+
+static_assert(sizeof(LatencyReport) <= 512,
+              "'LatencyReport' does not fit in a characteristic");
+
+static_assert(std::is_trivially_copyable_v<LatencyReport>,
+              "'LatencyReport' is not trivially copyable");
+
+/*!
+    @brief  計測点ごとの遅延を記録するクラス
+
+    時間はCPUのサイクルカウンタで測る（esp_timer より軽く、分解能が高い）。
+    サイクルカウンタは約26秒で1周するので、それより長い区間は
+    呼び出し側で測った時間を record() に渡す。
+*/
+class LatencyProbes
+{
+public:
+    //! 現在のサイクルカウンタ
+    static std::uint32_t cycles() noexcept;
+
+    //! 遅延を記録する [us]
+    void record(Probe probe, std::uint32_t us) noexcept;
+
+    //! サイクルカウンタの差で遅延を記録する
+    void recordCycles(Probe probe, std::uint32_t cycles) noexcept;
+
+    //! レポートを返す（パーセンタイルを求める）
+    LatencyReport report() const noexcept;
+
+    //! 記録を消去する
+    void clear() noexcept;
+
+private:
+    //! 計測点ごとの記録（ヒストグラムの p50 / p99 は report() で求める）
+    LatencyHistogram _probes[LatencyReport::NUM_PROBES] {};
+};
+
+/*!
+    @brief  生成から破棄までの時間を記録するタイマー
+
+    @code
+    {
+        ScopedLatency timer(ATLAS.latency, Probe::RESULT_UPDATE);
+        ATLAS.result.update(...);
+    }
+    @endcode
+*/
+class ScopedLatency
+{
+public:
+    inline ScopedLatency(LatencyProbes& probes, Probe probe) noexcept
+        : _probes(probes)
+        , _probe(probe)
+        , _start(LatencyProbes::cycles())
+    {
+    }
+
+    inline ~ScopedLatency() {
+        if (_active) {
+            _probes.recordCycles(_probe, LatencyProbes::cycles() - _start);
+        }
+    }
+
+    //! 記録しないことにする（計測の対象外だった場合）
+    inline void cancel() noexcept {
+        _active = false;
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyProbes& _probes;
+    Probe _probe;
+    std::uint32_t _start;
+    bool _active = true;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
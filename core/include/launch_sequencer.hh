@@ -0,0 +1,191 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_LAUNCH_SEQUENCER_HH
+#define ATLAS_LAUNCH_SEQUENCER_HH
+
+// C++標準ライブラリ
+#include <atomic>       // std::atomic
+#include <cstdint>      // std::uint8_t, std::int32_t, std::int64_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+// shark lib
+#include "mutex.hh"
+#include "os.hh"
+
+// ATLAS
+#include "setting.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 射出シーケンサーへの指令
+enum class LaunchCommand
+    : std::uint8_t
+{
+    AUTO_START,     //!< オートモードの射出開始（ベイの装着）
+    ABORT,          //!< 射出の中止（猶予時間内のベイの取り外し）
+    MANUAL_SHOOT,   //!< マニュアル射出
+    SYNC_CALIBRATE, //!< 音声の同期調整時間の較正
+};
+
+//! 射出シーケンサーの状態
+enum class LaunchState
+    : std::uint8_t
+{
+    IDLE,           //!< 指令待ち
+    ARMED,          //!< 猶予時間中（中止可能）
+    COUNTDOWN,      //!< カウントダウン中
+    SHOOT,          //!< 射出（モーター停止待ち）
+    CALIBRATING,    //!< 音声の同期調整時間の較正中
+};
+
+/*!
+    @brief  射出タイミングの計測結果（BLEで送信する）
+
+    射出指令を受け取ってからモーターが停止するまでの時間を計測し、
+    停止タイマーにセットした目標時刻との差を誤差として集計する。
+    複数のモーターを駆動したときは、最初と最後の停止時刻の差をスキューとする。
+    時間の単位はすべてマイクロ秒。
+*/
+struct LaunchTiming
+{
+    std::uint32_t count;        //!< 計測回数
+    std::uint32_t lastLatency;  //!< 直近の指令からモーター停止までの時間
+    std::int32_t lastError;     //!< 直近の誤差（実測 - 目標）
+    std::int32_t minError;      //!< 誤差の最小値
+    std::int32_t maxError;      //!< 誤差の最大値
+    std::int32_t meanError;     //!< 誤差の平均値
+    std::uint32_t jitter;       //!< 誤差の標準偏差
+    std::uint32_t lastSkew;     //!< 直近のモーター間の停止時刻の差
+    std::uint32_t maxSkew;      //!< モーター間の停止時刻の差の最大値
+};
+
+static_assert(sizeof(LaunchTiming) == 36,
+              "Size of 'LaunchTiming' is not 36 bytes");
+
+static_assert(std::is_trivially_copyable_v<LaunchTiming>,
+              "'LaunchTiming' is not trivially copyable");
+
+//! 直近の射出（SP較正の学習に使う）
+struct LaunchShot
+{
+    std::uint8_t motor;     //!< 駆動したモーター
+    std::uint8_t duty;      //!< PWMデューティ比
+    std::uint32_t time;     //!< モーターを停止した時刻 [ms]
+};
+
+/*!
+    @brief  射出シーケンサー
+
+    起動時に常駐タスクとキューを静的領域に確保し、
+    射出のたびにタスクを生成しない。BLEコールバックは post() で指令を送るだけで、
+    カウントダウン・表示・音声・モーター制御はシーケンサーが
+    状態遷移（IDLE → ARMED → COUNTDOWN → SHOOT → IDLE）として実行する。
+    モーターの加速はタイマー駆動（MotorDriver::rotateAsync）で、カウントダウンと並行して進む。
+    モーターの停止はカウントダウン開始時に決めた絶対時刻に
+    ハードウェアタイマーで行い、複数のモーターは1回のコールバックで続けて停止させる。
+*/
+class LaunchSequencer
+{
+public:
+    //! タスクと資源を確保して起動する（起動時に1度だけ呼ぶ）
+    void begin();
+
+    /*!
+        @brief  指令を送る（ブロックしない）
+        @param[in]  cmd  指令
+        @return     キューに積めたかどうか
+    */
+    bool post(LaunchCommand cmd);
+
+    //! 現在の状態を返す
+    inline LaunchState state() const noexcept {
+        return _state.load();
+    }
+
+    //! 射出を中止できる状態かどうかを返す
+    inline bool isAbortable() const noexcept {
+        return _state.load() == LaunchState::ARMED;
+    }
+
+    //! 射出タイミングの計測結果を返す
+    LaunchTiming timing() const;
+
+    /*!
+        @brief  直近のオートモードの射出を取り出す（1度取り出すと消える）
+        @param[out]  shot  直近の射出
+        @return      未取り出しの射出があったかどうか
+    */
+    bool takeLastShot(LaunchShot& shot);
+
+private:
+    //! シーケンサーへのメッセージ
+    struct Message
+    {
+        LaunchCommand cmd;  //!< 指令
+        std::int64_t time;  //!< 指令を受け取った時刻 [us]
+    };
+
+    //! 指令キューの長さ
+    static constexpr std::uint32_t QUEUE_LENGTH = 4;
+
+    //! シーケンサーのタスク
+    static void _taskSequencer(void* pvParams);
+
+    //! オートモードの射出
+    void _runAuto(const Message& msg);
+
+    //! マニュアルモードの射出
+    void _runManual(const Message& msg);
+
+    //! 音声の同期調整時間の較正
+    void _runSyncCalibration();
+
+    //! 猶予時間の間、中止指令を待つ
+    bool _waitAbort(std::uint32_t ms);
+
+    /*!
+        @brief  射出の準備（モーターに指令を送る前に呼ぶ）
+        @param[in]  mask    駆動するモーター（ビットマスク）
+        @param[in]  target  停止の目標時刻 [us]
+        @param[in]  settle  全モーターの回転準備完了から停止までの最低時間 [ms]
+    */
+    void _prepare(std::uint32_t mask, std::int64_t target, std::uint32_t settle);
+
+    /*!
+        @brief  全モーターの停止を待って計測結果を記録する
+        @param[in]  command  射出指令を受けた時刻 [us]
+        @return 時間内に停止したかどうか（しなければ全モーターを止めてエラーを知らせる）
+    */
+    bool _waitStop(std::int64_t command);
+
+    //! 停止待ちの時間切れ（全モーターを止めて射出の情報を消す）
+    void _abortStop(std::uint32_t timeout);
+
+    //! 計測結果の記録
+    void _record(std::int64_t latency, std::int64_t error, std::int64_t skew);
+
+private:
+    std::atomic<LaunchState> _state {LaunchState::IDLE};
+
+    //! シーケンサーへの指令
+    shark::os::StaticQueue<Message, QUEUE_LENGTH> _queue;
+
+    //! 計測結果
+    LaunchTiming _timing {};
+    std::int64_t _sumError = 0;     //!< 誤差の合計
+    std::uint64_t _sumError2 = 0;   //!< 誤差の2乗の合計
+
+    //! 直近のオートモードの射出
+    LaunchShot _lastShot {};
+    bool _hasLastShot = false;
+
+    //! 排他制御
+    mutable shark::Mutex _mutexTiming;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
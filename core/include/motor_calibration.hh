@@ -0,0 +1,105 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_MOTOR_CALIBRATION_HH
+#define ATLAS_MOTOR_CALIBRATION_HH
+
+// C++標準ライブラリ
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  モーター1台分のデューティ比 → SP の対応表
+
+    デューティ比 15, 31, ..., 255 の16点でのSPを保持する。
+    未学習の点はモーターの最大回転数からの線形モデルの値で埋める。
+*/
+struct CalibrationTable
+{
+    //! 対応表の点数
+    static constexpr std::uint32_t NUM_POINTS = 16;
+
+    //! i番目の点のデューティ比
+    static constexpr std::uint32_t dutyAt(std::uint32_t i) noexcept {
+        return 16 * i + 15;
+    }
+
+    std::uint16_t sp[NUM_POINTS];       //!< 各点のSP
+    std::uint8_t count[NUM_POINTS];     //!< 各点の学習回数（255で飽和）
+};
+
+static_assert(sizeof(CalibrationTable) == 48,
+              "Size of 'CalibrationTable' is not 48 bytes");
+
+/*!
+    @brief  電動ランチャーのSP較正
+
+    電動ランチャーで射出したときにベイバトルパスで計測された
+    SP（evalSP）から、モーターごとにデューティ比 → SP の対応表を学習し、
+    射出時には目標SPからデューティ比を逆補間で求める（固定小数点）。
+    ファイル（CALIB_FPATH）への保存とBLEでの送受信はこのクラスを
+    そのままバイト列として扱う。
+*/
+class MotorCalibration
+{
+public:
+    //! 対応できるモーターの最大数
+    static constexpr std::uint32_t MAX_MOTORS = 2;
+
+    /*!
+        @brief  目標SPに対するデューティ比を返す
+        @param[in]  motor  モーター番号
+        @param[in]  sp     目標SP
+        @return     デューティ比 (1 - 255)
+    */
+    std::uint8_t duty(std::uint32_t motor, std::uint32_t sp) const noexcept;
+
+    /*!
+        @brief  デューティ比に対するSPの予測値を返す
+        @param[in]  motor  モーター番号
+        @param[in]  duty   デューティ比
+    */
+    std::uint32_t sp(std::uint32_t motor, std::uint32_t duty) const noexcept;
+
+    /*!
+        @brief  射出結果から対応表を学習する
+        @param[in]  motor     モーター番号
+        @param[in]  duty      射出時のデューティ比
+        @param[in]  measured  計測されたSP
+        @return     学習に使ったかどうか（外れ値は捨てる）
+    */
+    bool learn(std::uint32_t motor, std::uint32_t duty, std::uint32_t measured) noexcept;
+
+    //! 対応表の学習回数の合計を返す
+    std::uint32_t samples(std::uint32_t motor) const noexcept;
+
+    //! 指定したモーターの対応表を線形モデルに戻す
+    void reset(std::uint32_t motor) noexcept;
+
+    //! 値を適正化する（SPがデューティ比に対して単調増加になるようにする）
+    void regulate() noexcept;
+
+    //! 値を初期化する
+    void initialize() noexcept;
+
+private:
+    //! モーターごとの対応表
+    CalibrationTable _tables[MAX_MOTORS];
+};
+
+static_assert(sizeof(MotorCalibration) == 96,
+              "Size of 'MotorCalibration' is not 96 bytes");
+
+static_assert(std::is_trivially_copyable_v<MotorCalibration>,
+              "'MotorCalibration' is not trivially copyable");
+
+static_assert(std::is_trivially_default_constructible_v<MotorCalibration>,
+              "'MotorCalibration' is not trivially default constructable");
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -106,6 +106,21 @@ public:
     //! 真のSP値をメインに表示するかどうかを返す
     MainSPView mainSPView() const noexcept;
 
+    //! オートモードの同期調整時間（音声の遅れ） [ms]を返す
+    std::uint16_t syncAdj() const noexcept;
+
+    //! オートモードの同期調整時間 [ms]を設定する（2ms単位に丸める）
+    void setSyncAdj(std::uint16_t ms) noexcept;
+
+    /*!
+        @brief  書き込みで同期調整時間を上書きするかどうかを返す
+
+        同期調整時間は本体で較正するので、このビットを立てずに（予約領域を0で）
+        書き込むクライアントからは、同期調整時間を受け取らない。
+        setSyncAdj() で設定した値と、本体から読み出した値はビットが立っている。
+    */
+    bool hasSyncAdj() const noexcept;
+
     //! 値を適正化する
     void regulate() noexcept;
 
@@ -142,8 +157,14 @@ private:
         */
         std::uint8_t mainSP : 2;
 
+        //! オートモードの同期調整時間 (syncAdj * 2) [ms]
+        std::uint16_t syncAdj : 8;
+
+        //! 書き込みで同期調整時間を上書きするかどうか
+        std::uint16_t syncAdjValid : 1;
+
         //! 予約領域
-        std::uint16_t reserved : 13;
+        std::uint16_t reserved : 4;
     } _flags;
     
     //! オートモードの猶予時間 (_latency * 10) [ms]
@@ -0,0 +1,49 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_RAW_RECORD_HH
+#define ATLAS_RAW_RECORD_HH
+
+// C++標準ライブラリ
+#include <cstdint>      // std::uint16_t
+#include <type_traits>  // std::is_trivially_copyable_v, std::is_trivially_default_constructible_v
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  生データファイル（RAW_FPATH）の1シュート分のレコード
+
+    ------------------------------------------------------------
+     オフセット  幅    内容
+    ------------------------------------------------------------
+        0       2    累計シュート数（BBP記録SPの統計）
+        2       2    BBP記録のオリジナルSP
+        4       2    プロファイル解析で評価されたSP
+        6      64    SPプロファイル（32点, uint16, リトルエンディアン）
+    ------------------------------------------------------------
+*/
+struct RawRecord
+{
+    //! プロファイルのデータ点数
+    static constexpr int PROFILE_LENGTH = 32;
+
+    std::uint16_t total;    //!< 累計シュート数
+    std::uint16_t origSP;   //!< BBP記録のオリジナルSP
+    std::uint16_t evalSP;   //!< プロファイル解析で評価されたSP
+    std::uint16_t profile[PROFILE_LENGTH];  //!< SPプロファイル
+};
+
+static_assert(sizeof(RawRecord) == 70,
+              "Size of 'RawRecord' is not 70 bytes");
+
+static_assert(std::is_trivially_copyable_v<RawRecord>,
+              "'RawRecord' is not trivially copyable");
+
+static_assert(std::is_trivially_default_constructible_v<RawRecord>,
+              "'RawRecord' is not trivially default constructable");
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
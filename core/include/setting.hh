@@ -84,6 +84,7 @@
 
 #define  AUDIO_RX      RX   // オーディオプレイヤー: シリアル通信RX
 #define  AUDIO_TX      TX   // オーディオプレイヤー: シリアル通信TX
+#define  AUDIO_BUSY    -1   // オーディオプレイヤー: BUSY（未接続なら-1、シリアルで状態を問い合わせる）
 
 //=============================================================================
 // モーター設定
@@ -103,6 +104,22 @@
 #define  MOTOR1_MAX_RPM  24900   // モーター1の最大回転数
 #define  MOTOR2_MAX_RPM  24900   // モーター2の最大回転数
 
+/*
+    モーターの加速カーブ
+
+    目標のSPまでの加速のさせ方を指定する。
+     - MOTOR_RAMP_LINEAR:  線形（一定の加速度）
+     - MOTOR_RAMP_EASE_IN: ゆっくり回り始めて、後半で加速する
+     - MOTOR_RAMP_S_CURVE: 回り始めと目標付近をゆっくり加速する
+    加速に掛ける時間は、デューティ比1段（256段階）あたり MOTOR_RAMP_STEP_MS ミリ秒。
+*/
+#define  MOTOR_RAMP_LINEAR   0
+#define  MOTOR_RAMP_EASE_IN  1
+#define  MOTOR_RAMP_S_CURVE  2
+//-----------------------------------------------------------------------------
+#define  MOTOR_RAMP_CURVE    MOTOR_RAMP_LINEAR
+#define  MOTOR_RAMP_STEP_MS  15
+
 //=============================================================================
 // 音声設定
 //=============================================================================
@@ -130,6 +147,23 @@
 #define  SCREEN_HEIGHT    64   // スクリーン高さ
 #define  SCREEN_ADDR    0x3C   // ディスプレイのI2Cアドレス
 
+/*
+    描画の最小間隔 [ms]
+
+    画面の描画要求は描画タスクがまとめて処理し、この間隔に1回まで画面を更新する。
+    間隔の間に来た要求は、最新のものだけが描画される。
+*/
+#define  VIEW_FRAME_INTERVAL_MS  40
+
+/*
+    起動画面（ロゴ）の最短の表示時間 [ms]
+
+    起動時は、最初のモードに必要な初期化（表示・ファイルの読み込み・モーターの設定）が
+    終わるとすぐにロゴを消す。音声プレイヤーは裏で開始し、その完了は待たない。
+    ロゴを見せる時間を確保したい場合に指定する（0なら待たない）。
+*/
+#define  SPLASH_MIN_MS  0
+
 //=============================================================================
 // 動作パラメータ設定
 //=============================================================================
@@ -162,6 +196,16 @@
 */
 #define  DEFAULT_LATENCY  1300
 
+/*
+    同期調整時間のデフォルト値 [ms]
+
+    オートモードでカウントダウン音声の再生指令から実際に音が出るまでの遅れ（同期調整時間）の
+    デフォルト値をミリ秒で指定する。表示とモーター停止はこの時間だけ遅らせて音声に合わせる。
+    同期調整時間の内部パラメータは、マニュアル/設定モード時に外部からBLE通信で
+    較正（実測）できる。
+*/
+#define  DEFAULT_SYNC_ADJ  0
+
 /*
     電動ランチャーのSP上限値（ソフトウェアリミット）
 
@@ -201,6 +245,15 @@
 */
 #define  DELAY_UPPER_LIMIT  500
 
+/*
+    同期調整時間の上限値（ソフトウェアリミット） [ms]
+
+    カウントダウン音声の再生指令から実際に音が出るまでの遅れとして
+    採用する値の上限をミリ秒で指定する。
+    この値は外部から変更できない。
+*/
+#define  SYNC_ADJ_UPPER_LIMIT  500
+
 /*
     カウントダウンコールの間隔 [ms]
 
@@ -221,20 +274,34 @@
 #define  MOTOR_PREPARATORY_TIME  2000
 
 /*
-    オートモード射出・音声・表示の同期調整時間 [ms]
+    同期調整時間の較正 [ms]
 
-    音声再生の開始が遅れるため、音声タスクとモーター駆動タスク・表示タスクの同期をとるために
-    時間調整が必要となる。
+    カウントダウン音声の再生指令から、DFPlayerが再生中になる（BUSYがLOWになる、
+    またはシリアルの状態応答が再生中になる）までの時間を SYNC_CALIB_TRIALS 回計測し、
+    その中央値を同期調整時間とする。SYNC_CALIB_TIMEOUT 以内に再生が始まらない回は捨てる。
     この値は外部から変更できない。
 */
-#define  SYNC_ADJ_TIME  0
+#define  SYNC_CALIB_TRIALS   5
+#define  SYNC_CALIB_TIMEOUT  2000
+
+/*
+    SP較正の対応付け時間 [ms]
+
+    オートモードで射出してから、この時間内にベイバトルパスで計測されたSPを
+    その射出の結果とみなして、モーターのSP較正表を学習する。
+    この値は外部から変更できない。
+*/
+#define  CALIB_SHOT_WINDOW  3000
 
 //=============================================================================
 // タクトスイッチ設定
 //=============================================================================
 
-// タクトスイッチのゲート設定
-#define  SW_POLL_INTERVAL_MS   10
+/*
+    スイッチの入力はGPIO割り込みで検出し、最後のエッジから SW_DEBOUNCE_MS の間
+    変化がなければ状態を確定する（スライドスイッチも同じ）。
+    押下の確定から SW_LONGPRESS_MS 押し続けると長押し（モード切り替え）になる。
+*/
 #define  SW_DEBOUNCE_MS        20   // チャタリング防止
 #define  SW_LONGPRESS_MS      800   // 長押し判定
 
@@ -253,6 +320,25 @@
 #define  HIST_BIN_WIDTH    200
 #define  HIST_NUM_BINS      80
 
+//=============================================================================
+// トレース
+//=============================================================================
+
+/*
+    トレース（イベントのバイナリ記録）
+
+    1にすると、trace() で記録したイベント（時刻と引数2つ）をRAMのリングバッファに
+    貯め、最も低い優先度のタスクが TRACE_DRAIN_MS ごとにシリアルへ送り出す。
+    マニュアル/設定モードでトレース用のキャラクタリスティックが購読されている間は、
+    BLEの通知で送る。記録はロックもI/Oもしないので、有効にしても射出のタイミングは
+    変わらない。送り出しが間に合わずにあふれた記録は捨て、その数を送る。
+    ホストでは tools/trace_decode で読む。
+*/
+#define  ATLAS_TRACE  0
+
+#define  TRACE_BUFFER_SIZE  256   // 記録できる数（2のべき乗）
+#define  TRACE_DRAIN_MS     100   // 送り出しの間隔 [ms]
+
 //=============================================================================
 // システム設定（変更しないこと！）
 //=============================================================================
@@ -266,6 +352,7 @@
 #define  PARAMS_FPATH  "/params.dat"
 #define  RESULT_FPATH  "/result.dat"
 #define  RAW_FPATH     "/raw.dat"
+#define  CALIB_FPATH   "/calib.dat"
 
 // ファイルサイズ上限
 #define  MAX_SIZE_SP_FILE   1073741824   // 1 MiB
@@ -280,13 +367,29 @@
 #define  ATLAS_SERVICE       "32150000-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_PARAMS    "32150001-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_SHOOT     "32150020-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_LAUNCH    "32150021-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_CALIB     "32150022-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_SYNC      "32150023-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_RESULT    "32150031-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_SWITCH    "32150050-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_DEVINFO   "32150060-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_HEAPINFO  "32150061-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_RENDER    "32150062-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_TRACE     "32150063-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_LATENCY   "32150064-9A86-43AC-B15F-200ED1B7A72A"
+#define  ATLAS_CHR_BOOT      "32150065-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_RAW_CTRL  "32150070-9A86-43AC-B15F-200ED1B7A72A"
 #define  ATLAS_CHR_RAW_DATA  "32150071-9A86-43AC-B15F-200ED1B7A72A"
 
 #define  ATLAS_MTU_SIZE  247
 
+// BLE: 生データの転送中（バルク転送）と転送後の接続パラメータ
+#define  ATLAS_BULK_INTERVAL_MIN  6     // 転送中の接続間隔の下限 [1.25ms]（7.5ms）
+#define  ATLAS_BULK_INTERVAL_MAX  12    // 転送中の接続間隔の上限 [1.25ms]（15ms）
+#define  ATLAS_IDLE_INTERVAL_MIN  24    // 転送後の接続間隔の下限 [1.25ms]（30ms）
+#define  ATLAS_IDLE_INTERVAL_MAX  48    // 転送後の接続間隔の上限 [1.25ms]（60ms）
+#define  ATLAS_CONN_TIMEOUT       400   // 監視タイムアウト [10ms]（4秒）
+#define  ATLAS_BULK_DATA_LENGTH   251   // 転送中のLLの最大ペイロード（Data Length Extension） [bytes]
+
 ///////////////////////////////////////////////////////////////////////////////
 #endif
\ No newline at end of file
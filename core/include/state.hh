@@ -6,7 +6,8 @@
 #define ATLAS_STATE_HH
 
 // C++標準ライブラリ
-#include <cstdint>      // std::uint8_t
+#include <atomic>       // std::atomic
+#include <cstdint>      // std::uint8_t, std::uint32_t
 
 // ATLAS
 #include "setting.hh"
@@ -14,115 +15,197 @@
 namespace atlas {
 //-----------------------------------------------------------------------------
 
-//! アプリの状態を管理
+//! アプリの状態のスナップショット（ある時点の全項目の組）
+class StateSnapshot
+{
+public:
+    //! ベイバトルパスが接続されているかどうかを返す（オートモード）
+    inline bool isBBPReady() const noexcept {
+        return (_bits & BIT_BBP) != 0;
+    }
+
+    //! ベイがランチャーにセットされているかどうかを返す（オートモード）
+    inline bool isBeyReady() const noexcept {
+        return (_bits & BIT_BEY) != 0;
+    }
+
+    //! 電動ランチャーが連動するかどうかを返す（オートモード）
+    inline bool isELREnabled() const noexcept {
+        return (_bits & BIT_ELR) != 0;
+    }
+
+    //! クライアント（PC/スマホ）が接続されているかどうかを返す（マニュアルモード）
+    inline bool isClientReady() const noexcept {
+        return (_bits & BIT_CLIENT) != 0;
+    }
+
+    inline std::uint8_t pageA() const noexcept {
+        return static_cast<std::uint8_t>(_bits >> SHIFT_PAGE_A);
+    }
+
+    inline std::uint8_t pageM() const noexcept {
+        return static_cast<std::uint8_t>(_bits >> SHIFT_PAGE_M);
+    }
+
+private:
+    friend class State;
+
+    // ビット配置
+    static constexpr std::uint32_t BIT_BBP = 1u << 0;       //!< BBPの接続
+    static constexpr std::uint32_t BIT_BEY = 1u << 1;       //!< ベイの装着
+    static constexpr std::uint32_t BIT_ELR = 1u << 2;       //!< 電動ランチャーの連動
+    static constexpr std::uint32_t BIT_CLIENT = 1u << 3;    //!< クライアントの接続
+    static constexpr std::uint32_t SHIFT_PAGE_A = 8;        //!< オートモードのページ
+    static constexpr std::uint32_t SHIFT_PAGE_M = 16;       //!< マニュアル/設定モードのページ
+
+    explicit constexpr StateSnapshot(std::uint32_t bits) noexcept
+        : _bits(bits) {}
+
+    std::uint32_t _bits;
+};
+
+/*!
+    @brief  アプリの状態を管理
+
+    BLEのコールバック・モードのタスク・スイッチのタスクから書き込まれ、
+    画面表示から読み出される。全項目を1ワードに詰めて std::atomic で保持するので、
+    読み出し側は snapshot() で一貫した組を得られ、書き込み側もロックで待たない
+    （書き込みは比較交換で行い、競合したときだけやり直す）。
+*/
 class State
 {
 public:
+    //! 全項目の一貫したスナップショットを返す
+    inline StateSnapshot snapshot() const noexcept {
+        return StateSnapshot(_bits.load(std::memory_order_acquire));
+    }
+
     //! ベイバトルパスが接続されているかどうかを返す（オートモード）
     inline bool isBBPReady() const noexcept {
-        return _isBBPReady == 1;
+        return this->snapshot().isBBPReady();
     }
 
     //! ベイがランチャーにセットされているかどうかを返す（オートモード）
     inline bool isBeyReady() const noexcept {
-        return _isBeyReady == 1;
+        return this->snapshot().isBeyReady();
     }
 
     //! 電動ランチャーが連動するかどうかを返す（オートモード）
     inline bool isELREnabled() const noexcept {
-        return _isELREnabled == 1;
+        return this->snapshot().isELREnabled();
     }
 
     //! クライアント（PC/スマホ）が接続されているかどうかを返す（マニュアルモード）
     inline bool isClientReady() const noexcept {
-        return _isClientReady == 1;
+        return this->snapshot().isClientReady();
     }
 
     inline std::uint8_t pageA() const noexcept {
-        return _pageA;
+        return this->snapshot().pageA();
     }
 
     inline std::uint8_t pageM() const noexcept {
-        return _pageM;
+        return this->snapshot().pageM();
     }
 
     //! オートモードで次のページに進む
     void nextPageA() noexcept {
-        auto p = _pageA + 1;
-        _pageA = (p == MAX_PAGE_A) ? 0 : p;
+        _update([](std::uint32_t bits) {
+            return _nextPage(bits, StateSnapshot::SHIFT_PAGE_A, MAX_PAGE_A);
+        });
     }
 
     //! マニュアルモードで次のページに進む
     void nextPageM() noexcept {
-        auto p = _pageM + 1;
-        _pageM = (p == MAX_PAGE_M) ? 0 : p;
+        _update([](std::uint32_t bits) {
+            return _nextPage(bits, StateSnapshot::SHIFT_PAGE_M, MAX_PAGE_M);
+        });
     }
 
-    //! ベイバトルパスが接続されているかどうかを設定する（オートモード）
+    /*!
+        @brief  ベイバトルパスが接続されているかどうかを設定する（オートモード）
+
+        切断したときはベイの装着も同時に解除する。
+    */
     inline void setBBP(bool isReady) noexcept {
-        _isBBPReady = isReady;
+        _update([isReady](std::uint32_t bits) {
+            return isReady
+                ? bits | StateSnapshot::BIT_BBP
+                : bits & ~(StateSnapshot::BIT_BBP | StateSnapshot::BIT_BEY);
+        });
     }
 
-    //! ベイがランチャーにセットされているかどうかを設定する（オートモード）
+    /*!
+        @brief  ベイがランチャーにセットされているかどうかを設定する（オートモード）
+
+        ベイの装着はBBPに接続している間だけ有効にできる。
+    */
     inline void setBey(bool isReady) noexcept {
-        _isBeyReady = isReady;
+        _update([isReady](std::uint32_t bits) {
+            return (isReady && (bits & StateSnapshot::BIT_BBP))
+                ? bits | StateSnapshot::BIT_BEY
+                : bits & ~StateSnapshot::BIT_BEY;
+        });
     }
-    
+
     //! 電動ランチャーが連動するかどうかを設定する（オートモード）
     inline void setELR(bool isEnabled) noexcept {
-        _isELREnabled = isEnabled;
+        _setFlag(StateSnapshot::BIT_ELR, isEnabled);
     }
 
     //! クライアント（PC/スマホ）が接続されているかどうかを設定する（マニュアルモード）
     inline void setClient(bool isReady) noexcept {
-        _isClientReady = isReady;
+        _setFlag(StateSnapshot::BIT_CLIENT, isReady);
     }
 
     //! クリア
     void clear() noexcept {
-        _isBBPReady = false;
-        _isBeyReady = false;
-        _isELREnabled = false;
-        _isClientReady = false;
-        _pageA = 0;
-        _pageM = 0;
+        _bits.store(0, std::memory_order_release);
     }
 
 private:
-    /*! 
-        @brief  BBPが接続されているか
-        - `0`: 未接続
-        - `1`: 接続
-    */
-    bool _isBBPReady = false;
+    //! 現在値から新しい値を求める関数 f で更新する（競合したらやり直す）
+    template <class F>
+    inline void _update(F f) noexcept {
+        std::uint32_t bits = _bits.load(std::memory_order_relaxed);
+        while (!_bits.compare_exchange_weak(
+            bits, f(bits),
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed
+        ));
+    }
 
-    /*! 
-        @brief  ベイが装着されているか
-        - `0`: 未装着
-        - `1`: 装着
-    */
-    bool _isBeyReady = false;
+    //! フラグを設定する
+    inline void _setFlag(std::uint32_t flag, bool on) noexcept {
+        _update([flag, on](std::uint32_t bits) {
+            return on ? bits | flag : bits & ~flag;
+        });
+    }
 
-    /*! 
-        @brief  電動ランチャーが有効かどうか
-        - `0`: 無効
-        - `1`: 有効
-    */
-    bool _isELREnabled = false;
+    //! ページ番号を進める（最後のページの次は0）
+    static constexpr std::uint32_t _nextPage(
+        std::uint32_t bits,
+        std::uint32_t shift,
+        std::uint32_t maxPage
+    ) noexcept {
+        std::uint32_t p = ((bits >> shift) & 0xFF) + 1;
+        if (p >= maxPage) {
+            p = 0;
+        }
+        return (bits & ~(0xFFu << shift)) | (p << shift);
+    }
 
-    /*! 
-        @brief  クライアントが接続されているか
-        - `0`: 未接続
-        - `1`: 接続
+private:
+    /*!
+        @brief  状態（StateSnapshot のビット配置）
+        - bit 0: BBPが接続されているか
+        - bit 1: ベイが装着されているか
+        - bit 2: 電動ランチャーが有効かどうか
+        - bit 3: クライアントが接続されているか
+        - bit 8-15: オートモードのページ
+        - bit 16-23: マニュアル/設定モードのページ
     */
-    bool _isClientReady = false;
-
-    //! オートモードのページ
-    std::uint8_t _pageA = 0;
-
-    //! マニュアル/設定モードのページ
-    std::uint8_t _pageM = 0;
-
+    std::atomic<std::uint32_t> _bits {0};
 };
 
 //-----------------------------------------------------------------------------
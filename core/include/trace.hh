@@ -0,0 +1,133 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TRACE_HH
+#define ATLAS_TRACE_HH
+
+// C++標準ライブラリ
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+// ATLAS
+#include "setting.hh"
+#include "trace_events.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! トレースのイベントID（trace_events.hh の並び順）
+enum class TraceEvent : std::uint8_t
+{
+#define ATLAS_TRACE_ENUM(name, format) name,
+    ATLAS_TRACE_EVENTS(ATLAS_TRACE_ENUM)
+#undef ATLAS_TRACE_ENUM
+    NUM_EVENTS
+};
+
+//! トレースの記録1件
+struct TraceRecord
+{
+    std::uint32_t time;     //!< 記録した時刻（起動からの時間の下位32ビット） [us]
+    std::uint16_t seq;      //!< 通し番号の下位16ビット（欠けた記録の検出用）
+    std::uint8_t event;     //!< イベントID（TraceEvent）
+    std::uint8_t reserved;  //!< 予約領域
+    std::uint32_t arg0;     //!< 引数1
+    std::uint32_t arg1;     //!< 引数2
+};
+
+static_assert(sizeof(TraceRecord) == 16,
+              "Size of 'TraceRecord' is not 16 bytes");
+
+static_assert(std::is_trivially_copyable_v<TraceRecord>,
+              "'TraceRecord' is not trivially copyable");
+
+/*!
+    @brief  トレースのフレームのヘッダ
+
+    シリアル・BLEへは、このヘッダに続けて count 件の TraceRecord を送る。
+    シリアルではデバッグメッセージ（テキスト）と混ざるので、デコーダは magic を探す。
+*/
+struct TraceFrameHeader
+{
+    static constexpr std::uint8_t MAGIC0 = 0xA7;
+    static constexpr std::uint8_t MAGIC1 = 'T';
+    static constexpr std::uint8_t VERSION = 1;
+
+    //! 1フレームの最大の記録数（BLEの1回の通知に収まる数）
+    static constexpr std::uint8_t MAX_RECORDS = 12;
+
+    std::uint8_t magic0;    //!< MAGIC0
+    std::uint8_t magic1;    //!< MAGIC1
+    std::uint8_t version;   //!< VERSION
+    std::uint8_t count;     //!< 続く記録の数
+    std::uint32_t dropped;  //!< バッファがあふれて捨てた記録の累計
+};
+
+static_assert(sizeof(TraceFrameHeader) == 8,
+              "Size of 'TraceFrameHeader' is not 8 bytes");
+
+static_assert(sizeof(TraceFrameHeader) + TraceFrameHeader::MAX_RECORDS * sizeof(TraceRecord)
+              <= ATLAS_MTU_SIZE - 3,
+              "trace frame does not fit in a notification");
+
+//-----------------------------------------------------------------------------
+#if ATLAS_TRACE
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  トレース（イベントのバイナリ記録）
+
+    push() はリングバッファの空きを compare-exchange で確保して書き込むだけで、
+    ロックもI/Oもしない（どのタスクからも呼べ、待たされることがない）。
+    送り出しは最も低い優先度のタスクが行う。
+*/
+class Trace
+{
+public:
+    /*!
+        @brief  送り出し先
+        @param[in]  data    フレーム（ヘッダと記録）
+        @param[in]  size    フレームのバイト数
+        @return     送れたかどうか（送れなければ記録を捨てた数に数える）
+    */
+    using Sink = bool (*)(const std::uint8_t* data, std::size_t size);
+
+    //! 送り出しタスクを開始する（2回目以降は何もしない）
+    static void begin();
+
+    //! 記録する
+    static void push(TraceEvent event, std::uint32_t arg0, std::uint32_t arg1) noexcept;
+
+    //! 送り出し先を変える（nullptr ならシリアル）。送り出し中なら終わるまで待つ
+    static void setSink(Sink sink) noexcept;
+};
+
+//-----------------------------------------------------------------------------
+#endif  // #if ATLAS_TRACE
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  イベントを記録する（ATLAS_TRACE が0なら何もしない）
+    @param[in]  event   イベントID
+    @param[in]  arg0    引数1
+    @param[in]  arg1    引数2
+*/
+inline void trace(
+    TraceEvent event,
+    std::uint32_t arg0 = 0,
+    std::uint32_t arg1 = 0
+) noexcept {
+#if ATLAS_TRACE
+    Trace::push(event, arg0, arg1);
+#else
+    (void)event;
+    (void)arg0;
+    (void)arg1;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif  // #ifndef ATLAS_TRACE_HH
@@ -0,0 +1,44 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TRACE_EVENTS_HH
+#define ATLAS_TRACE_EVENTS_HH
+
+/*
+    トレースのイベント一覧
+
+    X(名前, 表示形式) の並びの順番がイベントIDになる。
+    記録済みのトレースを読めなくなるので、途中に挿入・削除せず末尾に追加すること。
+    表示形式はホストのデコーダ（tools/trace_decode）が printf で2つの引数
+    （32ビット。%d なら符号付き）を表示するのに使う。
+*/
+#define ATLAS_TRACE_EVENTS(X) \
+    X(TRACE_STARTED,     "trace started (%u records)") \
+    X(BBP_CONNECTED,     "BBP connected") \
+    X(BBP_DISCONNECTED,  "BBP disconnected (reason %u)") \
+    X(BBP_NOTIFY,        "BBP notify: state 0x%02x, %u bytes") \
+    X(BEY_ATTACHED,      "bey attached / detached") \
+    X(BEY_LAUNCHED,      "bey launched: SP %u, eval SP %u") \
+    X(CRC_ERROR,         "CRC error") \
+    X(ELR_ENABLED,       "ELR enabled") \
+    X(ELR_DISABLED,      "ELR disabled") \
+    X(LAUNCH_STARTED,    "launch started") \
+    X(LAUNCH_CANCELED,   "launch canceled") \
+    X(MANUAL_SWITCHED,   "switched to manual mode") \
+    X(COUNTDOWN,         "countdown %u") \
+    X(MOTOR_SPUN_UP,     "motor %u spun up") \
+    X(MOTOR_STOPPED,     "motor %u stopped") \
+    X(LAUNCH_RESULT,     "launch: latency %d us, error %d us") \
+    X(LAUNCH_SKEW,       "launch: skew %u us") \
+    X(RAW_NOT_SENT,      "raw data not sent (%u: 0=not subscribed, 1=no file)") \
+    X(RAW_SEND_STARTED,  "raw data: %u bytes, %u packets") \
+    X(RAW_SEND_ACKED,    "raw data: acked %u / %u packets") \
+    X(RAW_SEND_ABORTED,  "raw data: aborted at packet %u") \
+    X(RAW_SEND_DONE,     "raw data: %u packets in %u ms") \
+    X(CALIB_UPDATED,     "calibration updated: motor %u, duty %u") \
+    X(LAUNCH_ABORTED,    "launch aborted before countdown") \
+    X(RAW_SEND_RATE,     "raw data: %u bytes/s, interval %u x 1.25 ms") \
+    X(LAUNCH_TIMEOUT,    "launch: motors did not stop within %u ms")
+
+#endif  // #ifndef ATLAS_TRACE_EVENTS_HH
@@ -6,15 +6,22 @@
 #define ATLAS_VIEW_HH
 
 // C++標準ライブラリ
-#include <cstdint>  // std::uint16_t
+#include <cstdint>      // std::uint16_t
+#include <type_traits>  // std::is_trivially_copyable_v
 
 // 設定
 #include "setting.hh"
 
+// ATLAS
+#include "histogram.hh"
+
 // shark lib
 #include "mutex.hh"
 #include "monochrome_display.hh"
-#if DISPLAY_DRIVER == ADAFRUIT_SSD1306
+#if !defined(ARDUINO)
+#include "frame_buffer.hh"  // ホスト（PC）のツール用
+typedef shark::MonochromeDisplay<shark::FrameBuffer> DisplayDriver;
+#elif DISPLAY_DRIVER == ADAFRUIT_SSD1306
 #include <Adafruit_SSD1306.h>
 typedef shark::MonochromeDisplay<Adafruit_SSD1306> DisplayDriver;
 #elif DISPLAY_DRIVER == ADAFRUIT_SH1106G
@@ -25,12 +32,81 @@ typedef shark::MonochromeDisplay<Adafruit_SH1106G> DisplayDriver;
 namespace atlas {
 //-----------------------------------------------------------------------------
 
+/*!
+    @brief  描画の計測結果（BLEで送信する）
+
+    バッファへの描画（render）と画面への転送（flush）の時間を分けて計測する。
+    描画要求（requests）がフレーム数（frames）より多い分は、
+    フレーム間隔の間にまとめられた要求。時間の単位はすべてマイクロ秒。
+    転送バイト数は、変化した部分だけを送った実際のI2Cの送信量。
+*/
+struct RenderStats
+{
+    std::uint32_t frames;       //!< 描画したフレーム数
+    std::uint32_t requests;     //!< 描画要求の数
+    std::uint32_t lastRender;   //!< 直近のバッファへの描画時間
+    std::uint32_t maxRender;    //!< バッファへの描画時間の最大値
+    std::uint32_t meanRender;   //!< バッファへの描画時間の平均値
+    std::uint32_t lastFlush;    //!< 直近の画面への転送時間
+    std::uint32_t maxFlush;     //!< 画面への転送時間の最大値
+    std::uint32_t meanFlush;    //!< 画面への転送時間の平均値
+    std::uint32_t lastBytes;    //!< 直近の転送バイト数
+    std::uint32_t meanBytes;    //!< 転送バイト数の平均値
+};
+
+static_assert(sizeof(RenderStats) == 40,
+              "Size of 'RenderStats' is not 40 bytes");
+
+static_assert(std::is_trivially_copyable_v<RenderStats>,
+              "'RenderStats' is not trivially copyable");
+
+/*!
+    @brief  画面表示
+
+    表示メソッドは描画要求を置いて描画タスクに通知するだけで、I2Cの転送を待たない。
+    描画タスクは VIEW_FRAME_INTERVAL_MS に1回まで描画し、その間に来た要求は
+    最新のものだけを描画する（まとめる）。
+*/
 class View
     : public DisplayDriver
 {
 public:
+    //! 画面の種類
+    enum class Screen
+        : std::uint8_t
+    {
+        NONE,
+        SPLASH,
+        MANUAL_STANDBY,
+        AUTO_STANDBY,
+        AUTO_ERROR,
+        AUTO_ABORTED,
+        AUTO_PROMOTION,
+        AUTO_SP,
+        AUTO_COUNTDOWN,
+    };
+
+    //! 描画要求
+    struct Request
+    {
+        Screen screen;          //!< 画面
+        std::int8_t countdown;  //!< カウントダウンの番号
+        std::uint16_t acc1;     //!< 前半の加速度
+        std::uint16_t acc2;     //!< 後半の加速度
+    };
+
     View();
 
+    /*!
+        @brief  ディスプレイを開始し、描画タスクを起動する（起動時に1度だけ呼ぶ）
+        @param[in]  screenAddr  ディスプレイのI2Cアドレス
+        @return     開始できたかどうか
+    */
+    bool begin(std::uint8_t screenAddr);
+
+    //! 描画の計測結果を返す
+    RenderStats renderStats() const;
+
     //! スプラッシュスクリーンを表示する
     void splashScreen();
 
@@ -62,6 +138,13 @@ public:
     //! オートモードで、カウントダウンを表示する
     void autoModeCountdown(int i);
 
+    /*!
+        @brief  描画要求の画面をバッファに描画する（画面への転送はしない）
+
+        描画タスクから呼ばれる。ホストのツールからは直接呼んで画面を検証する。
+    */
+    void render(const Request& request);
+
     //! ユーザーイメージ
     inline void userImage(
         std::int16_t x,
@@ -74,6 +157,22 @@ public:
     }
 
 private:
+    //! 描画要求を置いて描画タスクに通知する
+    void _post(const Request& request);
+
+    //! 描画タスク
+    static void _taskRender(void* pvParams);
+
+    // 各画面の描画（バッファのクリアは render、転送は _taskRender が行う）
+    void _drawSplashScreen();
+    void _drawManualModeStandby();
+    void _drawAutoModeStandby();
+    void _drawAutoModeError();
+    void _drawAutoModeAborted();
+    void _drawAutoModePromotion();
+    void _drawAutoModeSP(std::uint16_t acc1, std::uint16_t acc2);
+    void _drawAutoModeCountdown(int i);
+
     //! マニュアル/設定モードのヘッダ情報を表示する
     void _manualModeHeader();
 
@@ -86,11 +185,43 @@ private:
     void _showPageInfo(const char* page_header);
     void _showStats();
     void _showHist();
+    void _buildHistCache(const Histogram& hist);
     void _showParams();
     
 private:
-    //! 排他制御」
-    shark::Mutex _mutex;
+    /*!
+        @brief  ヒストグラムの描画キャッシュ
+
+        描画したヒストグラムのインスタンスと内容が変わるまで、
+        軸（目盛りとラベル）の描画結果と棒の位置・高さを使い回す。
+        描画タスクだけが使うのでロックしない。
+    */
+    struct HistCache
+    {
+        static constexpr std::uint8_t AXIS_PAGE = 54 / 8;   //!< 軸の先頭ページ（y=54〜63）
+        static constexpr std::uint8_t AXIS_PAGES = 2;       //!< 軸のページ数
+
+        const Histogram* source = nullptr;  //!< 描画したヒストグラム
+        Histogram snapshot {};              //!< 描画したときのヒストグラムの内容
+        std::int16_t barWidth = 0;          //!< 棒の幅
+        std::uint8_t numBars = 0;           //!< 棒の数
+        std::int16_t barX[HIST_NUM_BINS];   //!< 棒の左端
+        std::uint8_t barH[HIST_NUM_BINS];   //!< 棒の高さ
+        std::uint8_t axis[AXIS_PAGES * SCREEN_WIDTH];   //!< 軸のページ
+    };
+    HistCache _histCache;
+
+    //! 最新の描画要求
+    Request _request {};
+
+    //! 計測結果
+    RenderStats _stats {};
+    std::uint64_t _sumRender = 0;   //!< 描画時間の合計
+    std::uint64_t _sumFlush = 0;    //!< 転送時間の合計
+    std::uint64_t _sumBytes = 0;    //!< 転送バイト数の合計
+
+    //! 排他制御（描画要求と計測結果。I2Cの転送中は保持しない）
+    mutable shark::Mutex _mutex;
 };
 
 //-----------------------------------------------------------------------------
@@ -4,6 +4,12 @@
 */
 #include "audio_player.hh"
 
+// Arduino
+#include <Arduino.h>
+
+// shark lib
+#include "lock.hh"
+
 namespace shark {
 //-----------------------------------------------------------------------------
 
@@ -12,27 +18,42 @@ bool AudioPlayer::begin(
     HardwareSerial& serial,
     unsigned long baud,
     std::int8_t rxPin,
-    std::int8_t txPin
+    std::int8_t txPin,
+    std::int8_t pinBusy,
+    std::uint8_t volume
 ) {
+    // BUSYは再生中にLOWになる
+    _pinBusy = pinBusy;
+    if (_pinBusy >= 0) {
+        pinMode(_pinBusy, INPUT_PULLUP);
+    }
+
     // シリアル通信の初期化
     serial.begin(baud, SERIAL_8N1, rxPin, txPin);
     if (!serial) {
         return false;
     }
     // DFプレイヤーのインスタンス実体化
-    _dfplayer.reset(new DFRobotDFPlayerMini);
-    if (!_dfplayer->begin(serial)) {
+    std::unique_ptr<DFRobotDFPlayerMini> dfplayer(new DFRobotDFPlayerMini);
+    if (!dfplayer->begin(serial)) {
         // DFプレイヤーの初期化に失敗したので、インスタンスの破棄
-        _dfplayer.reset();
         return false;
     }
+    // 他のタスクから使えるようにする前に音量を設定する
+    if (volume <= 30) {
+        dfplayer->volume(volume);
+    }
+    // 他のタスクから使えるようにする
+    _dfplayer = std::move(dfplayer);
+    _ready.store(true);
     return true;
 }
 
 // 音量の設定
 void AudioPlayer::setVolume(std::uint8_t volume)
 {
-    if (_dfplayer && volume <= 30) {
+    if (_ready.load() && volume <= 30) {
+        Lock lock(_mutex);
         _dfplayer->volume(volume);
     }
 }
@@ -40,17 +61,86 @@ void AudioPlayer::setVolume(std::uint8_t volume)
 // オーディオプレイヤーが有効かどうかを返す
 bool AudioPlayer::isEnabled() const noexcept
 {
-    return static_cast<bool>(_dfplayer);
+    return _ready.load();
 }
 
 // 音声を再生する
 void AudioPlayer::play(std::uint8_t fileNumber)
 {
-    if (_dfplayer) {
+    if (_ready.load()) {
+        Lock lock(_mutex);
         _dfplayer->playFolder(fileNumber, 1);
     }
 }
 
+// 再生を停止する
+void AudioPlayer::stop()
+{
+    if (_ready.load()) {
+        Lock lock(_mutex);
+        _dfplayer->stop();
+    }
+}
+
+// 再生中かどうかを返す
+bool AudioPlayer::isPlaying()
+{
+    if (!_ready.load()) {
+        return false;
+    }
+    Lock lock(_mutex);
+    return this->_isPlaying();
+}
+
+// 再生中かどうかを返す（_mutex を獲得した状態で呼ぶ）
+bool AudioPlayer::_isPlaying()
+{
+    if (_pinBusy >= 0) {
+        return digitalRead(_pinBusy) == LOW;
+    }
+
+    // 状態応答の下位バイトが 1 なら再生中（上位バイトは再生デバイス）
+    int state = _dfplayer->readState();
+    return state >= 0 && (state & 0xFF) == 1;
+}
+
+// 再生指令から実際に再生が始まるまでの時間を計測する
+std::int32_t AudioPlayer::measureLatency(
+    std::uint8_t fileNumber,
+    std::uint32_t timeoutMs
+) {
+    if (!_ready.load()) {
+        return -1;
+    }
+    // 問い合わせの途中に他のタスクの指令が混ざらないように、計測の間は獲得したままにする
+    Lock lock(_mutex);
+
+    // 前の再生が残っていると計測できないので止めておく
+    if (this->_isPlaying()) {
+        _dfplayer->stop();
+        delay(100);
+    }
+
+    const std::uint32_t start = millis();
+    _dfplayer->playFolder(fileNumber, 1);
+
+    std::int32_t latency = -1;
+    while (millis() - start < timeoutMs) {
+        // シリアルの問い合わせは往復に時間が掛かるので、問い合わせの前後の中間をとる
+        const std::uint32_t before = millis();
+        if (this->_isPlaying()) {
+            const std::uint32_t after = millis();
+            latency = static_cast<std::int32_t>(before + (after - before) / 2 - start);
+            break;
+        }
+        if (_pinBusy >= 0) {
+            delay(1);
+        }
+    }
+    _dfplayer->stop();
+    return latency;
+}
+
 //-----------------------------------------------------------------------------
 } // namespace shark
 
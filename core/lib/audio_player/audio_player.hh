@@ -6,6 +6,7 @@
 #define SHARK_MINISTER_AUDIO_PLAYER_HH
 
 // C++標準ライブラリ
+#include <atomic>       // std::atomic_bool
 #include <cstdint>      // std::uint8_t
 #include <memory>       // std::unique_ptr
 
@@ -13,6 +14,9 @@
 #include <HardwareSerial.h>
 #include <DFRobotDFPlayerMini.h>
 
+// shark lib
+#include "mutex.hh"
+
 namespace shark {
 //-----------------------------------------------------------------------------
 
@@ -21,6 +25,18 @@ class AudioPlayer
 private:
     std::unique_ptr<DFRobotDFPlayerMini> _dfplayer;
 
+    //! BUSYのピン番号（未接続なら-1）
+    std::int8_t _pinBusy = -1;
+
+    //! 開始が済んだか（begin() を裏のタスクで行う間、他のタスクは再生しない）
+    std::atomic_bool _ready {false};
+
+    //! 排他制御（DFプレイヤーへの指令と応答の読み取りが、タスク間で混ざらないようにする）
+    Mutex _mutex;
+
+    //! 再生中かどうかを返す（_mutex を獲得した状態で呼ぶ）
+    bool _isPlaying();
+
 public:
     /*!
         @brief  オーディオプレイヤーの開始
@@ -29,13 +45,20 @@ public:
         @param[in]  baud    ボーレート
         @param[in]  pinRX   RXのピン番号
         @param[in]  pinTX   TXのピン番号
+        @param[in]  pinBusy BUSYのピン番号（未接続なら-1）
+        @param[in]  volume  音量。1-30（開始が済む前に設定する）
 
         @return  開始の成否
+
+        DFプレイヤーの応答を待つので数秒かかることがある。他のタスクが play() などを
+        呼んでいる間に、裏のタスクで呼んでもよい（開始が済むまで、それらは何もしない）。
     */
     bool begin(HardwareSerial& serial,
                unsigned long baud,
                std::int8_t pinRX,
-               std::int8_t pinTX);
+               std::int8_t pinTX,
+               std::int8_t pinBusy,
+               std::uint8_t volume);
 
     /*!
         @brief  音量の設定
@@ -48,6 +71,27 @@ public:
 
     //! 音声を再生する
     void play(std::uint8_t fileNumber);
+
+    //! 再生を停止する
+    void stop();
+
+    /*!
+        @brief  再生中かどうかを返す
+
+        BUSYが接続されていればその状態（LOWで再生中）を読み、
+        なければシリアルで状態を問い合わせる（応答待ちでブロックする）。
+    */
+    bool isPlaying();
+
+    /*!
+        @brief  再生指令から実際に再生が始まるまでの時間を計測する
+        @param[in]  fileNumber  再生する音声ファイル番号
+        @param[in]  timeoutMs   再生開始を待つ最大時間 [ms]
+        @return     再生開始までの時間 [ms]。計測できなければ-1
+
+        計測後は再生を停止する。計測の間は他のタスクの play() などを待たせる。
+    */
+    std::int32_t measureLatency(std::uint8_t fileNumber, std::uint32_t timeoutMs);
 };
 
 //-----------------------------------------------------------------------------
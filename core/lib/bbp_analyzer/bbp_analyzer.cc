@@ -60,6 +60,12 @@ BBPState BBPAnalyzer::analyze(const BBPData& data)
 
     // データの終了 ==> 解析の開始
     if (hdr == HEADER_DATA_END) {
+        // データ列の欠落
+        if (!this->_isComplete()) {
+            this->_dataMap.clear();
+            return shark::BBPState::ERROR;
+        }
+
         /*
             ■ 内容
             チェックサム値の取得
@@ -121,11 +127,17 @@ BBPState BBPAnalyzer::analyze(const BBPData& data)
 
         // シュート数（シュートパワーリスト）の取得
         auto n = _dataMap[HEADER_LIST_LAST].at(11);
+
+        // リストの範囲外（1-50件以外）はデータ異常として扱う
+        if (n == 0 || n > MAX_SP_LIST) {
+            this->_dataMap.clear();
+            return shark::BBPState::ERROR;
+        }
         
         // 最新SPの格納位置の計算。上の表を参照。
         // ((n - 1) >> 3) + HEADER_LIST_FIRST: 最新SPがどのデータ列にあるか
-        // (n & 7) * 2 - 1: 最新SPがデータ列のどの位置にあるか
-        _sp = _dataMap[((n-1)>>3)+HEADER_LIST_FIRST].uint16((n&7)*2-1);
+        // ((n - 1) & 7) * 2 + 1: 最新SPがデータ列のどの位置にあるか
+        _sp = _dataMap[((n-1)>>3)+HEADER_LIST_FIRST].uint16(((n-1)&7)*2+1);
 
         /*
             ■ 内容
@@ -171,5 +183,16 @@ void BBPAnalyzer::clear()
     this->_dataMap.clear();
 }
 
+bool BBPAnalyzer::_isComplete() const
+{
+    for (auto h = HEADER_LIST_FIRST; h <= HEADER_CHECKSUM; ++h) {
+        if (_dataMap.find(h) == _dataMap.end()) return false;
+    }
+    for (auto h = HEADER_PROF_FIRST; h <= HEADER_PROF_LAST; ++h) {
+        if (_dataMap.find(h) == _dataMap.end()) return false;
+    }
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 } // namespace shark
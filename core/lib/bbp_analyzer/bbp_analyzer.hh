@@ -41,6 +41,9 @@ public:
     void clear();
 
 private:
+    //! 解析に必要なデータ列（B0-B7, 70-73）が揃っているかどうかを返す
+    bool _isComplete() const;
+
     /*
         ベイバトルパス(BBP)からのnotifyデータのヘッダー一覧。
 
@@ -66,6 +69,9 @@ private:
     static constexpr std::uint8_t HEADER_PROF_LAST     = 0x73;
     static constexpr std::uint8_t HEADER_DATA_END      = 0x73;
 
+    //! シュートパワーリストの最大件数
+    static constexpr std::uint8_t MAX_SP_LIST = 50;
+
     //! ベイバトルパスからのデータ一式を格納するコンテナ
     std::map<std::uint8_t, BBPData> _dataMap;
 
@@ -0,0 +1,97 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "button.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+bool Button::begin(
+    std::uint8_t pin,
+    std::uint32_t debounceMs,
+    std::uint32_t longPressMs
+) {
+    // 2回目以降は何もしない
+    if (_queue.isCreated()) {
+        return true;
+    }
+
+    _pin = pin;
+    _debouncer.configure(debounceMs, longPressMs);
+    _debouncer.reset();
+
+    // イベントキュー
+    if (!_queue.begin()) {
+        return false;
+    }
+
+    // チャタリング除去タイマー
+    if (!_debounceTimer.begin("btnDebounce", _onDebounce, this)) {
+        return false;
+    }
+
+    // 長押しタイマー
+    if (!_longPressTimer.begin("btnLongPress", _onLongPress, this)) {
+        return false;
+    }
+
+    // 内蔵プルアップ抵抗を使う
+    gpio::mode(_pin, gpio::PinMode::IN_PULLUP);
+
+    // 起動時の状態を反映する（押されたまま起動したとき）
+    _onDebounce(this);
+
+    // 両エッジで割り込む（以降の状態機械の更新はタイマーのタスクだけが行う）
+    gpio::attachChange(_pin, _onEdge, this);
+    return true;
+}
+
+bool Button::wait(ButtonEvent& event, std::uint32_t timeout)
+{
+    return _queue.receive(event, timeout);
+}
+
+void IRAM_ATTR Button::_onEdge(void* arg)
+{
+    auto& self = *static_cast<Button*>(arg);
+
+    // 最後のエッジから一定時間変化がなければ状態を確定する
+    self._debounceTimer.stop();
+    self._debounceTimer.startOnce(
+        static_cast<std::uint64_t>(self._debouncer.debounceUs())
+    );
+}
+
+void Button::_onDebounce(void* arg)
+{
+    auto& self = *static_cast<Button*>(arg);
+    const bool pressed = !gpio::read(self._pin);
+    self._dispatch(self._debouncer.settle(pressed, DeadlineTimer::now()));
+}
+
+void Button::_onLongPress(void* arg)
+{
+    auto& self = *static_cast<Button*>(arg);
+    self._dispatch(self._debouncer.expire(DeadlineTimer::now()));
+}
+
+void Button::_dispatch(ButtonEvent event)
+{
+    // 2つのタイマーのコールバックはどちらもESPタイマーのタスクから呼ばれるので、
+    // 状態機械へのアクセスは直列化されている
+    const std::int64_t deadline = _debouncer.longPressDeadline();
+    if (deadline >= 0) {
+        _longPressTimer.arm(deadline);
+    }
+    else {
+        _longPressTimer.cancel();
+    }
+
+    if (event != ButtonEvent::NONE) {
+        _queue.send(event);
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark
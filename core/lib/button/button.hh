@@ -0,0 +1,81 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_BUTTON_HH
+#define SHARK_MINISTER_BUTTON_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t, std::uint32_t
+
+// shark lib
+#include "button_debouncer.hh"
+#include "deadline_timer.hh"
+#include "gpio.hh"
+#include "os.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  割り込み駆動のボタン入力
+
+    GPIOの割り込みでエッジを検出し、ESPタイマーでチャタリング除去と長押し判定を行って、
+    確定したイベントをキューに積む。ポーリングしないので、ボタンを操作していない間は
+    CPUを使わない。入力は内蔵プルアップで、押下（スイッチが閉じた状態）をLOWとする。
+    判定そのものは ButtonDebouncer（ハードウェア非依存）が行う。
+*/
+class Button
+{
+public:
+    /*!
+        @brief  ボタン入力の開始（起動時に1度だけ呼ぶ）
+        @param[in]  pin          入力ピン番号
+        @param[in]  debounceMs   チャタリング除去の時間 [ms]
+        @param[in]  longPressMs  長押し判定の時間 [ms]
+        @return     開始できたかどうか
+    */
+    bool begin(std::uint8_t pin, std::uint32_t debounceMs, std::uint32_t longPressMs);
+
+    /*!
+        @brief  イベントを待つ（待っている間はブロックする）
+        @param[out]  event    確定したイベント
+        @param[in]   timeout  最大待ち時間 [ms]
+        @return      イベントを受け取れたかどうか
+    */
+    bool wait(ButtonEvent& event, std::uint32_t timeout = os::FOREVER);
+
+    //! 押下が確定しているかどうか
+    inline bool isPressed() const noexcept {
+        return _debouncer.isPressed();
+    }
+
+private:
+    //! イベントキューの長さ
+    static constexpr std::uint32_t QUEUE_LENGTH = 8;
+
+    //! GPIOの割り込み（エッジのたびにチャタリング除去タイマーをセットし直す）
+    static void IRAM_ATTR _onEdge(void* arg);
+
+    //! チャタリング除去タイマーのコールバック
+    static void _onDebounce(void* arg);
+
+    //! 長押しタイマーのコールバック
+    static void _onLongPress(void* arg);
+
+    //! イベントをキューに積み、長押しタイマーをセットし直す
+    void _dispatch(ButtonEvent event);
+
+private:
+    std::uint8_t _pin = 0;                          //!< 入力ピン番号
+    ButtonDebouncer _debouncer;                     //!< 判定の状態機械
+    os::Timer _debounceTimer;                       //!< チャタリング除去タイマー
+    DeadlineTimer _longPressTimer;                  //!< 長押しタイマー
+
+    //! イベントキュー（静的領域に確保する）
+    os::StaticQueue<ButtonEvent, QUEUE_LENGTH> _queue;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace shark
+#endif
@@ -0,0 +1,64 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "button_debouncer.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+void ButtonDebouncer::configure(
+    std::uint32_t debounceMs,
+    std::uint32_t longPressMs
+) noexcept
+{
+    _debounceUs = static_cast<std::int64_t>(debounceMs) * 1000;
+    _longPressUs = static_cast<std::int64_t>(longPressMs) * 1000;
+}
+
+ButtonEvent ButtonDebouncer::settle(bool pressed, std::int64_t now) noexcept
+{
+    // チャタリングだけで状態は変わっていない
+    if (pressed == _pressed) {
+        return ButtonEvent::NONE;
+    }
+    _pressed = pressed;
+
+    // 押下
+    if (pressed) {
+        _pressStart = now;
+        _longFired = false;
+        return ButtonEvent::PRESS;
+    }
+
+    // 解放
+    return _longFired ? ButtonEvent::RELEASE : ButtonEvent::CLICK;
+}
+
+ButtonEvent ButtonDebouncer::expire(std::int64_t now) noexcept
+{
+    // 解放済み・判定済み・早すぎる発火は無視する
+    if (!_pressed || _longFired || now - _pressStart < _longPressUs) {
+        return ButtonEvent::NONE;
+    }
+    _longFired = true;
+    return ButtonEvent::LONG_PRESS;
+}
+
+std::int64_t ButtonDebouncer::longPressDeadline() const noexcept
+{
+    if (!_pressed || _longFired) {
+        return -1;
+    }
+    return _pressStart + _longPressUs;
+}
+
+void ButtonDebouncer::reset() noexcept
+{
+    _pressStart = 0;
+    _pressed = false;
+    _longFired = false;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark
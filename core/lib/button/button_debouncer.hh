@@ -0,0 +1,88 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_BUTTON_DEBOUNCER_HH
+#define SHARK_MINISTER_BUTTON_DEBOUNCER_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t, std::uint32_t, std::int64_t
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+//! ボタンのイベント
+enum class ButtonEvent
+    : std::uint8_t
+{
+    NONE,           //!< イベントなし
+    PRESS,          //!< 押下が確定した
+    CLICK,          //!< 長押しになる前に離された
+    LONG_PRESS,     //!< 長押しが確定した（押したまま）
+    RELEASE,        //!< 長押しの後に離された
+};
+
+/*!
+    @brief  ボタンのチャタリング除去と長押し判定（状態機械）
+
+    GPIOやタイマーには依存せず、時刻 [us] と入力を受け取ってイベントを返すだけなので、
+    ホスト上で合成した波形を流して検証できる。
+    呼び出し側は次の2つのタイマーを用意する。
+
+    - チャタリング除去タイマー：エッジのたびに debounceUs() 後に再セットし、
+      発火したらその時点のボタン状態で settle() を呼ぶ
+    - 長押しタイマー：settle() / expire() の後に longPressDeadline() が
+      0以上ならその時刻にセットし、発火したら expire() を呼ぶ
+*/
+class ButtonDebouncer
+{
+public:
+    /*!
+        @brief  判定時間の設定
+        @param[in]  debounceMs   最後のエッジから状態を確定するまでの時間 [ms]
+        @param[in]  longPressMs  押下の確定から長押しとするまでの時間 [ms]
+    */
+    void configure(std::uint32_t debounceMs, std::uint32_t longPressMs) noexcept;
+
+    /*!
+        @brief  エッジが収まった（チャタリング除去タイマーが発火した）
+        @param[in]  pressed  その時点で押されているかどうか
+        @param[in]  now      現在時刻 [us]
+        @return     確定したイベント
+    */
+    ButtonEvent settle(bool pressed, std::int64_t now) noexcept;
+
+    /*!
+        @brief  長押しタイマーが発火した
+        @param[in]  now  現在時刻 [us]
+        @return     確定したイベント
+    */
+    ButtonEvent expire(std::int64_t now) noexcept;
+
+    //! 長押しタイマーにセットすべき時刻 [us]（不要なら-1）
+    std::int64_t longPressDeadline() const noexcept;
+
+    //! チャタリング除去の時間 [us]
+    inline std::int64_t debounceUs() const noexcept {
+        return _debounceUs;
+    }
+
+    //! 押下が確定しているかどうか
+    inline bool isPressed() const noexcept {
+        return _pressed;
+    }
+
+    //! 状態を初期化する（押されていない状態）
+    void reset() noexcept;
+
+private:
+    std::int64_t _debounceUs = 20000;       //!< チャタリング除去の時間 [us]
+    std::int64_t _longPressUs = 800000;     //!< 長押し判定の時間 [us]
+    std::int64_t _pressStart = 0;           //!< 押下が確定した時刻 [us]
+    bool _pressed = false;                  //!< 押下が確定しているか
+    bool _longFired = false;                //!< 長押しが確定したか
+};
+
+//-----------------------------------------------------------------------------
+} // namespace shark
+#endif
@@ -0,0 +1,38 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "deadline_timer.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+bool DeadlineTimer::begin(const char* name, Callback callback, void* arg)
+{
+    return _timer.begin(name, callback, arg);
+}
+
+bool DeadlineTimer::arm(std::int64_t deadline)
+{
+    if (!_timer.isCreated()) {
+        return false;
+    }
+
+    // セット済みなら解除してからセットし直す
+    _timer.stop();
+
+    _deadline = deadline;
+    std::int64_t timeout = deadline - now();
+    if (timeout < 0) {
+        timeout = 0;
+    }
+    return _timer.startOnce(static_cast<std::uint64_t>(timeout));
+}
+
+void DeadlineTimer::cancel()
+{
+    _timer.stop();
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark
@@ -0,0 +1,69 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_DEADLINE_TIMER_HH
+#define SHARK_MINISTER_DEADLINE_TIMER_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::int64_t
+
+// shark lib
+#include "os.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  絶対時刻を指定して1度だけ処理を実行するタイマー
+
+    ESPタイマー（ハードウェアタイマー、os::Timer）のワンショットで実装しており、
+    FreeRTOSのティック（1ms）に依存せずマイクロ秒単位で発火する。
+    コールバックはESPタイマーのタスクから呼ばれるので、
+    ブロックする処理は書かないこと。
+*/
+class DeadlineTimer
+{
+public:
+    //! コールバック関数
+    using Callback = void (*)(void* arg);
+
+    /*!
+        @brief  タイマーを作成する
+        @param[in]  name      タイマー名
+        @param[in]  callback  発火時に呼ばれる関数
+        @param[in]  arg       コールバックの引数
+        @return     作成できたかどうか
+    */
+    bool begin(const char* name, Callback callback, void* arg);
+
+    /*!
+        @brief  絶対時刻を指定してタイマーをセットする
+        @param[in]  deadline  発火時刻（now() の時間軸） [us]
+        @return     セットできたかどうか
+
+        既に過ぎた時刻を指定したときは直ちに発火する。
+    */
+    bool arm(std::int64_t deadline);
+
+    //! タイマーを解除する
+    void cancel();
+
+    //! 最後にセットした発火時刻 [us]
+    inline std::int64_t deadline() const noexcept {
+        return _deadline;
+    }
+
+    //! 現在時刻 [us]
+    inline static std::int64_t now() {
+        return os::now();
+    }
+
+private:
+    os::Timer _timer;                       //!< ESPタイマー
+    std::int64_t _deadline = 0;             //!< 発火時刻
+};
+
+//-----------------------------------------------------------------------------
+} // namespace shark
+#endif
@@ -0,0 +1,64 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "glyph_blitter.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+std::int16_t toDigits(std::uint32_t number, std::uint8_t* digits)
+{
+    // 下の桁から求めて、上の桁から並べ直す
+    std::uint8_t rev[10];
+    std::int16_t n = 0;
+    do {
+        rev[n++] = static_cast<std::uint8_t>(number % 10);
+        number /= 10;
+    } while (number > 0);
+
+    for (std::int16_t i = 0; i < n; i += 1) {
+        digits[i] = rev[n - 1 - i];
+    }
+    return n;
+}
+
+void blitColumns(
+    std::uint8_t* buffer,
+    std::int16_t width,
+    std::int16_t height,
+    std::int16_t x,
+    std::int16_t y,
+    const std::uint32_t* columns,
+    std::int16_t w,
+    std::uint16_t color
+) {
+    const std::int16_t pages = (height + 7) / 8;
+    const std::int16_t page0 = y >> 3;      // 負の座標も切り捨て
+    const std::int16_t shift = y & 7;
+
+    for (std::int16_t i = 0; i < w; i += 1) {
+        const std::int16_t cx = x + i;
+        if (cx < 0 || cx >= width) {
+            continue;
+        }
+
+        // 列をページの境界にあわせてずらし、1ページ（8ドット）ずつ書き込む
+        std::uint64_t bits = static_cast<std::uint64_t>(columns[i]) << shift;
+        for (std::int16_t p = page0; bits != 0; p += 1, bits >>= 8) {
+            if (p < 0 || p >= pages) {
+                continue;
+            }
+            const auto b = static_cast<std::uint8_t>(bits);
+            std::uint8_t& dst = buffer[cx + p * width];
+            switch (color) {
+            case 0:  dst &= ~b; break;
+            case 1:  dst |= b;  break;
+            default: dst ^= b;  break;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark
@@ -0,0 +1,89 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_GLYPH_BLITTER_HH
+#define SHARK_MINISTER_GLYPH_BLITTER_HH
+
+// C++標準ライブラリ
+#include <cstdint>
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  数字のグリフ（縦1列を1ワードにしたもの、LSBが上）
+
+    ディスプレイのバッファはページ単位（1バイト = 縦8ドット）なので、
+    縦1列をまとめておけば、1列あたり数バイトの論理演算で書き込める。
+
+    @tparam W   グリフの幅
+    @tparam H   グリフの高さ（32以下）
+*/
+template <std::int16_t W, std::int16_t H>
+struct DigitGlyphs
+{
+    static_assert(H <= 32, "glyph height must be 32 or less");
+
+    static constexpr std::int16_t WIDTH = W;
+    static constexpr std::int16_t HEIGHT = H;
+
+    //! 数字ごとの各列
+    std::uint32_t columns[10][W];
+
+    /*!
+        @brief  Adafruit GFX 形式のビットマップ（1行 (W+7)/8 バイト、MSBが左）から作る
+        @param[in]  images  '0'〜'9' のビットマップ
+    */
+    void build(const std::uint8_t* const* images) {
+        constexpr std::int16_t byteWidth = (W + 7) / 8;
+        for (std::int16_t d = 0; d < 10; d += 1) {
+            for (std::int16_t i = 0; i < W; i += 1) {
+                std::uint32_t col = 0;
+                for (std::int16_t j = 0; j < H; j += 1) {
+                    if (images[d][j * byteWidth + i / 8] & (0x80 >> (i & 7))) {
+                        col |= 1u << j;
+                    }
+                }
+                columns[d][i] = col;
+            }
+        }
+    }
+};
+
+/*!
+    @brief  数値を10進の桁に分解する（sprintf を使わない）
+    @param[in]   number  数値
+    @param[out]  digits  上の桁から順に各桁の値（10要素以上）
+    @return      桁数
+*/
+std::int16_t toDigits(std::uint32_t number, std::uint8_t* digits);
+
+/*!
+    @brief  縦1列ずつのグリフを、ページ単位のバッファに直接書き込む
+
+    画面外にはみ出した部分は書かない。回転していない画面が前提。
+
+    @param[in,out]  buffer  ページ単位のバッファ（buffer[x + (y/8)*width] の bit (y%8)）
+    @param[in]      width   バッファの幅
+    @param[in]      height  バッファの高さ
+    @param[in]      x       左上のX座標
+    @param[in]      y       左上のY座標
+    @param[in]      columns グリフの各列
+    @param[in]      w       グリフの幅
+    @param[in]      color   0: 消す、1: 描く、その他: 反転
+*/
+void blitColumns(
+    std::uint8_t* buffer,
+    std::int16_t width,
+    std::int16_t height,
+    std::int16_t x,
+    std::int16_t y,
+    const std::uint32_t* columns,
+    std::int16_t w,
+    std::uint16_t color
+);
+
+//-----------------------------------------------------------------------------
+} // namespace shark
+#endif
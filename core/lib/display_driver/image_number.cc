@@ -163,5 +163,25 @@ const std::uint8_t* digitsW9[10] = {
 	digitW9_9
 };
 
+const DigitGlyphs<18, 24>& glyphsW18()
+{
+    static const DigitGlyphs<18, 24> glyphs = [] {
+        DigitGlyphs<18, 24> g;
+        g.build(digitsW18);
+        return g;
+    }();
+    return glyphs;
+}
+
+const DigitGlyphs<9, 14>& glyphsW9()
+{
+    static const DigitGlyphs<9, 14> glyphs = [] {
+        DigitGlyphs<9, 14> g;
+        g.build(digitsW9);
+        return g;
+    }();
+    return glyphs;
+}
+
 //-----------------------------------------------------------------------------
 } // namespace shark
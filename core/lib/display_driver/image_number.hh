@@ -11,6 +11,9 @@
 // Arduino
 #include <Arduino.h> // PROGMEM
 
+// shark
+#include "glyph_blitter.hh"
+
 namespace shark {
 //-----------------------------------------------------------------------------
 
@@ -60,6 +63,12 @@ extern const std::uint8_t digitW9_9 [] PROGMEM;
 // 数字の配列
 extern const std::uint8_t* digitsW9[10];
 
+//! 縦1列ずつにした数字（18x24px、初回の呼び出しで作る）
+const DigitGlyphs<18, 24>& glyphsW18();
+
+//! 縦1列ずつにした数字（9x14px、初回の呼び出しで作る）
+const DigitGlyphs<9, 14>& glyphsW9();
+
 //-----------------------------------------------------------------------------
 } // namespace shark
 
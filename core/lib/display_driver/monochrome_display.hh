@@ -6,24 +6,49 @@
 #define SHARK_MINISTER_MONOCHROME_DISPLAY_HH
 
 // C++標準ライブラリ
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
 #include <type_traits>
 
 // Arduino
+#if defined(ARDUINO)
+#include <Wire.h>
 #include <Adafruit_SSD1306.h>
 #include <Adafruit_SH110X.h>
+#endif
 
 // shark
 #include "image_number.hh"
+#include "packed_bitmap.hh"
 
 namespace shark {
 //-----------------------------------------------------------------------------
 
-//! モノクロディスプレイ
+/*!
+    @brief  モノクロディスプレイ
+
+    送信済みの画面（シャドウバッファ）を保持し、show() では
+    ページ（縦8ドット）ごとに変化した列の範囲だけをI2Cで送る。
+    ホスト（PC）のツールでは T にメモリ上のバッファを使い、I2Cには送らずに
+    送るはずのバイト数だけを数える。
+*/
 template <typename T>
 class MonochromeDisplay
 {
 public:
+    //! SH1106のRAMは132列あり、128列の表示は2列目から始まる
+    static constexpr std::uint8_t SH1106_COLUMN_OFFSET = 2;
+
+    //! 1回のI2C送信の最大バイト数（制御バイトを含む）
+    static constexpr std::uint8_t WIRE_CHUNK = 32;
+
+    //! 転送中／転送後のI2Cクロック（Adafruitドライバと同じ）
+    static constexpr std::uint32_t WIRE_CLOCK_DURING = 400000;
+    static constexpr std::uint32_t WIRE_CLOCK_AFTER = 100000;
+
     //! コンストラクタ
     MonochromeDisplay(std::uint8_t width,
                       std::uint8_t height);
@@ -36,9 +61,27 @@ public:
         _driver.clearDisplay();
     }
 
-    //! 描画を終了し、画面に反映させる
-    inline void show() {
-        _driver.display();
+    //! 描画を終了し、変化した部分だけ画面に反映させる
+    void show();
+
+    //! 次の show() で画面全体を送る
+    inline void invalidate() {
+        _isValid = false;
+    }
+
+    //! ページ単位のバッファ（buffer[x + (y/8)*width] の bit (y%8)）。未確保なら nullptr
+    inline std::uint8_t* buffer() {
+        return _driver.getBuffer();
+    }
+
+    //! 描画先のドライバ（ホストのツールがバッファを読み出す）
+    inline const T& driver() const {
+        return _driver;
+    }
+
+    //! 直近の show() でI2Cに送ったバイト数（アドレスバイトを除く）
+    inline std::uint32_t lastFlushBytes() const {
+        return _lastFlushBytes;
     }
 
     inline void setTextColor(std::uint16_t color) {
@@ -79,22 +122,31 @@ public:
                 std::uint8_t size,
                 std::int32_t number);
 
+    /*!
+        @brief  画像の数字（9x14px）で数値を描画する
+
+        @param[in]  x           左上のX座標
+        @param[in]  y           左上のY座標
+        @param[in]  number      数値
+        @param[in]  numDigits   桁数（0より大きければ、この桁数の枠に右詰めする）
+    */
     inline void numberW9(
         std::int16_t x,
         std::int16_t y,
         std::uint32_t number,
         std::int16_t numDigits = 0
     ) {
-        this->_numberImg(x, y, number, numDigits, 9, 14, digitsW9);
+        this->_numberImg(x, y, number, numDigits, glyphsW9());
     }
 
+    //! 画像の数字（18x24px）で数値を描画する
     inline void numberW18(
         std::int16_t x,
         std::int16_t y,
         std::uint32_t number,
         std::int16_t numDigits = 0
     ) {
-        this->_numberImg(x, y, number, numDigits, 18, 24, digitsW18);
+        this->_numberImg(x, y, number, numDigits, glyphsW18());
     }
 
     /*!
@@ -114,6 +166,23 @@ public:
     ) {
         _driver.drawBitmap(x, y, bitmap, w, h, _imageColor);
     }
+
+    /*!
+        @brief  圧縮した画像を表示する（展開しながらバッファに直接書き込む）
+        @param[in]  x       左上のX座標
+        @param[in]  y       左上のY座標
+        @param[in]  bitmap  圧縮した画像
+    */
+    inline void image(
+        std::int16_t x,
+        std::int16_t y,
+        const PackedBitmap& bitmap
+    ) {
+        std::uint8_t* buf = _driver.getBuffer();
+        if (buf) {
+            blitPacked(buf, _width, _height, x, y, bitmap, _imageColor);
+        }
+    }
     
     inline void line(
         std::int16_t x0,
@@ -150,14 +219,48 @@ private:
     std::uint16_t _textColor = 1;
     std::uint16_t _imageColor = 1;
 
+    //! 画面サイズ
+    std::uint8_t _width;
+    std::uint8_t _height;
+
+    //! I2C
+#if defined(ARDUINO)
+    TwoWire* _wire = &Wire;
+#endif
+    std::uint8_t _addr = 0;
+
+    //! 送信済みの画面（確保できなかったときは毎回全体を送る）
+    std::unique_ptr<std::uint8_t[]> _shadow;
+
+    //! シャドウバッファが画面と一致しているかどうか
+    bool _isValid = false;
+
+    //! 直近の show() で送ったバイト数
+    std::uint32_t _lastFlushBytes = 0;
+
+    //! 1ページのうち、列 c0〜c1 を送る（送ったバイト数を返す）
+    std::uint32_t _sendPage(
+        std::uint8_t page,
+        std::uint8_t c0,
+        std::uint8_t c1,
+        const std::uint8_t* data
+    );
+
+    //! 制御バイトに続けて n バイトを1回のI2C送信で送る（送ったバイト数を返す）
+    std::uint32_t _transmit(
+        std::uint8_t control,
+        const std::uint8_t* bytes,
+        std::uint8_t n
+    );
+
+    //! 数字のグリフをバッファに直接書き込む（drawBitmap を通さない）
+    template <std::int16_t W, std::int16_t H>
     void _numberImg(
         std::int16_t x,
         std::int16_t y,
         std::uint32_t number,
         std::int16_t numDigits,
-        std::int16_t w,
-        std::int16_t h,
-        const std::uint8_t** images
+        const DigitGlyphs<W, H>& glyphs
     );
 };
 
@@ -165,7 +268,9 @@ template <typename T>
 MonochromeDisplay<T>::MonochromeDisplay(
     std::uint8_t width,
     std::uint8_t height
-) : _driver(width, height)
+) : _driver(width, height),
+    _width(width),
+    _height(height)
 {
 }
 
@@ -173,7 +278,13 @@ MonochromeDisplay<T>::MonochromeDisplay(
 template <typename T>
 bool MonochromeDisplay<T>::begin(std::uint8_t screen_addr)
 {
-#if DISPLAY_DRIVER == ADAFRUIT_SSD1306
+    _addr = screen_addr;
+    _isValid = false;
+    _shadow.reset(new (std::nothrow) std::uint8_t[_width * ((_height + 7) / 8)]);
+
+#if !defined(ARDUINO)
+    return _driver.begin(screen_addr);
+#elif DISPLAY_DRIVER == ADAFRUIT_SSD1306
     return _driver.begin(SSD1306_SWITCHCAPVCC, screen_addr);
 #elif DISPLAY_DRIVER == ADAFRUIT_SH1106G
     return _driver.begin(screen_addr);
@@ -182,6 +293,111 @@ bool MonochromeDisplay<T>::begin(std::uint8_t screen_addr)
 #endif
 }
 
+template <typename T>
+void MonochromeDisplay<T>::show()
+{
+    const std::uint8_t* buf = _driver.getBuffer();
+    const std::uint8_t pages = (_height + 7) / 8;
+
+    // シャドウバッファがなければ全体を送る（ドライバ任せ）
+    if (!_shadow || !buf) {
+        _driver.display();
+        _lastFlushBytes = static_cast<std::uint32_t>(_width) * pages;
+        return;
+    }
+
+    std::uint32_t bytes = 0;
+#if defined(ARDUINO)
+    _wire->setClock(WIRE_CLOCK_DURING);
+#endif
+    for (std::uint8_t p = 0; p < pages; p += 1) {
+        const std::uint8_t* cur = buf + p * _width;
+        std::uint8_t* old = _shadow.get() + p * _width;
+
+        // 変化した列の範囲
+        std::uint8_t c0 = 0;
+        std::uint8_t c1 = _width - 1;
+        if (_isValid) {
+            while (c0 < _width && cur[c0] == old[c0]) {
+                c0 += 1;
+            }
+            if (c0 == _width) {
+                continue;   // 変化なし
+            }
+            while (cur[c1] == old[c1]) {
+                c1 -= 1;
+            }
+        }
+
+        bytes += this->_sendPage(p, c0, c1, cur);
+        std::memcpy(old + c0, cur + c0, c1 - c0 + 1);
+    }
+#if defined(ARDUINO)
+    _wire->setClock(WIRE_CLOCK_AFTER);
+#endif
+
+    _isValid = true;
+    _lastFlushBytes = bytes;
+}
+
+template <typename T>
+std::uint32_t MonochromeDisplay<T>::_sendPage(
+    std::uint8_t page,
+    std::uint8_t c0,
+    std::uint8_t c1,
+    const std::uint8_t* data
+) {
+    std::uint32_t bytes = 0;
+
+    // 書き込み位置の設定（制御バイト 0x00: 以降コマンド）
+#if defined(ARDUINO)
+    constexpr bool isSH1106 = std::is_same_v<T, Adafruit_SH1106G>;
+#else
+    constexpr bool isSH1106 = false;
+#endif
+    if constexpr (isSH1106) {
+        // ページアドレッシング：ページ、列の上位4ビット、下位4ビット
+        const std::uint8_t col = c0 + SH1106_COLUMN_OFFSET;
+        const std::uint8_t cmd[] = {
+            static_cast<std::uint8_t>(0xB0 | page),
+            static_cast<std::uint8_t>(0x10 | (col >> 4)),
+            static_cast<std::uint8_t>(col & 0x0F),
+        };
+        bytes += this->_transmit(0x00, cmd, sizeof(cmd));
+    }
+    else {
+        // 水平アドレッシング：ページ範囲、列範囲
+        const std::uint8_t cmd[] = {0x22, page, page, 0x21, c0, c1};
+        bytes += this->_transmit(0x00, cmd, sizeof(cmd));
+    }
+
+    // 画像データ（制御バイト 0x40: 以降データ）
+    for (std::uint16_t c = c0; c <= c1; ) {
+        const std::uint16_t n = std::min<std::uint16_t>(WIRE_CHUNK - 1, c1 - c + 1);
+        bytes += this->_transmit(0x40, data + c, n);
+        c += n;
+    }
+    return bytes;
+}
+
+template <typename T>
+std::uint32_t MonochromeDisplay<T>::_transmit(
+    std::uint8_t control,
+    const std::uint8_t* bytes,
+    std::uint8_t n
+) {
+#if defined(ARDUINO)
+    _wire->beginTransmission(_addr);
+    _wire->write(control);
+    _wire->write(bytes, n);
+    _wire->endTransmission();
+#else
+    (void)control;
+    (void)bytes;
+#endif
+    return 1 + n;
+}
+
 template <typename T>
 void MonochromeDisplay<T>::text(
     std::int16_t x,
@@ -207,37 +423,31 @@ void MonochromeDisplay<T>::number(
 }
 
 template <typename T>
+template <std::int16_t W, std::int16_t H>
 void MonochromeDisplay<T>::_numberImg(
     std::int16_t x,
     std::int16_t y,
     std::uint32_t number,
     std::int16_t numDigits,
-    std::int16_t w,
-    std::int16_t h,
-    const std::uint8_t** images
+    const DigitGlyphs<W, H>& glyphs
 ) {
-    // 桁数の取得、文字列化
-    char buf[21];
-    std::int16_t n = std::sprintf(buf, "%u", number);
+    // 桁への分解
+    std::uint8_t digits[10];
+    const std::int16_t n = toDigits(number, digits);
 
-    // 表示
+    // 桁数の指定があれば右詰め
     if (numDigits > 0) {
-        for (std::int16_t i = n-1; i >= 0; i -= 1) {
-            this->image(
-                x + w * (i + numDigits - n), y,
-                images[static_cast<int>(buf[i])-0x30],
-                w, h
-            );
-        }
+        x += W * (numDigits - n);
     }
-    else {
-        for (std::uint32_t i = 0; i < n; i += 1) {
-            this->image(
-                x+w*i, y,
-                images[static_cast<int>(buf[i])-0x30],
-                w, h
-            );
-        }
+
+    // 表示（バッファが確保されていなければ何もしない）
+    std::uint8_t* buf = _driver.getBuffer();
+    if (!buf) {
+        return;
+    }
+    for (std::int16_t i = 0; i < n; i += 1) {
+        blitColumns(buf, _width, _height, x + W * i, y,
+                    glyphs.columns[digits[i]], W, _imageColor);
     }
 }
 
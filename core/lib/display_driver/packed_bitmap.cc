@@ -0,0 +1,127 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "packed_bitmap.hh"
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+//! 展開先（画像の列・ページ）を進めながら、1バイトずつバッファに書き込む
+class PageWriter
+{
+public:
+    PageWriter(
+        std::uint8_t* buffer,
+        std::int16_t width,
+        std::int16_t height,
+        std::int16_t x,
+        std::int16_t y,
+        std::int16_t w,
+        std::uint16_t color
+    )
+        : _buffer(buffer)
+        , _width(width)
+        , _pages((height + 7) / 8)
+        , _x(x)
+        , _page0(y >> 3)    // 負の座標も切り捨て
+        , _shift(y & 7)
+        , _w(w)
+        , _color(color)
+    {
+    }
+
+    //! 同じバイトを n 回書き込む
+    inline void put(std::uint8_t b, std::int16_t n) {
+        if (b == 0) {
+            this->_skip(n);
+            return;
+        }
+        for (; n > 0; n -= 1) {
+            this->_write(b);
+            this->_skip(1);
+        }
+    }
+
+private:
+    //! 画像の次の列へ（右端を越えたら次のページの左端へ）
+    inline void _skip(std::int16_t n) {
+        _col += n;
+        while (_col >= _w) {
+            _col -= _w;
+            _page += 1;
+        }
+    }
+
+    //! 縦8ドットをページの境界にあわせてずらし、2ページにまたがって書き込む
+    inline void _write(std::uint8_t b) {
+        const std::int16_t cx = _x + _col;
+        if (cx < 0 || cx >= _width) {
+            return;
+        }
+        std::uint16_t bits = static_cast<std::uint16_t>(b) << _shift;
+        for (std::int16_t p = _page0 + _page; bits != 0; p += 1, bits >>= 8) {
+            if (p < 0 || p >= _pages) {
+                continue;
+            }
+            const auto v = static_cast<std::uint8_t>(bits);
+            std::uint8_t& dst = _buffer[cx + p * _width];
+            switch (_color) {
+            case 0:  dst &= ~v; break;
+            case 1:  dst |= v;  break;
+            default: dst ^= v;  break;
+            }
+        }
+    }
+
+    std::uint8_t* _buffer;
+    std::int16_t _width;
+    std::int16_t _pages;
+    std::int16_t _x;
+    std::int16_t _page0;
+    std::int16_t _shift;
+    std::int16_t _w;
+    std::uint16_t _color;
+
+    //! 次に書き込む画像の列とページ
+    std::int16_t _col = 0;
+    std::int16_t _page = 0;
+};
+
+} // namespace
+
+void blitPacked(
+    std::uint8_t* buffer,
+    std::int16_t width,
+    std::int16_t height,
+    std::int16_t x,
+    std::int16_t y,
+    const PackedBitmap& bitmap,
+    std::uint16_t color
+) {
+    if (bitmap.width == 0) {
+        return;
+    }
+    PageWriter writer(buffer, width, height, x, y, bitmap.width, color);
+
+    const std::uint8_t* src = bitmap.data;
+    const std::uint8_t* const end = src + bitmap.size;
+    while (src < end) {
+        const auto n = static_cast<std::int8_t>(*src++);
+        if (n >= 0) {
+            // そのまま
+            for (std::int16_t i = 0; i <= n && src < end; i += 1) {
+                writer.put(*src++, 1);
+            }
+        }
+        else if (n != -128 && src < end) {
+            // 繰り返し
+            writer.put(*src++, static_cast<std::int16_t>(1 - n));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark
@@ -0,0 +1,63 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_PACKED_BITMAP_HH
+#define SHARK_MINISTER_PACKED_BITMAP_HH
+
+// C++標準ライブラリ
+#include <cstdint>
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  PackBits で圧縮したビットマップ
+
+    圧縮前のデータはディスプレイのRAMと同じページ単位の並び
+    （ページ0の左から右の各列、ページ1の各列、…。1バイト = 縦8ドット、LSBが上）。
+    縦に並ぶ白の列や横に続く線が同じバイトの連続になるので、Adafruit GFX 形式
+    （1行ずつ、MSBが左）より縮みやすい。
+
+    PackBits の制御バイト n（符号付き）:
+    - 0〜127:    続く n+1 バイトをそのまま出力
+    - -1〜-127:  続く1バイトを 1-n 回出力
+    - -128:      何もしない
+
+    データは tools/image_pack で PBM から生成する。
+*/
+struct PackedBitmap
+{
+    const std::uint8_t* data;   //!< 圧縮データ
+    std::uint16_t size;         //!< 圧縮データのバイト数
+    std::uint8_t width;         //!< 画像の幅
+    std::uint8_t height;        //!< 画像の高さ
+};
+
+/*!
+    @brief  圧縮したビットマップを展開しながら、ページ単位のバッファに直接書き込む
+
+    一時バッファは使わない。0のバイト（透明）は書かず、0の連続はまとめて読み飛ばす。
+    画面外にはみ出した部分は書かない。回転していない画面が前提。
+
+    @param[in,out]  buffer  ページ単位のバッファ（buffer[x + (y/8)*width] の bit (y%8)）
+    @param[in]      width   バッファの幅
+    @param[in]      height  バッファの高さ
+    @param[in]      x       左上のX座標
+    @param[in]      y       左上のY座標
+    @param[in]      bitmap  圧縮したビットマップ
+    @param[in]      color   0: 消す、1: 描く、その他: 反転
+*/
+void blitPacked(
+    std::uint8_t* buffer,
+    std::int16_t width,
+    std::int16_t height,
+    std::int16_t x,
+    std::int16_t y,
+    const PackedBitmap& bitmap,
+    std::uint16_t color
+);
+
+//-----------------------------------------------------------------------------
+} // namespace shark
+#endif
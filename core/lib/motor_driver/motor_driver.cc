@@ -5,11 +5,39 @@
 #include "motor_driver.hh"
 
 // Arduino
-#include <Arduino.h>
+#include <Arduino.h>    // Serial
+
+// shark lib
+#include "gpio.hh"
+#include "lock.hh"
 
 namespace shark {
 //-----------------------------------------------------------------------------
 
+namespace {
+
+// 加速タイマーの周期 [us]
+constexpr std::uint64_t RAMP_TICK_US = 5000;
+
+// 加速カーブの固定小数点（1.0 = 1024）
+constexpr std::int64_t RAMP_ONE = 1024;
+
+// 加速の進み具合 x (0 - RAMP_ONE) に対するデューティ比の割合 (0 - RAMP_ONE)
+std::int64_t rampCurve(RampCurve curve, std::int64_t x)
+{
+    switch (curve) {
+    case RampCurve::EASE_IN:
+        return x * x / RAMP_ONE;
+    case RampCurve::S_CURVE:    // 3x^2 - 2x^3
+        return x * x * (3 * RAMP_ONE - 2 * x) / (RAMP_ONE * RAMP_ONE);
+    case RampCurve::LINEAR:
+    default:
+        return x;
+    }
+}
+
+} // namespace
+
 bool MotorDriver::_dummyMode = false;
 
 void MotorDriver::configure(
@@ -26,10 +54,20 @@ void MotorDriver::configure(
 
     if (!_dummyMode) {
         // 全てのピンを出力モードに
-        pinMode(_pwmR, OUTPUT);
-        pinMode(_pwmL, OUTPUT);
-        pinMode(_enabledLR, OUTPUT);
+        gpio::mode(_pwmR, gpio::PinMode::OUT);
+        gpio::mode(_pwmL, gpio::PinMode::OUT);
+        gpio::mode(_enabledLR, gpio::PinMode::OUT);
     }
+
+    // 加速タイマーの作成
+    _timer.begin("motorRamp", _onRampTimer, this);
+}
+
+void MotorDriver::setRamp(RampCurve curve, std::uint16_t stepMs)
+{
+    Lock lock(_mutex);
+    _curve = curve;
+    _stepMs = stepMs;
 }
 
 void MotorDriver::reset()
@@ -38,26 +76,47 @@ void MotorDriver::reset()
         Serial.println("reset motor");
     }
     else {
-        digitalWrite(_pwmL, LOW);
-        digitalWrite(_pwmR, LOW);
-        digitalWrite(_enabledLR, LOW);
+        gpio::write(_pwmL, false);
+        gpio::write(_pwmR, false);
+        gpio::write(_enabledLR, false);
     }
 }
 
 void MotorDriver::stop()
 {
+    Lock lock(_mutex);
+
+    // 加速中なら中止する
+    _timer.stop();
+    _state.store(State::STOPPED);
+    _duty = 0;
+
     if (_dummyMode) {
         Serial.println("stop motor");
     }
     else {
-        analogWrite(_curPwm, 0);
+        gpio::pwm(_curPwm, 0);
     }
 }
 
 void MotorDriver::rotate(int sp, bool isRight)
 {
-    std::uint8_t pwm = isRight ? _pwmR : _pwmL;
+    if (!this->rotateAsync(sp, isRight)) {
+        return;
+    }
 
+    // 加速完了まで待機（CPUは他のタスクに譲る）
+    while (this->isRamping()) {
+        os::delay(_stepMs);
+    }
+}
+
+bool MotorDriver::rotateAsync(
+    int sp,
+    bool isRight,
+    Callback onSpunUp,
+    void* arg
+) {
     // 設定した最大SPを超えないように調整
     if (sp > _maxSP) {
         sp = _maxSP;
@@ -67,28 +126,127 @@ void MotorDriver::rotate(int sp, bool isRight)
         sp = 1;
     }
 
-    if (_dummyMode) {
-        Serial.println("rotate motor");
+    // PWMデューティ比を求める
+    int duty = static_cast<int>(
+        (static_cast<double>(sp-1) / _maxSP) * 256
+    );
+    return this->rotateDutyAsync(duty, isRight, onSpunUp, arg);
+}
+
+bool MotorDriver::rotateDutyAsync(
+    int duty,
+    bool isRight,
+    Callback onSpunUp,
+    void* arg
+) {
+    // デューティ比の範囲 (0 - 255) に収める
+    if (duty > 255) {
+        duty = 255;
     }
-    else {
-        // L_EN, R_ENをHIGHにする。これをしないと回らない
-        digitalWrite(_enabledLR, HIGH);
-        
-        // PWMデューティ比を求める
-        int spDuty = static_cast<int>(
-            (static_cast<double>(sp-1) / _maxSP) * 256
-        );
-
-        // 所定のデューティ比まで段階的に加速する
-        for (int duty = 1; duty < spDuty; duty += 1) {
-            analogWrite(pwm, duty);
-            delay(15);
+    else if (duty < 0) {
+        duty = 0;
+    }
+
+    bool spunUp = false;
+    {
+        Lock lock(_mutex);
+
+        std::uint8_t pwm = isRight ? _pwmR : _pwmL;
+
+        // 加速中なら中止する
+        _timer.stop();
+
+        // PWMピン番号を記憶する
+        _curPwm = pwm;
+        _onSpunUp = onSpunUp;
+        _arg = arg;
+        _targetDuty = duty;
+
+        if (_dummyMode) {
+            Serial.println("rotate motor");
+            _finishRamp();
+            spunUp = true;
+        }
+        else {
+            if (!_timer.isCreated()) {
+                return false;
+            }
+
+            // L_EN, R_ENをHIGHにする。これをしないと回らない
+            gpio::write(_enabledLR, true);
+
+            // 所定のデューティ比まで段階的に加速する
+            _duty = 1;
+            gpio::pwm(pwm, _duty);
+            _rampStart = os::now();
+            _rampDuration = static_cast<std::int64_t>(_targetDuty) * _stepMs * 1000;
+            _state.store(State::RAMPING);
+
+            if (_duty >= _targetDuty) {
+                _finishRamp();
+                spunUp = true;
+            }
+            else if (!_timer.startPeriodic(RAMP_TICK_US)) {
+                _state.store(State::STOPPED);
+                return false;
+            }
+        }
+    }
+
+    // 即座に加速し終えたときは、ここで完了を通知する
+    if (spunUp && onSpunUp) {
+        onSpunUp(arg);
+    }
+    return true;
+}
+
+void MotorDriver::_onRampTimer(void* arg)
+{
+    auto& self = *static_cast<MotorDriver*>(arg);
+    Callback onSpunUp = nullptr;
+    void* cbArg = nullptr;
+    {
+        Lock lock(self._mutex);
+
+        // stop() された後に残っていた呼び出し
+        if (self._state.load() != State::RAMPING) {
+            return;
         }
-        analogWrite(pwm, spDuty);
+
+        // 加速カーブ上のデューティ比
+        const std::int64_t elapsed = os::now() - self._rampStart;
+        if (elapsed < self._rampDuration) {
+            const std::int64_t x = elapsed * RAMP_ONE / self._rampDuration;
+            int duty = static_cast<int>(
+                self._targetDuty * rampCurve(self._curve, x) / RAMP_ONE
+            );
+            if (duty > self._duty) {
+                self._duty = duty;
+                gpio::pwm(self._curPwm, duty);
+            }
+            return;
+        }
+
+        // 加速完了
+        self._timer.stop();
+        self._finishRamp();
+        onSpunUp = self._onSpunUp;
+        cbArg = self._arg;
     }
 
-    // PWMピン番号を記憶する
-    _curPwm = pwm;
+    // 加速完了の通知（ロックの外で呼ぶ）
+    if (onSpunUp) {
+        onSpunUp(cbArg);
+    }
+}
+
+void MotorDriver::_finishRamp()
+{
+    _duty = _targetDuty;
+    if (!_dummyMode) {
+        gpio::pwm(_curPwm, _duty);
+    }
+    _state.store(State::SPUN_UP);
 }
 
 void MotorDriver::setDummyMode()
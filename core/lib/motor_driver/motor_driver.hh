@@ -6,15 +6,32 @@
 #define SHARK_MINISTER_MOTOR_HH
 
 // C++標準ライブラリ
+#include <atomic>   // std::atomic
 #include <cstdint>  // std::uint8_t
 
+// shark lib
+#include "mutex.hh"
+#include "os.hh"
+
 namespace shark {
 //-----------------------------------------------------------------------------
 
+//! 加速カーブ
+enum class RampCurve
+    : std::uint8_t
+{
+    LINEAR,     //!< 線形（一定の加速度）
+    EASE_IN,    //!< 2次関数（ゆっくり回り始めて、後半で加速する）
+    S_CURVE,    //!< S字（回り始めと目標付近をゆっくり加速する）
+};
+
 //! モーター制御の補助を行うクラス
 class MotorDriver
 {
 public:
+    //! 加速完了時に呼ばれる関数
+    using Callback = void (*)(void* arg);
+
     /*!
         @brief  設定
         @param[in]  pinPwmL     左回転PWMのピン番号
@@ -27,21 +44,86 @@ public:
                    std::uint8_t pinEnabled,
                    int maxRPM);
 
+    /*!
+        @brief  加速の設定
+        @param[in]  curve   加速カーブ
+        @param[in]  stepMs  デューティ比1段あたりの加速時間 [ms]
+    */
+    void setRamp(RampCurve curve, std::uint16_t stepMs);
+
     //! リセット
     void reset();
     
-    //! モーターの急停止を行う
+    //! モーターの急停止を行う（加速中なら加速も中止する）
     void stop();
     
     /*!
-        @brief  指定したSPまでモーターを回転する
+        @brief  指定したSPまでモーターを回転する（加速が終わるまでブロックする）
         @param[in]  sp       シュートパワー
         @param[in]  isRight  右回転かどうか（デフォルトtrue）
     */
     void rotate(int sp, bool isRight = true);
 
+    /*!
+        @brief  指定したSPまでの加速を開始する（ブロックしない）
+        @param[in]  sp        シュートパワー
+        @param[in]  isRight   右回転かどうか
+        @param[in]  onSpunUp  加速完了時に呼ばれる関数（ESPタイマーのタスクから呼ばれる）
+        @param[in]  arg       onSpunUp の引数
+        @return     加速を開始できたかどうか
+
+        加速はESPタイマーで駆動するので、呼び出し元のタスクは
+        加速中も他の処理を続けられる。加速の必要がないとき（ダミーモードなど）は
+        onSpunUp は呼び出し元のタスクから直ちに呼ばれる。
+    */
+    bool rotateAsync(int sp,
+                     bool isRight = true,
+                     Callback onSpunUp = nullptr,
+                     void* arg = nullptr);
+
+    /*!
+        @brief  指定したデューティ比までの加速を開始する（ブロックしない）
+        @param[in]  duty      PWMデューティ比 (0 - 255)
+        @param[in]  isRight   右回転かどうか
+        @param[in]  onSpunUp  加速完了時に呼ばれる関数（ESPタイマーのタスクから呼ばれる）
+        @param[in]  arg       onSpunUp の引数
+        @return     加速を開始できたかどうか
+
+        SPからデューティ比への換算を呼び出し元で行う（較正表を使う）ときに用いる。
+    */
+    bool rotateDutyAsync(int duty,
+                         bool isRight = true,
+                         Callback onSpunUp = nullptr,
+                         void* arg = nullptr);
+
+    //! 加速中かどうかを返す
+    inline bool isRamping() const noexcept {
+        return _state.load() == State::RAMPING;
+    }
+
+    //! 目標のSPまで加速し終えたかどうかを返す
+    inline bool isSpunUp() const noexcept {
+        return _state.load() == State::SPUN_UP;
+    }
+
     static void setDummyMode();
 
+private:
+    //! 回転状態
+    enum class State
+        : std::uint8_t
+    {
+        STOPPED,    //!< 停止
+        RAMPING,    //!< 加速中
+        SPUN_UP,    //!< 加速完了
+    };
+
+    //! 加速タイマーのコールバック
+    static void _onRampTimer(void* arg);
+
+    //! 加速完了の処理
+    void _finishRamp();
+
 private:
     std::uint8_t _pwmL = 0;       //!< 左回転PWMのピン番号
     std::uint8_t _pwmR = 0;       //!< 右回転PWMのピン番号
@@ -49,10 +131,25 @@ private:
     std::uint8_t _curPwm = 0;     //!< 現在のPWMピン番号
     int _maxSP = 0;               //!< 最大シュートパワー
 
+    // 加速
+    RampCurve _curve = RampCurve::LINEAR;   //!< 加速カーブ
+    std::uint16_t _stepMs = 15;             //!< デューティ比1段あたりの加速時間 [ms]
+    os::Timer _timer;                       //!< 加速タイマー
+    int _duty = 0;                          //!< 現在のデューティ比
+    int _targetDuty = 0;                    //!< 目標のデューティ比
+    std::int64_t _rampStart = 0;            //!< 加速開始時刻 [us]
+    std::int64_t _rampDuration = 0;         //!< 加速に掛ける時間 [us]
+    Callback _onSpunUp = nullptr;           //!< 加速完了時に呼ばれる関数
+    void* _arg = nullptr;                   //!< _onSpunUp の引数
+    std::atomic<State> _state {State::STOPPED};
+
+    //! 排他制御（加速タイマーと stop() の競合を防ぐ）
+    Mutex _mutex;
+
     //! ダミーモードかどうか
     static bool _dummyMode;
 };
 
 //-----------------------------------------------------------------------------
 } // namespace shark
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,54 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    GPIOの抽象化層の実機（Arduino）の実装
+
+    ホストのツールは、この代わりに tools/common/host/os_sim.cc をリンクする。
+*/
+#include "gpio.hh"
+
+// Arduino
+#include <Arduino.h>
+
+namespace shark::gpio {
+//-----------------------------------------------------------------------------
+
+void mode(std::uint8_t pin, PinMode mode)
+{
+    switch (mode) {
+    case PinMode::IN:
+        pinMode(pin, INPUT);
+        break;
+    case PinMode::IN_PULLUP:
+        pinMode(pin, INPUT_PULLUP);
+        break;
+    case PinMode::OUT:
+        pinMode(pin, OUTPUT);
+        break;
+    }
+}
+
+bool read(std::uint8_t pin)
+{
+    return digitalRead(pin) == HIGH;
+}
+
+void write(std::uint8_t pin, bool level)
+{
+    digitalWrite(pin, level ? HIGH : LOW);
+}
+
+void pwm(std::uint8_t pin, std::uint8_t duty)
+{
+    analogWrite(pin, duty);
+}
+
+void attachChange(std::uint8_t pin, Isr isr, void* arg)
+{
+    attachInterruptArg(pin, isr, arg, CHANGE);
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark::gpio
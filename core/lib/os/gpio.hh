@@ -0,0 +1,56 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_GPIO_HH
+#define SHARK_MINISTER_GPIO_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t
+
+#if defined(ARDUINO)
+// ESP-IDF
+#include <esp_attr.h>   // IRAM_ATTR
+#else
+#define  IRAM_ATTR      // ホストでは割り込みもスレッドで呼ぶ
+#endif
+
+/*
+    GPIOの薄い抽象化層
+
+    実機（ARDUINO）では gpio.cc が Arduino のGPIO関数をそのまま呼び、
+    ホスト（PC）のツールでは tools/common/host/os_sim.cc が仮想のピンを操作する。
+*/
+namespace shark::gpio {
+//-----------------------------------------------------------------------------
+
+//! ピンの入出力
+enum class PinMode
+    : std::uint8_t
+{
+    IN,         //!< 入力
+    IN_PULLUP,  //!< 入力（内蔵プルアップ抵抗）
+    OUT,        //!< 出力
+};
+
+//! 割り込みの関数
+using Isr = void (*)(void* arg);
+
+//! ピンの入出力を設定する
+void mode(std::uint8_t pin, PinMode mode);
+
+//! 入力を読む（HIGHなら true）
+bool read(std::uint8_t pin);
+
+//! 出力する（HIGHなら true）
+void write(std::uint8_t pin, bool level);
+
+//! PWMで出力する（デューティ比 0 - 255）
+void pwm(std::uint8_t pin, std::uint8_t duty);
+
+//! 入力が変化したとき（両エッジ）に呼ばれる割り込みを設定する
+void attachChange(std::uint8_t pin, Isr isr, void* arg);
+
+//-----------------------------------------------------------------------------
+} // namespace shark::gpio
+#endif
@@ -0,0 +1,199 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    OSの抽象化層の実機（FreeRTOS / ESPタイマー）の実装
+
+    ホストのツールは、この代わりに tools/common/host/os_sim.cc をリンクする。
+*/
+#include "os.hh"
+
+// C++標準ライブラリ
+#include <new>          // std::nothrow
+
+// ESP-IDF
+#include <esp_attr.h>   // IRAM_ATTR
+
+namespace shark::os {
+//-----------------------------------------------------------------------------
+
+// ESP32のFreeRTOSは、スタックの大きさをバイト単位で指定する
+static_assert(sizeof(StackType_t) == 1, "StackType_t is not a byte");
+
+namespace {
+
+// 待ち時間 [ms] をティックにする
+TickType_t toTicks(std::uint32_t ms)
+{
+    return ms == FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(ms);
+}
+
+// 使い捨てのタスクの関数と引数
+struct SpawnedTask
+{
+    TaskFunction func;
+    void* arg;
+};
+
+// 使い捨てのタスク（関数から戻ったら自分を削除する。スタックはアイドルタスクが解放する）
+void runSpawned(void* pvParams)
+{
+    const SpawnedTask task = *static_cast<SpawnedTask*>(pvParams);
+    delete static_cast<SpawnedTask*>(pvParams);
+    task.func(task.arg);
+    vTaskDelete(nullptr);
+}
+
+} // namespace
+
+//=============================================================================
+// 時刻・待機
+//=============================================================================
+
+std::int64_t now()
+{
+    return esp_timer_get_time();
+}
+
+std::uint32_t millis()
+{
+    return pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
+void delay(std::uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayUntil(std::uint32_t& lastWake, std::uint32_t period)
+{
+    TickType_t ticks = pdMS_TO_TICKS(lastWake);
+    vTaskDelayUntil(&ticks, pdMS_TO_TICKS(period));
+    lastWake = pdTICKS_TO_MS(ticks);
+}
+
+void yield()
+{
+    taskYIELD();
+}
+
+bool takeNotify(std::uint32_t timeout)
+{
+    return ulTaskNotifyTake(pdTRUE, toTicks(timeout)) > 0;
+}
+
+//=============================================================================
+// タスク
+//=============================================================================
+
+bool Task::start(
+    TaskFunction func,
+    const char* name,
+    void* arg,
+    std::uint8_t priority,
+    std::uint8_t* stack,
+    std::uint32_t stackSize
+) {
+    _control.handle = xTaskCreateStatic(
+        func, name, stackSize, arg, priority, stack, &_control.buffer
+    );
+    return _control.handle != nullptr;
+}
+
+void Task::notify()
+{
+    if (_control.handle) {
+        xTaskNotifyGive(_control.handle);
+    }
+}
+
+bool spawn(
+    TaskFunction func,
+    const char* name,
+    void* arg,
+    std::uint8_t priority,
+    std::uint32_t stackSize
+) {
+    auto* task = new (std::nothrow) SpawnedTask {func, arg};
+    if (!task) {
+        return false;
+    }
+    if (xTaskCreate(runSpawned, name, stackSize, task, priority, nullptr) != pdPASS) {
+        delete task;
+        return false;
+    }
+    return true;
+}
+
+//=============================================================================
+// キュー
+//=============================================================================
+
+bool Queue::begin(std::uint32_t length, std::uint32_t itemSize, std::uint8_t* storage)
+{
+    _control.handle = xQueueCreateStatic(length, itemSize, storage, &_control.buffer);
+    return _control.handle != nullptr;
+}
+
+bool Queue::send(const void* item, std::uint32_t timeout)
+{
+    return _control.handle && xQueueSend(_control.handle, item, toTicks(timeout)) == pdTRUE;
+}
+
+bool Queue::receive(void* item, std::uint32_t timeout)
+{
+    return _control.handle && xQueueReceive(_control.handle, item, toTicks(timeout)) == pdTRUE;
+}
+
+std::uint32_t Queue::count() const
+{
+    return _control.handle ? uxQueueMessagesWaiting(_control.handle) : 0;
+}
+
+void Queue::reset()
+{
+    if (_control.handle) {
+        xQueueReset(_control.handle);
+    }
+}
+
+//=============================================================================
+// タイマー
+//=============================================================================
+
+bool Timer::begin(const char* name, TimerCallback callback, void* arg)
+{
+    if (_control.handle) {
+        return true;
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = callback;
+    args.arg = arg;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = name;
+    return esp_timer_create(&args, &_control.handle) == ESP_OK;
+}
+
+// start / stop はGPIOの割り込み（IRAM）からも呼ばれるので、IRAMに置く
+
+bool IRAM_ATTR Timer::startOnce(std::uint64_t timeout)
+{
+    return _control.handle && esp_timer_start_once(_control.handle, timeout) == ESP_OK;
+}
+
+bool IRAM_ATTR Timer::startPeriodic(std::uint64_t period)
+{
+    return _control.handle && esp_timer_start_periodic(_control.handle, period) == ESP_OK;
+}
+
+void IRAM_ATTR Timer::stop()
+{
+    if (_control.handle) {
+        esp_timer_stop(_control.handle);
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark::os
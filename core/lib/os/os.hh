@@ -0,0 +1,307 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_OS_HH
+#define SHARK_MINISTER_OS_HH
+
+// C++標準ライブラリ
+#include <cstdint>      // std::uint8_t, std::uint32_t, std::int64_t
+#include <type_traits>  // std::is_trivially_copyable_v
+
+#if defined(ARDUINO)
+// ESP-IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#endif
+
+/*
+    OSの薄い抽象化層
+
+    タスク・キュー・タスク通知・タイマー・時刻の操作を、FreeRTOS / ESPタイマーを
+    直接呼ばずに使うためのもの。実機（ARDUINO）では os.cc が FreeRTOS と ESPタイマーを
+    そのまま呼び、ホスト（PC）のツールでは tools/common/host/os_sim.cc が
+    スレッドと仮想時刻で同じ動作をする。
+
+    - 時間の単位は、タイマーと now() がマイクロ秒、それ以外はミリ秒（FreeRTOSのティック）
+    - タスク・キューの領域は静的に確保する（StaticTask / StaticQueue）。
+      起動時の初期化のように1度だけの処理は spawn() で動かし、終わればスタックを解放する
+*/
+namespace shark::os {
+//-----------------------------------------------------------------------------
+
+//! 待ち時間に指定すると無期限に待つ
+constexpr std::uint32_t FOREVER = UINT32_MAX;
+
+//! タスクの関数（戻らないこと。spawn() で開始したタスクは戻ってよい）
+using TaskFunction = void (*)(void* arg);
+
+//! タイマーのコールバック
+using TimerCallback = void (*)(void* arg);
+
+namespace detail {
+
+#if defined(ARDUINO)
+struct TaskControl
+{
+    TaskHandle_t handle = nullptr;
+    StaticTask_t buffer;
+};
+
+struct QueueControl
+{
+    QueueHandle_t handle = nullptr;
+    StaticQueue_t buffer;
+};
+
+struct TimerControl
+{
+    esp_timer_handle_t handle = nullptr;
+};
+#else
+struct HostTask;
+struct HostQueue;
+struct HostTimer;
+
+struct TaskControl
+{
+    HostTask* handle = nullptr;
+};
+
+struct QueueControl
+{
+    HostQueue* handle = nullptr;
+};
+
+struct TimerControl
+{
+    HostTimer* handle = nullptr;
+};
+#endif
+
+} // namespace detail
+
+//=============================================================================
+// 時刻・待機
+//=============================================================================
+
+//! 現在時刻（起動からの時間） [us]
+std::int64_t now();
+
+//! 現在時刻（起動からのティック数） [ms]
+std::uint32_t millis();
+
+//! 指定した時間だけ待つ [ms]
+void delay(std::uint32_t ms);
+
+/*!
+    @brief  一定の周期で待つ（処理時間の揺らぎが周期に積もらない）
+    @param[in,out]  lastWake  前回の起床時刻（millis() の値で初期化する） [ms]
+    @param[in]      period    周期 [ms]
+*/
+void delayUntil(std::uint32_t& lastWake, std::uint32_t period);
+
+//! 同じ優先度の他のタスクに実行を譲る
+void yield();
+
+/*!
+    @brief  実行中のタスクへの通知を待つ
+    @param[in]  timeout  最大待ち時間 [ms]（0なら待たずに確認する）
+    @return     通知があったかどうか（複数回の通知も1回として消費する）
+*/
+bool takeNotify(std::uint32_t timeout = FOREVER);
+
+//=============================================================================
+// タスク
+//=============================================================================
+
+//! タスク（スタックは StaticTask が持つ）
+class Task
+{
+public:
+    /*!
+        @brief  タスクを開始する
+        @param[in]  func       タスクの関数
+        @param[in]  name       タスク名
+        @param[in]  arg        タスクの関数の引数
+        @param[in]  priority   優先度（値が大きいほど優先順位が高い）
+        @param[in]  stack      スタック領域
+        @param[in]  stackSize  スタック領域のバイト数
+        @return     開始できたかどうか
+    */
+    bool start(TaskFunction func,
+               const char* name,
+               void* arg,
+               std::uint8_t priority,
+               std::uint8_t* stack,
+               std::uint32_t stackSize);
+
+    //! タスクに通知する（待っているタスクは takeNotify() から戻る）
+    void notify();
+
+    //! 開始したかどうか
+    inline bool isCreated() const noexcept {
+        return _control.handle != nullptr;
+    }
+
+private:
+    detail::TaskControl _control;
+};
+
+//! スタックを静的に確保したタスク
+template <std::uint32_t STACK_SIZE>
+class StaticTask
+    : public Task
+{
+public:
+    //! タスクを開始する（2回目以降は何もしない）
+    inline bool start(TaskFunction func,
+                      const char* name,
+                      void* arg,
+                      std::uint8_t priority) {
+        return this->isCreated() ||
+            Task::start(func, name, arg, priority, _stack, STACK_SIZE);
+    }
+
+private:
+    std::uint8_t _stack[STACK_SIZE];
+};
+
+/*!
+    @brief  使い捨てのタスクを開始する
+
+    スタックはヒープに確保し、関数から戻るとタスクを削除してスタックを解放する。
+    起動時の初期化のように1度だけの処理に使う（常駐するタスクは StaticTask を使う）。
+    @param[in]  func       タスクの関数（戻ってよい）
+    @param[in]  name       タスク名
+    @param[in]  arg        タスクの関数の引数
+    @param[in]  priority   優先度（値が大きいほど優先順位が高い）
+    @param[in]  stackSize  スタック領域のバイト数
+    @return     開始できたかどうか（ヒープが足りなければ false）
+*/
+bool spawn(TaskFunction func,
+           const char* name,
+           void* arg,
+           std::uint8_t priority,
+           std::uint32_t stackSize);
+
+//=============================================================================
+// キュー
+//=============================================================================
+
+//! 固定長の要素を値で受け渡すキュー（領域は StaticQueue が持つ）
+class Queue
+{
+public:
+    /*!
+        @brief  キューを作る
+        @param[in]  length    最大の要素数
+        @param[in]  itemSize  要素のバイト数
+        @param[in]  storage   要素の領域（length * itemSize バイト）
+        @return     作れたかどうか
+    */
+    bool begin(std::uint32_t length, std::uint32_t itemSize, std::uint8_t* storage);
+
+    /*!
+        @brief  末尾に積む
+        @param[in]  item     要素
+        @param[in]  timeout  空きを待つ最大時間 [ms]
+        @return     積めたかどうか
+    */
+    bool send(const void* item, std::uint32_t timeout = 0);
+
+    /*!
+        @brief  先頭から取り出す
+        @param[out]  item     要素
+        @param[in]   timeout  要素を待つ最大時間 [ms]
+        @return      取り出せたかどうか
+    */
+    bool receive(void* item, std::uint32_t timeout = FOREVER);
+
+    //! 積まれている要素の数
+    std::uint32_t count() const;
+
+    //! 空にする
+    void reset();
+
+    //! 作ったかどうか
+    inline bool isCreated() const noexcept {
+        return _control.handle != nullptr;
+    }
+
+private:
+    detail::QueueControl _control;
+};
+
+//! 要素の型と長さを決めて、領域を静的に確保したキュー
+template <typename T, std::uint32_t LENGTH>
+class StaticQueue
+    : public Queue
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "queue item is not trivially copyable");
+
+public:
+    //! キューを作る（2回目以降は何もしない）
+    inline bool begin() {
+        return this->isCreated() || Queue::begin(LENGTH, sizeof(T), _storage);
+    }
+
+    inline bool send(const T& item, std::uint32_t timeout = 0) {
+        return Queue::send(&item, timeout);
+    }
+
+    inline bool receive(T& item, std::uint32_t timeout = FOREVER) {
+        return Queue::receive(&item, timeout);
+    }
+
+private:
+    std::uint8_t _storage[LENGTH * sizeof(T)];
+};
+
+//=============================================================================
+// タイマー
+//=============================================================================
+
+/*!
+    @brief  マイクロ秒単位のタイマー（ESPタイマー）
+
+    コールバックはタイマーのタスクから呼ばれるので、ブロックする処理は書かないこと。
+    start は動作中なら失敗するので、セットし直すときは先に stop() する。
+    start / stop はGPIOの割り込みからも呼べる。
+*/
+class Timer
+{
+public:
+    /*!
+        @brief  タイマーを作る
+        @param[in]  name      タイマー名
+        @param[in]  callback  発火時に呼ばれる関数
+        @param[in]  arg       コールバックの引数
+        @return     作れたかどうか
+    */
+    bool begin(const char* name, TimerCallback callback, void* arg);
+
+    //! timeout [us] 後に1度だけ発火させる
+    bool startOnce(std::uint64_t timeout);
+
+    //! period [us] ごとに発火させる
+    bool startPeriodic(std::uint64_t period);
+
+    //! 止める（動作していなければ何もしない）
+    void stop();
+
+    //! 作ったかどうか
+    inline bool isCreated() const noexcept {
+        return _control.handle != nullptr;
+    }
+
+private:
+    detail::TimerControl _control;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace shark::os
+#endif
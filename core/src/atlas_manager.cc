@@ -9,11 +9,13 @@
 #include <SPIFFS.h>     // フラッシュメモリをファイル保存に使う
 
 // shark lib
-#include "lock.hh"
+#include "button.hh"
+#include "os.hh"
 
 // ATLAS
 #include "utils.hh"
 #include "mode_process.hh"
+#include "trace.hh"
 
 namespace atlas
 {
@@ -25,93 +27,164 @@ namespace atlas
 //
 //=============================================================================
 
+namespace {
+
+// 切替スイッチ
+shark::Button gButton;
+
+// スイッチの入力を監視するタスク
+shark::os::StaticTask<2048> gTaskSwitch;
+
+// 起動時の初期化のタスクのスタック（使い捨てのタスクなので、終われば解放される）
+constexpr std::uint32_t STACK_BOOT_TASK = 4096;
+
+// ファイルを読み込み終えた知らせ（マウントできたかどうか）
+shark::os::StaticQueue<bool, 1> gQueueStorage;
+
+// ファイルの内容を読み込む（なければ、サイズが違えば読まずに false）
+template <typename T>
+bool loadFile(const char* path, T& value)
+{
+    bool loaded = false;
+    if (File file = SPIFFS.open(path, "r")) {
+        if (file.size() == sizeof(value)) {
+            readFile(file, value);
+            loaded = true;
+        }
+        file.close();
+    }
+    return loaded;
+}
+
+} // namespace
+
+/*
+    起動時のファイルの読み込み
+
+    SPIFFSのマウント（初回はフォーマットするので数秒かかる）と解析結果・パラメータ・
+    SP較正の読み込みを、表示の開始・モーターの設定と並行して行う。
+    終わったら gQueueStorage で知らせて、タスクを終える。
+*/
+void taskStorage(void* pvParams)
+{
+    ATLAS.result.initialize();
+    ATLAS.params.initialize();
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+    ATLAS.calib.initialize();
+#endif
+
+    // SPIFFS開始
+    const bool mounted = SPIFFS.begin(true);
+    ATLAS.boot.mark(BootStage::FLASH_MOUNT, mounted);
+
+    // ファイルがなければ既定値のまま（失敗として記録する）
+    bool loaded = mounted;
+    if (mounted) {
+        if (loadFile(RESULT_FPATH, ATLAS.result)) {
+            debugMsg(F("read statistics file"));
+        }
+        else {
+            loaded = false;
+        }
+        if (loadFile(PARAMS_FPATH, ATLAS.params)) {
+            debugMsg(F("read parameter file"));
+        }
+        else {
+            loaded = false;
+        }
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+        if (loadFile(CALIB_FPATH, ATLAS.calib)) {
+            debugMsg(F("read calibration file"));
+        }
+        else {
+            loaded = false;
+        }
+#endif
+    }
+    ATLAS.params.regulate();
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+    ATLAS.calib.regulate();
+#endif
+    ATLAS.boot.mark(BootStage::FILES_LOADED, loaded);
+
+    gQueueStorage.send(mounted);
+}
+
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+/*
+    起動時の音声制御の開始
+
+    DFプレイヤーは9600bpsのシリアルで応答を待つので、数秒かかることがある。
+    起動を待たせないように裏で開始する。開始が済むまでは音声なしで動く
+    （音声制御が無効なときと同じ）。
+*/
+void taskAudio(void* pvParams)
+{
+    const bool started = ATLAS.player.begin(Serial1, 9600, AUDIO_RX, AUDIO_TX, AUDIO_BUSY,
+                                            DEFAULT_VOLUME);
+    if (!started) {
+        debugMsg(F("failed to start audio player"));
+    }
+    ATLAS.boot.mark(BootStage::AUDIO, started);
+}
+#endif
+
 void taskSwitchMonitor(void* pvParams)
 {
+    shark::ButtonEvent event;
+
 //-----------------------------------------------------------------------------
 #if SWITCH_TYPE == SW_TACT // タクトスイッチを使う場合
 //-----------------------------------------------------------------------------
 
-    bool btnState = HIGH;          // ボタンの状態
-    bool lastPhysState = HIGH;     // 最後のボタン状態
-    bool longPressFired = false;
-    std::uint32_t tLastDebounce = 0;
-    std::uint32_t tPressStart = 0;
-
-    TickType_t tLastWake = xTaskGetTickCount();
-
     while (true)
     {
-        // ボタンの状態を取得
-        bool reading = digitalRead(SW_SEL_IN);
-
-        // デバウンス検出用
-        if (reading != lastPhysState) {
-            tLastDebounce = millis();
+        // イベント待ち（ボタンを操作していない間はCPUを使わない）
+        if (!gButton.wait(event)) {
+            continue;
         }
 
-        // ボタンイベントあり
-        if ((millis() - tLastDebounce) > SW_DEBOUNCE_MS) {
-            // ボタン状態の変化あり
-            if (reading != btnState) {
-                btnState = reading;
-
-                // ボタン押下
-                if (btnState == LOW) {
-                    tPressStart = millis();   // 押下開始
-                    longPressFired = false;
-                }
-                else if (!longPressFired) {
-                    // オートモードにおいて、BBPを接続しているとき
-                    if (ATLAS.isAutoMode()) {
-                        if (ATLAS.state.isBBPReady()) {
-                            ATLAS.state.nextPageA();
-                            ATLAS.view.autoModeStandby();
-                        }
-                    }
-                    // マニュアルモードにおいて
-                    else {
-                        ATLAS.state.nextPageM();
-                        ATLAS.view.manualModeStandby();
-                    }
+        switch (event) {
+        case shark::ButtonEvent::CLICK:
+            // オートモードにおいて、BBPを接続しているとき
+            if (ATLAS.isAutoMode()) {
+                if (ATLAS.state.isBBPReady()) {
+                    ATLAS.state.nextPageA();
+                    ATLAS.view.autoModeStandby();
                 }
             }
-        }
-        lastPhysState = reading;
-
-        // 長押し判定
-        if (btnState == LOW  &&    // ボタン押下状態
-            !longPressFired &&     // 長押しが決定していない状態
-            ((millis() - tPressStart) > SW_LONGPRESS_MS)   // 長押し時間超過
-        ) {
+            // マニュアルモードにおいて
+            else {
+                ATLAS.state.nextPageM();
+                ATLAS.view.manualModeStandby();
+            }
+            break;
+        case shark::ButtonEvent::LONG_PRESS:
             // モード切り替え
             ATLAS.switchMode();
-
-            // 後処理
-            longPressFired = true;
+            break;
+        default:
+            break;
         }
-
-        vTaskDelayUntil(&tLastWake, pdMS_TO_TICKS(SW_POLL_INTERVAL_MS));
     }
 
 //-----------------------------------------------------------------------------
 #elif SWITCH_TYPE == SW_SLIDE // スライドスイッチを使う場合
 //-----------------------------------------------------------------------------
 
-    // スイッチの出力用設定
-    pinMode(SW_SEL_OUT, OUTPUT);
-    digitalWrite(SW_SEL_OUT, HIGH);
-    
+    // スイッチの入力がHIGH（開）ならオートモード
+    ATLAS.setMode(!gButton.isPressed());
+
     while (true) {
-        ATLAS.setMode(digitalRead(SW_SEL_IN) == 1);
-        delay(100);   // 100ms間隔でチェック
+        // 状態が変わったときだけ反映する
+        if (gButton.wait(event)) {
+            ATLAS.setMode(!gButton.isPressed());
+        }
     }
 
 //-----------------------------------------------------------------------------
 #endif
 //-----------------------------------------------------------------------------
-
-    // タスク終了処理
-    vTaskDelete(nullptr);
 }
 
 //=============================================================================
@@ -132,61 +205,62 @@ AtlasManager::AtlasManager()
 
 void AtlasManager::setup()
 {
+    this->boot.mark(BootStage::SETUP);
+
 #if BUILD_TYPE != BUILD_RELEASE
     // シリアル通信開始
     Serial.begin(9600);
     while (!Serial);
 #endif
 
+#if ATLAS_TRACE
+    // トレースの開始（シリアルを開いた後）
+    Trace::begin();
+#endif
+
+    /*
+        遅い初期化は裏のタスクで並行して行う
+
+        - ファイルの読み込み（SPIFFSのマウントを含む）: 最初のモードに必要なので、
+          ロゴを消す前に待ち合わせる
+        - 音声制御の開始: 待ち合わせない（開始が済むまでは音声なしで動く）
+
+        優先度はこのタスク（loopTask）と同じにして、表示の開始を遅らせない。
+        どちらも終わったらタスクを削除して、スタックをヒープに返す。
+        タスクを作れなければ、ここでそのまま実行する。
+    */
+    gQueueStorage.begin();
+    if (!shark::os::spawn(
+            taskStorage,        // タスク
+            "taskStorage",      // タスク名
+            nullptr,            // 起動パラメータ
+            1,                  // 優先度（値が大きいほど優先順位が高い）
+            STACK_BOOT_TASK     // スタック
+    )) {
+        taskStorage(nullptr);
+    }
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+    if (!shark::os::spawn(taskAudio, "taskAudio", nullptr, 1, STACK_BOOT_TASK)) {
+        taskAudio(nullptr);
+    }
+#endif
+
     // ディスプレイの開始
     if (!this->view.begin(SCREEN_ADDR)) {
         debugMsg(F("failed to start display"));
         while (true);
     }
+    this->boot.mark(BootStage::DISPLAY);
 
     // さめ大臣ロゴ
     this->view.splashScreen();
-    TickType_t tLogoBegin = xTaskGetTickCount();
-
-    // SPIFFS開始
-    if (!SPIFFS.begin(true)) {
-        debugMsg(F("failed to mount SPIFFS"));
-        while (true);
-    }
-
-    // 解析結果の読み込み
-    this->result.initialize();
-    if (File file = SPIFFS.open(RESULT_FPATH, "r")) {
-        if (file.size() == sizeof(this->result)) {
-            // ファイルの内容を読み込む
-            readFile(file, this->result);
-            debugMsg(F("read statistics file"));
-        }
-        file.close();
-    }
-
-    // パラメータの読み込み
-    this->params.initialize();
-    if (File file = SPIFFS.open(PARAMS_FPATH, "r")) {
-        if (file.size() == sizeof(this->params)) {
-            // ファイルの内容を読み込む
-            readFile(file, this->params);
-            debugMsg(F("read parameter file"));
-        }
-        file.close();
-    }
-    this->params.regulate();
+    std::uint32_t tLogoBegin = shark::os::millis();
+    this->boot.mark(BootStage::SPLASH);
 
 //-----------------------------------------------------------------------------
 #if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
 //-----------------------------------------------------------------------------
 
-    // 音声制御の開始
-    if (!this->player.begin(Serial1, 9600, AUDIO_RX, AUDIO_TX)) {
-        debugMsg(F("failed to start audio player"));
-    }
-    this->player.setVolume(DEFAULT_VOLUME);
-    
     // モーター制御インスタンスの設定
     this->motors[0].configure(
         MOTOR1_PWM_L,
@@ -202,52 +276,72 @@ void AtlasManager::setup()
         MOTOR2_MAX_RPM
     );
 #endif
+    for (auto& motor : this->motors) {
+        motor.setRamp(
+            static_cast<shark::RampCurve>(MOTOR_RAMP_CURVE),
+            MOTOR_RAMP_STEP_MS
+        );
+    }
+    this->boot.mark(BootStage::MOTORS);
 
 //-----------------------------------------------------------------------------
 #endif
 //-----------------------------------------------------------------------------
 
-    // スイッチ用のピン設定（内蔵プルアップ抵抗を使う）
-    pinMode(SW_SEL_IN, INPUT_PULLUP);
+    // ファイルの読み込みを待つ（以降はパラメータ・解析結果・SP較正を使う）
+    bool mounted = false;
+    gQueueStorage.receive(mounted);
+    if (!mounted) {
+        debugMsg(F("failed to mount SPIFFS"));
+        while (true);
+    }
+
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+    // 射出シーケンサーの起動
+    this->launcher.begin();
+#endif
+
+//-----------------------------------------------------------------------------
+#if SWITCH_TYPE != SW_NONE // スイッチを使う場合
+//-----------------------------------------------------------------------------
+
+#if SWITCH_TYPE == SW_SLIDE
+    // スライドスイッチの出力用設定
+    pinMode(SW_SEL_OUT, OUTPUT);
+    digitalWrite(SW_SEL_OUT, HIGH);
+#endif
+
+    // スイッチ入力の開始（GPIO割り込み、内蔵プルアップ抵抗を使う）
+    if (!gButton.begin(SW_SEL_IN, SW_DEBOUNCE_MS, SW_LONGPRESS_MS)) {
+        debugMsg(F("failed to start switch"));
+    }
 
     // スイッチの入力を監視するタスクの生成・投入
-    xTaskCreate(
+    gTaskSwitch.start(
         taskSwitchMonitor,  // タスク
         "taskSwitch",       // タスク名
-        2048,               // スタックメモリ
         nullptr,            // 起動パラメータ
-        1,                  // 優先度（値が大きいほど優先順位が高い）
-        nullptr             // タスクハンドル
+        1                   // 優先度（値が大きいほど優先順位が高い）
     );
+    this->boot.mark(BootStage::SWITCH);
 
-    // スプラッシュスクリーン表示限度まで待機実行
-    vTaskDelayUntil(&tLogoBegin, pdMS_TO_TICKS(1500));
-}
-
-void AtlasManager::setMode(bool isAutoMode)
-{
-    shark::Lock lock(_mutexMode);
-    _isAutoMode = isAutoMode;
-}
-
-// オートモードかどうかを返す
-bool AtlasManager::isAutoMode() const
-{
-    shark::Lock lock(_mutexMode);
-    return _isAutoMode;
-}
+//-----------------------------------------------------------------------------
+#endif
+//-----------------------------------------------------------------------------
 
-// マニュアルモードかどうかを返す
-bool AtlasManager::isManualMode() const
-{
-    shark::Lock lock(_mutexMode);
-    return !_isAutoMode;
+    // スプラッシュスクリーンの最短の表示時間まで待機（0なら待たない）
+    if (SPLASH_MIN_MS > 0) {
+        shark::os::delayUntil(tLogoBegin, SPLASH_MIN_MS);
+    }
+    this->boot.mark(BootStage::READY);
+    this->boot.print();
 }
 
-void AtlasManager::switchMode()
+void AtlasManager::switchMode() noexcept
 {
-    shark::Lock lock(_mutexMode);
-    _isAutoMode = !_isAutoMode;
+    // 他のタスクの setMode() と競合しても、反転を取りこぼさない
+    bool current = _isAutoMode.load();
+    while (!_isAutoMode.compare_exchange_weak(current, !current));
 }
 
 const Statistics& AtlasManager::statistics() const noexcept
@@ -263,6 +357,9 @@ const Statistics& AtlasManager::statistics() const noexcept
 
 void AtlasManager::run()
 {
+    // モード遷移時のヒープ使用状況の記録
+    this->heap.record();
+
     this->isAutoMode() ? runAutoMode() : runManualMode();
 }
 
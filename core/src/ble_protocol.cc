@@ -0,0 +1,247 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "ble_protocol.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min
+#include <cctype>       // std::toupper
+#include <cstdint>      // UINT16_MAX
+#include <cstring>      // std::memcpy
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+using namespace property;
+
+// キャラクタリスティックの定義（並びは Characteristic と同じ）
+constexpr CharacteristicSpec CHARACTERISTICS[] = {
+#define ATLAS_CHARACTERISTIC_SPEC(name, uuid, props) \
+    {Characteristic::name, #name, uuid, props},
+    ATLAS_CHARACTERISTICS(ATLAS_CHARACTERISTIC_SPEC)
+#undef ATLAS_CHARACTERISTIC_SPEC
+};
+
+static_assert(sizeof(CHARACTERISTICS) / sizeof(CHARACTERISTICS[0]) ==
+              static_cast<std::size_t>(Characteristic::NUM_CHARACTERISTICS),
+              "CHARACTERISTICS does not match 'Characteristic'");
+
+// 大文字・小文字を問わずに比べる
+bool equalsIgnoreCase(const char* a, const char* b)
+{
+    for (; *a && *b; ++a, ++b) {
+        if (std::toupper(static_cast<unsigned char>(*a)) !=
+            std::toupper(static_cast<unsigned char>(*b))) {
+            return false;
+        }
+    }
+    return *a == *b;
+}
+
+} // namespace
+
+//=============================================================================
+// キャラクタリスティック
+//=============================================================================
+
+const CharacteristicSpec& characteristicSpec(Characteristic chr) noexcept
+{
+    return CHARACTERISTICS[static_cast<std::size_t>(chr)];
+}
+
+const CharacteristicSpec* findCharacteristic(const char* uuid) noexcept
+{
+    for (const auto& spec : CHARACTERISTICS) {
+        if (equalsIgnoreCase(spec.uuid, uuid)) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+//=============================================================================
+// RawCtrlCommand
+//=============================================================================
+
+RawCtrlCommand RawCtrlCommand::decode(const std::uint8_t* data, std::size_t size) noexcept
+{
+    RawCtrlCommand cmd {Type::INVALID, 0, 0};
+    if (size == 0) {
+        return cmd;
+    }
+
+    if (size == 2) {
+        cmd.type = Type::ACK;
+        cmd.seq = static_cast<std::uint16_t>(data[0]) |
+                  static_cast<std::uint16_t>(data[1]) << 8;
+    }
+    else if (size == 5 && data[0] == RESUME_CODE) {
+        cmd.type = Type::RESUME;
+        cmd.offset = static_cast<std::uint32_t>(data[1])       |
+                     static_cast<std::uint32_t>(data[2]) << 8  |
+                     static_cast<std::uint32_t>(data[3]) << 16 |
+                     static_cast<std::uint32_t>(data[4]) << 24;
+    }
+    else {
+        // 従来どおり、それ以外の書き込みはすべて転送開始
+        cmd.type = Type::START;
+    }
+    return cmd;
+}
+
+std::size_t RawCtrlCommand::encode(std::uint8_t* data) const noexcept
+{
+    switch (this->type) {
+    case Type::START:
+        data[0] = 0x01;
+        return 1;
+    case Type::ACK:
+        data[0] = this->seq & 0xff;
+        data[1] = this->seq >> 8;
+        return 2;
+    case Type::RESUME:
+        data[0] = RESUME_CODE;
+        data[1] = this->offset & 0xff;
+        data[2] = (this->offset >> 8) & 0xff;
+        data[3] = (this->offset >> 16) & 0xff;
+        data[4] = this->offset >> 24;
+        return 5;
+    default:
+        return 0;
+    }
+}
+
+//=============================================================================
+// RawSender
+//=============================================================================
+
+RawSender::Outcome RawSender::run(Port& port, std::uint32_t size, std::uint16_t payloadSize)
+{
+    std::uint8_t buf[RAW_HEADER_SIZE + RAW_MAX_PAYLOAD];
+    payloadSize = std::min(payloadSize, RAW_MAX_PAYLOAD);
+
+    // シーケンス番号は16ビットなので、それを超える分はクライアントの再開コマンドで送る
+    const auto numPackets = static_cast<std::uint16_t>(
+        std::min<std::uint32_t>(rawNumPackets(size, payloadSize), UINT16_MAX));
+    std::uint32_t remaining = size;
+
+    // シーケンス番号
+    std::uint16_t seq = 0;
+    std::uint16_t lastAck = 0;  // 次にACKされるべき位置
+
+    // 結果（ACKされたバイト数は、最後の通知だけが短い）
+    auto outcome = [&seq, &lastAck, size, payloadSize](Status status) {
+        const auto bytes = std::min<std::uint32_t>(lastAck * payloadSize, size);
+        return Outcome {status, seq, lastAck, bytes};
+    };
+
+    while (lastAck < numPackets) {
+        // ウィンドウ分送信
+        while (seq < lastAck + RAW_WINDOW_SIZE && seq < numPackets) {
+            // データをバッファに読み込む
+            const std::size_t length = port.read(
+                buf + RAW_HEADER_SIZE, std::min<std::uint32_t>(payloadSize, remaining));
+            if (length == 0) {
+                return outcome(Status::READ_ERROR);
+            }
+            remaining -= length;
+
+            // SEQ付与
+            buf[0] = seq & 0xff;
+            buf[1] = seq >> 8;
+
+            // 送信（送信バッファが空くのを待つ間に、切断や中断を確認する）
+            while (!port.notify(buf, length + RAW_HEADER_SIZE)) {
+                if (port.aborted()) {
+                    return outcome(Status::ABORTED);
+                }
+                port.waitTxSpace();
+            }
+
+            seq += 1;
+        }
+
+        // ACK待ち
+        const bool signaled = port.waitAck(RAW_ACK_TIMEOUT);
+
+        // ACK反映（送っていない位置のACKは無視する）
+        const std::uint16_t prevAck = lastAck;
+        std::uint16_t ack;
+        while (port.takeAck(ack)) {
+            if (ack >= lastAck && ack < seq) {
+                lastAck = ack + 1;
+            }
+        }
+        port.acked(lastAck, numPackets);
+
+        // 中断チェック
+        if (port.aborted()) {
+            return outcome(Status::ABORTED);
+        }
+        if (!signaled && lastAck == prevAck) {
+            return outcome(Status::TIMEOUT);
+        }
+    }
+    return outcome(Status::DONE);
+}
+
+//=============================================================================
+// RawTransferReport
+//=============================================================================
+
+void RawTransferReport::clear() noexcept
+{
+    *this = RawTransferReport {};
+    this->status = static_cast<std::uint8_t>(RawSender::Status::NONE);
+}
+
+void RawTransferReport::record(const RawSender::Outcome& outcome, std::uint32_t elapsedMs) noexcept
+{
+    this->bytes = outcome.bytes;
+    this->elapsed = elapsedMs;
+    this->goodput = elapsedMs > 0
+        ? static_cast<std::uint32_t>(1000ULL * outcome.bytes / elapsedMs)
+        : 0;
+    this->packets = outcome.sent;
+    this->status = static_cast<std::uint8_t>(outcome.status);
+}
+
+//=============================================================================
+// RawReceiver
+//=============================================================================
+
+void RawReceiver::begin(std::uint8_t* buffer, std::uint32_t size, std::uint32_t offset) noexcept
+{
+    _buffer = buffer;
+    _size = size;
+    _received = std::min(offset, size);
+    _nextSeq = 0;
+}
+
+RawReceiver::Event RawReceiver::onPacket(const std::uint8_t* data, std::size_t size) noexcept
+{
+    if (size < RAW_HEADER_SIZE) {
+        return Event::INVALID;
+    }
+    const std::uint16_t seq = static_cast<std::uint16_t>(data[0]) |
+                              static_cast<std::uint16_t>(data[1]) << 8;
+    const std::size_t length = size - RAW_HEADER_SIZE;
+    if (seq != _nextSeq || length > _size - _received) {
+        return Event::INVALID;
+    }
+
+    std::memcpy(_buffer + _received, data + RAW_HEADER_SIZE, length);
+    _received += static_cast<std::uint32_t>(length);
+    _nextSeq += 1;
+
+    if (this->done()) {
+        return Event::DONE;
+    }
+    return (_nextSeq % RAW_WINDOW_SIZE == 0) ? Event::ACK : Event::NONE;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -0,0 +1,83 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "boot_profile.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+
+// Arduino
+#include <Arduino.h>    // Serial
+
+// shark lib
+#include "os.hh"
+
+// ATLAS
+#include "utils.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+#if BUILD_TYPE != BUILD_RELEASE
+namespace {
+
+//! 段階の説明
+const char* const STAGE_LABELS[] = {
+#define ATLAS_BOOT_STAGE_LABEL(name, label) label,
+    ATLAS_BOOT_STAGES(ATLAS_BOOT_STAGE_LABEL)
+#undef ATLAS_BOOT_STAGE_LABEL
+};
+
+} // namespace
+#endif
+
+void BootProfile::mark(BootStage stage, bool ok) noexcept
+{
+    const auto index = static_cast<std::uint8_t>(stage);
+
+    // 0は未到達の印なので、最小でも1にする
+    const auto stamp = std::max<std::uint32_t>(static_cast<std::uint32_t>(shark::os::now()), 1);
+    std::uint32_t expected = 0;
+    if (!_stamps[index].compare_exchange_strong(expected, stamp)) {
+        return;
+    }
+    if (!ok) {
+        _failed.fetch_or(static_cast<std::uint16_t>(1U << index));
+    }
+}
+
+void BootProfile::print() const noexcept
+{
+#if BUILD_TYPE != BUILD_RELEASE
+    const BootReport report = this->report();
+    for (std::uint8_t i = 0; i < BootReport::NUM_STAGES; ++i) {
+        if (report.stamps[i] == 0) {
+            Serial.printf("boot: %s pending\n", STAGE_LABELS[i]);
+            continue;
+        }
+        Serial.printf("boot: %s at %lu us%s\n", STAGE_LABELS[i],
+                      static_cast<unsigned long>(report.stamps[i]),
+                      (report.failed & (1U << i)) ? " (failed)" : "");
+    }
+#endif
+}
+
+bool BootProfile::reached(BootStage stage) const noexcept
+{
+    return _stamps[static_cast<std::uint8_t>(stage)].load() != 0;
+}
+
+BootReport BootProfile::report() const noexcept
+{
+    BootReport report {};
+    report.numStages = BootReport::NUM_STAGES;
+    report.failed = _failed.load();
+    for (std::uint8_t i = 0; i < BootReport::NUM_STAGES; ++i) {
+        report.stamps[i] = _stamps[i].load();
+    }
+    return report;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -0,0 +1,47 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "heap_monitor.hh"
+
+// Arduino
+#include <Arduino.h>    // ESP
+
+// ATLAS
+#include "utils.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+HeapSnapshot HeapSnapshot::now() noexcept
+{
+    return HeapSnapshot {
+        .freeHeap     = ESP.getFreeHeap(),
+        .minFreeHeap  = ESP.getMinFreeHeap(),
+        .largestBlock = ESP.getMaxAllocHeap()
+    };
+}
+
+void HeapMonitor::record() noexcept
+{
+    auto snapshot = HeapSnapshot::now();
+    _report.history[_report.transitions % HeapReport::HISTORY_SIZE] = snapshot;
+    _report.transitions += 1;
+
+#if BUILD_TYPE != BUILD_RELEASE
+    Serial.printf("heap: free %lu, min %lu, largest %lu\n",
+                  static_cast<unsigned long>(snapshot.freeHeap),
+                  static_cast<unsigned long>(snapshot.minFreeHeap),
+                  static_cast<unsigned long>(snapshot.largestBlock));
+#endif
+}
+
+HeapReport HeapMonitor::report() const noexcept
+{
+    HeapReport report = _report;
+    report.current = HeapSnapshot::now();
+    return report;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -10,43 +10,6 @@ namespace img
 {
 //-----------------------------------------------------------------------------
 
-//! さめ大臣ロゴ, 76x52px
-const std::uint8_t sharkMinisterLogo[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x0f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0x00, 0x03, 0x80, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x30, 0x00, 0xf8, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x00, 0x06, 
-    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x3e, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x18, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x06, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x1f, 
-    0x80, 0x00, 0x01, 0x80, 0x00, 0x07, 0x00, 0x00, 0x00, 0x1f, 0xc0, 0x00, 0x00, 0x60, 0x00, 0x02, 
-    0x00, 0x00, 0x00, 0x0f, 0xe0, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0xe0, 0x00, 
-    0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xf1, 0x40, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 
-    0x40, 0x09, 0xf9, 0x04, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0xe0, 0x08, 0x7d, 0x8c, 0x04, 0x00, 
-    0x10, 0x00, 0x7f, 0xe0, 0x40, 0x04, 0x7c, 0xf8, 0x0e, 0x00, 0x0c, 0x07, 0x80, 0x10, 0x00, 0x04, 
-    0x1e, 0x00, 0x04, 0x00, 0x02, 0x18, 0x00, 0x20, 0x00, 0x04, 0x1e, 0x00, 0x00, 0x00, 0x01, 0x20, 
-    0x00, 0x40, 0x00, 0x03, 0x07, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x80, 0x00, 0x03, 0x83, 0x80, 
-    0x00, 0x00, 0x01, 0x00, 0x00, 0x80, 0x00, 0x01, 0xe1, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 
-    0x00, 0x00, 0xff, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xff, 0xe0, 0x80, 0x00, 
-    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x7f, 0xf1, 0x20, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 
-    0x7f, 0xfa, 0x40, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x3f, 0xf8, 0x90, 0x00, 0x00, 0x00, 
-    0x04, 0x00, 0x00, 0x00, 0x1f, 0xf6, 0x20, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x0f, 0xed, 
-    0x40, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x00, 0x07, 0xfb, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 
-    0x0e, 0x00, 0x07, 0xfe, 0xc0, 0x00, 0x00, 0x00, 0x10, 0x00, 0x3f, 0x80, 0x03, 0xfd, 0xc0, 0x00, 
-    0x00, 0x00, 0x10, 0x00, 0x0e, 0x00, 0x01, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x10, 0x00, 0x04, 0x00, 
-    0x00, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x10, 0x00, 0x04, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 
-    0x10, 0x00, 0x00, 0x00, 0x00, 0x3f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x1c, 0xe0, 0x0e, 
-    0x01, 0xff, 0xc0, 0x00, 0x00, 0x3f, 0xfc, 0x7f, 0xf8, 0x0e, 0x01, 0xff, 0xc0, 0x00, 0x00, 0x3f, 
-    0xfc, 0x7f, 0xf8, 0xff, 0xf1, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x70, 0x7f, 0xf8, 0xff, 0xf1, 0xff, 
-    0x80, 0x00, 0x00, 0x00, 0x30, 0x6d, 0x98, 0x1e, 0x01, 0xff, 0x80, 0x00, 0x00, 0x00, 0x30, 0x6d, 
-    0x98, 0x1f, 0x01, 0x81, 0x80, 0x00, 0x00, 0x00, 0x00, 0x6d, 0x98, 0x3b, 0x81, 0xff, 0x80, 0x00, 
-    0x00, 0x18, 0x00, 0x6f, 0x18, 0x31, 0xc1, 0xff, 0x80, 0x00, 0x00, 0x18, 0x00, 0x7f, 0x18, 0x60, 
-    0xe1, 0x8c, 0x00, 0x00, 0x00, 0x0f, 0xf8, 0x3e, 0xf8, 0xe0, 0x71, 0xff, 0xc0, 0x00, 0x00, 0x0f, 
-    0xf8, 0x1c, 0x70, 0xc0, 0x31, 0xff, 0xc0, 0x00
-};
-
 //! オートモードでのベイバトルパスの接続を促すメッセージ, 119x22px
 const std::uint8_t promotion_BBP[] PROGMEM = {
 	0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x20, 0x20, 0x00, 0x80, 0x00, 0x00, 0x01, 
@@ -156,84 +119,6 @@ const std::uint8_t crcError [] PROGMEM = {
 	0x2a, 0x81, 0x12, 0x24, 0x00, 0xf9, 0x30, 0x1e, 0x7c, 0xf7, 0xc0, 0x20, 0xe1, 0xca, 0x81, 0xe3, 
 	0xc4, 0x00
 };
-// 'ELR_Canceled', 92x26px
-const std::uint8_t elrCanceled [] PROGMEM = {
-	0x00, 0x00, 0x00, 0x7a, 0x1e, 0x00, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 
-	0x12, 0x00, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x12, 0x0f, 0x7b, 0xde, 
-	0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7a, 0x1e, 0x08, 0x4a, 0x52, 0x40, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x42, 0x14, 0x0f, 0x4a, 0x52, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 
-	0x12, 0x01, 0x4a, 0x52, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xd1, 0x0f, 0x4b, 0xde, 
-	0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x1f, 0x81, 0xe0, 0xf1, 0x83, 0xf1, 0xff, 0x9c, 0x03, 0xff, 0x3f, 0x80, 0x3f, 0xc1, 0xe0, 0xf1, 
-	0x87, 0xf9, 0xff, 0x9c, 0x03, 0xff, 0x3f, 0xc0, 0x70, 0x01, 0xe0, 0xf9, 0x8e, 0x01, 0xc0, 0x1c, 
-	0x03, 0x80, 0x38, 0xe0, 0xe0, 0x03, 0xe0, 0xf9, 0x9c, 0x01, 0xc0, 0x1c, 0x03, 0x80, 0x38, 0x70, 
-	0xe0, 0x03, 0x70, 0xf9, 0x9c, 0x01, 0xc0, 0x1c, 0x03, 0x80, 0x38, 0x70, 0xc0, 0x03, 0x70, 0xe9, 
-	0x98, 0x01, 0xc0, 0x1c, 0x03, 0x80, 0x38, 0x70, 0xc0, 0x07, 0x30, 0xed, 0x98, 0x01, 0xfe, 0x1c, 
-	0x03, 0xfc, 0x38, 0x30, 0xc0, 0x06, 0x38, 0xed, 0x98, 0x01, 0xfe, 0x1c, 0x03, 0xfc, 0x38, 0x30, 
-	0xc0, 0x06, 0x38, 0xed, 0x98, 0x01, 0xc0, 0x1c, 0x03, 0x80, 0x38, 0x70, 0xe0, 0x07, 0xf8, 0xe5, 
-	0x9c, 0x01, 0xc0, 0x1c, 0x03, 0x80, 0x38, 0x70, 0xe0, 0x0f, 0xf8, 0xe5, 0x9c, 0x01, 0xc0, 0x1c, 
-	0x03, 0x80, 0x38, 0x70, 0x70, 0x0e, 0x1c, 0xe7, 0x8e, 0x01, 0xc0, 0x1c, 0x03, 0x80, 0x38, 0xe0, 
-	0x3f, 0xcc, 0x1c, 0xe7, 0x87, 0xf9, 0xff, 0x9f, 0xfb, 0xff, 0x3f, 0xc0, 0x1f, 0xdc, 0x0c, 0xe7, 
-	0x83, 0xf9, 0xff, 0x9f, 0xfb, 0xff, 0x3f, 0x80
-};
-
-//! カウントダウン用'Go-', 50x21px
-const std::uint8_t cndGo[] PROGMEM = {
-    0x03, 0xf8, 0x01, 0xf8, 0x00, 0x00, 0x00, 0x0f, 0xfc, 0x07, 0xfe, 0x00, 0x00, 0x00, 0x3f, 0xfe, 
-    0x0f, 0xff, 0x00, 0x00, 0x00, 0x3f, 0xfe, 0x1f, 0xff, 0x00, 0x00, 0x00, 0x7e, 0x0c, 0x1f, 0x0f, 
-    0x80, 0x00, 0x00, 0x78, 0x00, 0x3e, 0x07, 0x80, 0x00, 0x00, 0xf8, 0x00, 0x3e, 0x07, 0x80, 0x00, 
-    0x00, 0xf0, 0x00, 0x3c, 0x07, 0xc0, 0x00, 0x00, 0xf0, 0x00, 0x3c, 0x03, 0xc0, 0x00, 0x00, 0xf0, 
-    0x00, 0x3c, 0x03, 0xdf, 0xff, 0xc0, 0xf0, 0xfe, 0x3c, 0x03, 0xdf, 0xff, 0xc0, 0xf0, 0xfe, 0x3c, 
-    0x03, 0xdf, 0xff, 0xc0, 0xf0, 0xfe, 0x3c, 0x03, 0xdf, 0xff, 0xc0, 0xf0, 0xfe, 0x3c, 0x07, 0xc0, 
-    0x00, 0x00, 0xf8, 0x1e, 0x3c, 0x07, 0x80, 0x00, 0x00, 0xf8, 0x1e, 0x3e, 0x07, 0x80, 0x00, 0x00, 
-    0x7e, 0x1e, 0x1f, 0x0f, 0x80, 0x00, 0x00, 0x7f, 0xfe, 0x1f, 0xff, 0x00, 0x00, 0x00, 0x3f, 0xfe, 
-    0x0f, 0xff, 0x00, 0x00, 0x00, 0x1f, 0xfe, 0x07, 0xfe, 0x00, 0x00, 0x00, 0x03, 0xfc, 0x01, 0xf8, 
-    0x00, 0x00, 0x00
-};
-
-//! カウントダウン用'Ready Set', 57x29px
-const std::uint8_t cndReadyset[] PROGMEM = {
-    0xfe, 0x0f, 0xf0, 0x70, 0x3f, 0xc3, 0x83, 0x80, 0xff, 0x0f, 0xf0, 0xf0, 0x3f, 0xf1, 0xc7, 0x00, 
-    0xff, 0x8f, 0xf0, 0xf8, 0x3f, 0xf9, 0xc7, 0x00, 0xe3, 0x8e, 0x01, 0xf8, 0x38, 0x38, 0xee, 0x00, 
-    0xe3, 0x8e, 0x01, 0xd8, 0x38, 0x1c, 0x6c, 0x00, 0xff, 0x0f, 0xe1, 0x9c, 0x38, 0x1c, 0x7c, 0x00, 
-    0xfe, 0x0f, 0xe3, 0x9c, 0x38, 0x1c, 0x38, 0x00, 0xfe, 0x0f, 0xe3, 0xfc, 0x38, 0x1c, 0x38, 0x00, 
-    0xe7, 0x0e, 0x03, 0xfe, 0x38, 0x1c, 0x38, 0x00, 0xe3, 0x8e, 0x07, 0xfe, 0x38, 0x38, 0x38, 0x00, 
-    0xe3, 0x8f, 0xf7, 0x07, 0x3f, 0xf8, 0x38, 0x00, 0xe3, 0x8f, 0xfe, 0x07, 0x3f, 0xf0, 0x38, 0x00, 
-    0xe1, 0x8f, 0xfe, 0x07, 0xbf, 0xc0, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x7c, 0xff, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0x7f, 0xc0, 0x00, 0x00, 
-    0x00, 0x01, 0xfe, 0xff, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x01, 0xc2, 0xe0, 0x0e, 0x00, 0x00, 0x00, 
-    0x00, 0x01, 0xc0, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xfe, 0x0e, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0xfc, 0xfe, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0xfe, 0x0e, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x0e, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0e, 0xe0, 0x0e, 0x00, 0x00, 0x00, 
-    0x00, 0x01, 0xfe, 0xff, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x01, 0xfc, 0xff, 0x0e, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0xf8, 0xff, 0x0e, 0x00, 0x00, 0x00
-};
-
-//! カウントダウン用'Shoot!', 97x21px
-const std::uint8_t cndShoot[] PROGMEM = {
-    0x0f, 0xc0, 0x3c, 0x0f, 0x01, 0xf8, 0x00, 0x7e, 0x03, 0xff, 0xfc, 0x07, 0x80, 0x3f, 0xf0, 0x3c, 
-    0x0f, 0x07, 0xfe, 0x01, 0xff, 0x83, 0xff, 0xfc, 0x07, 0x80, 0x7f, 0xfc, 0x3c, 0x0f, 0x0f, 0xff, 
-    0x03, 0xff, 0xc3, 0xff, 0xfc, 0x07, 0x80, 0x7f, 0xf8, 0x3c, 0x0f, 0x1f, 0xff, 0x07, 0xff, 0xc3, 
-    0xff, 0xfc, 0x07, 0x80, 0xf8, 0x70, 0x3c, 0x0f, 0x1f, 0x0f, 0x87, 0xc3, 0xe0, 0x0f, 0x00, 0x07, 
-    0x80, 0xf0, 0x00, 0x3c, 0x0f, 0x3e, 0x07, 0x8f, 0x81, 0xe0, 0x0f, 0x00, 0x07, 0x80, 0xf8, 0x00, 
-    0x3c, 0x0f, 0x3e, 0x07, 0x8f, 0x81, 0xe0, 0x0f, 0x00, 0x07, 0x80, 0x78, 0x00, 0x3c, 0x0f, 0x3c, 
-    0x07, 0xcf, 0x01, 0xf0, 0x0f, 0x00, 0x07, 0x80, 0x7e, 0x00, 0x3f, 0xff, 0x3c, 0x03, 0xcf, 0x00, 
-    0xf0, 0x0f, 0x00, 0x07, 0x80, 0x3f, 0x80, 0x3f, 0xff, 0x3c, 0x03, 0xcf, 0x00, 0xf0, 0x0f, 0x00, 
-    0x07, 0x80, 0x1f, 0xe0, 0x3f, 0xff, 0x3c, 0x03, 0xcf, 0x00, 0xf0, 0x0f, 0x00, 0x07, 0x80, 0x0f, 
-    0xf0, 0x3f, 0xff, 0x3c, 0x03, 0xcf, 0x00, 0xf0, 0x0f, 0x00, 0x07, 0x80, 0x01, 0xf8, 0x3c, 0x0f, 
-    0x3c, 0x03, 0xcf, 0x00, 0xf0, 0x0f, 0x00, 0x07, 0x80, 0x00, 0xf8, 0x3c, 0x0f, 0x3c, 0x07, 0xcf, 
-    0x01, 0xf0, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x3c, 0x0f, 0x3c, 0x07, 0x8f, 0x01, 0xe0, 0x0f, 
-    0x00, 0x00, 0x00, 0x00, 0x3c, 0x3c, 0x0f, 0x3e, 0x07, 0x8f, 0x81, 0xe0, 0x0f, 0x00, 0x00, 0x00, 
-    0xe0, 0x7c, 0x3c, 0x0f, 0x1f, 0x0f, 0x87, 0xc3, 0xe0, 0x0f, 0x00, 0x07, 0x00, 0xff, 0xf8, 0x3c, 
-    0x0f, 0x1f, 0xff, 0x07, 0xff, 0xc0, 0x0f, 0x00, 0x0f, 0x80, 0xff, 0xf8, 0x3c, 0x0f, 0x0f, 0xff, 
-    0x03, 0xff, 0xc0, 0x0f, 0x00, 0x0f, 0x80, 0xff, 0xf0, 0x3c, 0x0f, 0x07, 0xfe, 0x01, 0xff, 0x80, 
-    0x0f, 0x00, 0x0f, 0x80, 0x3f, 0xc0, 0x3c, 0x0f, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x0f, 0x00, 0x07, 
-    0x00
-};
 
 //-----------------------------------------------------------------------------
 } // namespace img
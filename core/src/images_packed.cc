@@ -0,0 +1,110 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    tools/image_pack で core/assets/images のPBMから生成したファイル。
+    直接編集せず、画像を変えて生成し直すこと（tools/README.md）。
+*/
+#include "images.hh"
+
+namespace atlas {
+namespace img {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// 50x21px, 147 -> 97 bytes
+const std::uint8_t cndGoData[] PROGMEM = {
+    0x01, 0xc0, 0xf0, 0xff, 0xfc, 0x02, 0x7e, 0x1e, 0x1f, 0xfc, 0x0f, 0x02, 0x1f, 0x1e, 0x0c, 0xfe,
+    0x00, 0x05, 0xe0, 0xf8, 0xfc, 0xfe, 0x7e, 0x1f, 0xfd, 0x0f, 0x00, 0x1f, 0xff, 0xfe, 0x02, 0xfc,
+    0xf0, 0x80, 0xf1, 0x00, 0xfd, 0xff, 0x00, 0xc0, 0xfe, 0x00, 0xfe, 0x3c, 0xfd, 0xfc, 0xfe, 0x00,
+    0xfd, 0xff, 0x00, 0x80, 0xfb, 0x00, 0x00, 0xe0, 0xfe, 0xff, 0x01, 0x3f, 0x00, 0xf2, 0x1e, 0x02,
+    0x00, 0x03, 0x07, 0xfe, 0x0f, 0x00, 0x1f, 0xfd, 0x1e, 0xfe, 0x1f, 0x00, 0x0f, 0xfd, 0x00, 0x01,
+    0x03, 0x07, 0xff, 0x0f, 0x00, 0x1f, 0xfd, 0x1e, 0x00, 0x1f, 0xff, 0x0f, 0x01, 0x07, 0x01, 0xf0,
+    0x00
+};
+
+// 57x29px, 232 -> 137 bytes
+const std::uint8_t cndReadysetData[] PROGMEM = {
+    0xfe, 0xff, 0xfe, 0xe7, 0x02, 0xff, 0x3e, 0x1c, 0xfe, 0x00, 0xfe, 0xff, 0xfd, 0xe7, 0x00, 0x07,
+    0xff, 0x00, 0x07, 0xc0, 0xf8, 0xfe, 0x9f, 0x8f, 0xff, 0xfc, 0xe0, 0xfd, 0x00, 0xfe, 0xff, 0xfc,
+    0x07, 0x0e, 0x0e, 0xfe, 0xfc, 0xf0, 0x01, 0x07, 0x0f, 0x3e, 0xf8, 0xe0, 0xf8, 0x3e, 0x0f, 0x07,
+    0x01, 0xfe, 0x1f, 0xff, 0x00, 0x03, 0x01, 0x0f, 0x1f, 0x1e, 0xfe, 0x00, 0xfe, 0x1f, 0xfc, 0x1c,
+    0x03, 0x18, 0x1e, 0x1f, 0x07, 0xfc, 0x03, 0xff, 0x1f, 0x02, 0x1c, 0x10, 0x00, 0xfe, 0x1f, 0xfc,
+    0x1c, 0x03, 0x0e, 0x0f, 0x07, 0x01, 0xfd, 0x00, 0xfe, 0x1f, 0xee, 0x00, 0x02, 0x1c, 0x7e, 0x7f,
+    0xff, 0xe7, 0xff, 0xc7, 0x01, 0x0e, 0x00, 0xfe, 0xff, 0xfd, 0xe7, 0x01, 0x07, 0x00, 0xfe, 0x07,
+    0xfe, 0xff, 0xfe, 0x07, 0xe3, 0x00, 0x00, 0x0e, 0xfd, 0x1c, 0x03, 0x1f, 0x0f, 0x07, 0x00, 0xfe,
+    0x1f, 0xfc, 0x1c, 0xfd, 0x00, 0xfe, 0x1f, 0xef, 0x00
+};
+
+// 97x21px, 273 -> 202 bytes
+const std::uint8_t cndShootData[] PROGMEM = {
+    0x01, 0x70, 0xfc, 0xff, 0xfe, 0x00, 0xdf, 0xfd, 0x0f, 0x00, 0x1f, 0xff, 0x1e, 0x01, 0x0c, 0x04,
+    0xfd, 0x00, 0xfd, 0xff, 0xfb, 0x00, 0xfd, 0xff, 0xff, 0x00, 0x05, 0xe0, 0xf8, 0xfc, 0xfe, 0x7e,
+    0x1f, 0xfd, 0x0f, 0x00, 0x1f, 0xff, 0xfe, 0x02, 0xfc, 0xf0, 0x80, 0xff, 0x00, 0x05, 0xe0, 0xf8,
+    0xfc, 0xfe, 0x7e, 0x1f, 0xfd, 0x0f, 0x00, 0x1f, 0xff, 0xfe, 0x02, 0xfc, 0xf0, 0x80, 0xff, 0x00,
+    0xfb, 0x0f, 0xfd, 0xff, 0xfb, 0x0f, 0xfa, 0x00, 0xfd, 0xff, 0x03, 0x00, 0x01, 0x03, 0x07, 0xfe,
+    0x0f, 0x06, 0x1e, 0x3e, 0x7c, 0xfc, 0xf8, 0xf0, 0xc0, 0xfd, 0x00, 0xfd, 0xff, 0xfb, 0x0f, 0xfd,
+    0xff, 0xff, 0x00, 0xfd, 0xff, 0x00, 0x80, 0xfb, 0x00, 0x00, 0xe0, 0xfe, 0xff, 0x00, 0x3f, 0xff,
+    0x00, 0xfd, 0xff, 0x00, 0x80, 0xfb, 0x00, 0x00, 0xe0, 0xfe, 0xff, 0x00, 0x3f, 0xf9, 0x00, 0xfd,
+    0xff, 0xf4, 0x00, 0xfd, 0x1f, 0xff, 0x0f, 0x00, 0x1f, 0xfb, 0x1e, 0x00, 0x1f, 0xff, 0x0f, 0x01,
+    0x07, 0x01, 0xfd, 0x00, 0xfd, 0x1f, 0xfb, 0x00, 0xfd, 0x1f, 0xfe, 0x00, 0x01, 0x03, 0x07, 0xff,
+    0x0f, 0x00, 0x1f, 0xfd, 0x1e, 0x00, 0x1f, 0xff, 0x0f, 0x01, 0x07, 0x01, 0xfd, 0x00, 0x01, 0x03,
+    0x07, 0xff, 0x0f, 0x00, 0x1f, 0xfd, 0x1e, 0x00, 0x1f, 0xff, 0x0f, 0x01, 0x07, 0x01, 0xf8, 0x00,
+    0xfd, 0x1f, 0xf5, 0x00, 0x00, 0x0e, 0xfe, 0x1f, 0x00, 0x0e
+};
+
+// 92x26px, 312 -> 227 bytes
+const std::uint8_t elrCanceledData[] PROGMEM = {
+    0xe8, 0x00, 0x00, 0x7f, 0xfe, 0x49, 0x01, 0x00, 0x7f, 0xfe, 0x40, 0x05, 0x00, 0x7f, 0x09, 0x19,
+    0x2f, 0x40, 0xfd, 0x00, 0x00, 0x5c, 0xff, 0x54, 0x02, 0x74, 0x00, 0x7f, 0xff, 0x04, 0x02, 0x7c,
+    0x00, 0x7c, 0xff, 0x44, 0x02, 0x7c, 0x00, 0x7c, 0xff, 0x44, 0x03, 0x7c, 0x00, 0x04, 0x7f, 0xff,
+    0x44, 0xe9, 0x00, 0x03, 0x80, 0xc0, 0xe0, 0x70, 0xfc, 0x30, 0x00, 0x20, 0xfd, 0x00, 0x00, 0x80,
+    0xfd, 0xf0, 0xfc, 0x00, 0xfd, 0xf0, 0x00, 0xc0, 0xff, 0x00, 0xff, 0xf0, 0xff, 0x00, 0x03, 0x80,
+    0xc0, 0xe0, 0x70, 0xfc, 0x30, 0x00, 0x20, 0xff, 0x00, 0xfe, 0xf0, 0xfa, 0x30, 0xff, 0x00, 0xfe,
+    0xf0, 0xf9, 0x00, 0xfe, 0xf0, 0xfa, 0x30, 0xff, 0x00, 0xfe, 0xf0, 0xfe, 0x30, 0x07, 0x70, 0xe0,
+    0xc0, 0x80, 0x7f, 0xff, 0xe1, 0x80, 0xf9, 0x00, 0x09, 0xc0, 0xfc, 0xff, 0x67, 0x60, 0x63, 0x7f,
+    0xff, 0xf8, 0x80, 0xff, 0x00, 0xfe, 0xff, 0x03, 0x01, 0x1f, 0xfc, 0x80, 0xff, 0xff, 0xff, 0x00,
+    0x03, 0x7f, 0xff, 0xe1, 0x80, 0xf9, 0x00, 0xfe, 0xff, 0xfc, 0x0c, 0xfd, 0x00, 0xfe, 0xff, 0xf9,
+    0x00, 0xfe, 0xff, 0xfc, 0x0c, 0xfd, 0x00, 0xfe, 0xff, 0xfe, 0x00, 0x03, 0x80, 0xf3, 0xff, 0x7f,
+    0xff, 0x00, 0x00, 0x01, 0xfa, 0x03, 0x01, 0x00, 0x02, 0xff, 0x03, 0xfc, 0x00, 0x00, 0x01, 0xff,
+    0x03, 0xff, 0x00, 0xfe, 0x03, 0xff, 0x00, 0xfd, 0x03, 0xfd, 0x00, 0x00, 0x01, 0xfa, 0x03, 0xff,
+    0x00, 0xf7, 0x03, 0xff, 0x00, 0xf7, 0x03, 0x00, 0x00, 0xf7, 0x03, 0xff, 0x00, 0xfa, 0x03, 0x00,
+    0x01, 0xff, 0x00
+};
+
+// 76x52px, 520 -> 297 bytes
+const std::uint8_t sharkMinisterLogoData[] PROGMEM = {
+    0xf7, 0x00, 0x03, 0xe0, 0xb0, 0xd0, 0x90, 0xf7, 0x10, 0xfc, 0x20, 0xff, 0x40, 0xff, 0x80, 0xfe,
+    0x00, 0xff, 0x08, 0x02, 0x1c, 0x7f, 0x1c, 0xff, 0x08, 0xd6, 0x00, 0x09, 0x07, 0x1f, 0xff, 0x3f,
+    0x7f, 0xfe, 0xf8, 0xf0, 0xe0, 0x80, 0xfe, 0x00, 0x02, 0x80, 0x00, 0x80, 0xfa, 0x00, 0xff, 0x01,
+    0xff, 0x02, 0xff, 0x04, 0xff, 0x08, 0xff, 0x10, 0xff, 0x20, 0xff, 0x40, 0xff, 0x80, 0xf5, 0x00,
+    0x02, 0x08, 0x1c, 0x08, 0xf5, 0x00, 0x02, 0x02, 0x07, 0x02, 0xf8, 0x00, 0x04, 0x03, 0x1c, 0x60,
+    0xe1, 0xc1, 0xff, 0x87, 0xff, 0x1f, 0x04, 0x3e, 0x78, 0xe3, 0xc6, 0x84, 0xff, 0x04, 0x01, 0x06,
+    0x03, 0xfb, 0x00, 0x02, 0x04, 0x0e, 0x04, 0xf7, 0x00, 0xff, 0x01, 0x00, 0x02, 0xff, 0x04, 0x01,
+    0x08, 0x50, 0xff, 0x20, 0x00, 0x10, 0xff, 0x08, 0xfd, 0x04, 0xfb, 0x02, 0x04, 0x82, 0x62, 0x12,
+    0x0a, 0x04, 0xfc, 0x00, 0x00, 0xc0, 0xf7, 0x00, 0x04, 0x03, 0x0f, 0x1f, 0x3f, 0x7f, 0xfb, 0xff,
+    0x08, 0xbc, 0xd8, 0x60, 0xa8, 0xc4, 0x12, 0x48, 0x24, 0x10, 0xe1, 0x00, 0x03, 0xc0, 0x30, 0x0e,
+    0x01, 0xfb, 0x00, 0xff, 0x02, 0x02, 0x07, 0x1f, 0x07, 0xff, 0x02, 0xf5, 0x00, 0x04, 0x01, 0x03,
+    0x07, 0x0f, 0x1f, 0xfd, 0x3f, 0x01, 0x3d, 0x3e, 0xff, 0x3f, 0xe0, 0x00, 0x00, 0x1f, 0xef, 0x00,
+    0xfa, 0x0c, 0x00, 0x1e, 0xff, 0x7e, 0xff, 0x0c, 0xfe, 0x00, 0xff, 0xfc, 0x00, 0x1e, 0xff, 0xfe,
+    0x02, 0x1c, 0xfc, 0xfe, 0xff, 0x1e, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0x18, 0x06, 0x98, 0xf8, 0xfe,
+    0x7e, 0xfe, 0xd8, 0x98, 0xfe, 0x18, 0xfe, 0x00, 0xff, 0xfe, 0xfe, 0xb6, 0xff, 0xbe, 0x00, 0xb6,
+    0xff, 0xf6, 0x00, 0x06, 0xec, 0x00, 0x01, 0x03, 0x0f, 0xf9, 0x0c, 0xfd, 0x00, 0x02, 0x03, 0x07,
+    0x0e, 0xff, 0x0f, 0x02, 0x07, 0x03, 0x04, 0xff, 0x0c, 0x01, 0x0f, 0x07, 0xfe, 0x00, 0x03, 0x0c,
+    0x0e, 0x07, 0x01, 0xfe, 0x00, 0x04, 0x01, 0x03, 0x07, 0x0e, 0x0c, 0xfe, 0x00, 0xff, 0x0f, 0xfe,
+    0x0d, 0xff, 0x0f, 0xfe, 0x0d, 0x00, 0x0c, 0xf7, 0x00
+};
+
+} // namespace
+
+const shark::PackedBitmap cndGo = {cndGoData, sizeof(cndGoData), 50, 21};
+const shark::PackedBitmap cndReadyset = {cndReadysetData, sizeof(cndReadysetData), 57, 29};
+const shark::PackedBitmap cndShoot = {cndShootData, sizeof(cndShootData), 97, 21};
+const shark::PackedBitmap elrCanceled = {elrCanceledData, sizeof(elrCanceledData), 92, 26};
+const shark::PackedBitmap sharkMinisterLogo = {sharkMinisterLogoData, sizeof(sharkMinisterLogoData), 76, 52};
+
+//-----------------------------------------------------------------------------
+} // namespace img
+} // namespace atlas
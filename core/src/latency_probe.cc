@@ -0,0 +1,118 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "latency_probe.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min, std::max, std::copy, std::fill
+#include <cmath>        // std::exp2
+#include <iterator>     // std::begin, std::end
+
+// Arduino
+#include <Arduino.h>    // ESP, getCpuFrequencyMhz
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// 記録は複数のタスク（BLE・描画・射出シーケンサー）から来る。
+// 数十命令で終わるので、ミューテックスではなく短いクリティカルセクションで守る
+portMUX_TYPE gMux = portMUX_INITIALIZER_UNLOCKED;
+
+//! 遅延 [us] のビン番号（floor(log2(us))、0と1は0）
+std::uint8_t bucketOf(std::uint32_t us)
+{
+    std::uint8_t k = 0;
+    while (us > 1 && k < LatencyHistogram::NUM_BUCKETS - 1) {
+        us >>= 1;
+        k += 1;
+    }
+    return k;
+}
+
+/*
+    q (0〜1) のパーセンタイル
+
+    ビンの中では対数の目盛りで補間する（ビンの幅が2倍ずつなので、線形より誤差が小さい）。
+    最小・最大の範囲に収める。
+*/
+std::uint32_t percentile(const LatencyHistogram& h, std::uint32_t total, double q)
+{
+    const double rank = q * total;
+    std::uint32_t below = 0;
+    for (std::uint8_t k = 0; k < LatencyHistogram::NUM_BUCKETS; ++k) {
+        const std::uint32_t n = h.buckets[k];
+        if (n > 0 && below + n >= rank) {
+            const double frac = (rank - below) / n;
+            const double v = (k == 0)
+                ? 2.0 * frac
+                : static_cast<double>(1UL << k) * std::exp2(frac);
+            return std::min(std::max(static_cast<std::uint32_t>(v), h.min), h.max);
+        }
+        below += n;
+    }
+    return h.max;
+}
+
+} // namespace
+
+std::uint32_t LatencyProbes::cycles() noexcept
+{
+    return ESP.getCycleCount();
+}
+
+void LatencyProbes::record(Probe probe, std::uint32_t us) noexcept
+{
+    const std::uint8_t k = bucketOf(us);
+
+    portENTER_CRITICAL(&gMux);
+    auto& h = _probes[static_cast<std::uint8_t>(probe)];
+    h.min = (h.count == 0) ? us : std::min(h.min, us);
+    h.max = std::max(h.max, us);
+    h.count += 1;
+    if (h.buckets[k] < UINT16_MAX) {
+        h.buckets[k] += 1;
+    }
+    portEXIT_CRITICAL(&gMux);
+}
+
+void LatencyProbes::recordCycles(Probe probe, std::uint32_t cycles) noexcept
+{
+    this->record(probe, cycles / getCpuFrequencyMhz());
+}
+
+LatencyReport LatencyProbes::report() const noexcept
+{
+    LatencyReport report {};
+    report.numProbes = LatencyReport::NUM_PROBES;
+    report.numBuckets = LatencyHistogram::NUM_BUCKETS;
+
+    portENTER_CRITICAL(&gMux);
+    std::copy(std::begin(_probes), std::end(_probes), std::begin(report.probes));
+    portEXIT_CRITICAL(&gMux);
+
+    // パーセンタイルはビンの合計から求める（ビンが飽和しても範囲内に収まる）
+    for (auto& h : report.probes) {
+        std::uint32_t total = 0;
+        for (auto n : h.buckets) {
+            total += n;
+        }
+        if (total > 0) {
+            h.p50 = percentile(h, total, 0.50);
+            h.p99 = percentile(h, total, 0.99);
+        }
+    }
+    return report;
+}
+
+void LatencyProbes::clear() noexcept
+{
+    portENTER_CRITICAL(&gMux);
+    std::fill(std::begin(_probes), std::end(_probes), LatencyHistogram {});
+    portEXIT_CRITICAL(&gMux);
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
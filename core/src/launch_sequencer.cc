@@ -0,0 +1,482 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "launch_sequencer.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min, std::max
+#include <cmath>        // std::sqrt, std::lround
+#include <cstdint>      // INT64_MAX, INT64_MIN
+
+// Arduino
+#include <Arduino.h>
+#include <SPIFFS.h>     // フラッシュメモリをファイル保存に使う
+
+// shark lib
+#include "lock.hh"
+#include "deadline_timer.hh"
+#include "os.hh"
+
+// ATLAS
+#include "atlas_manager.hh"
+#include "trace.hh"
+#include "utils.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
+//-----------------------------------------------------------------------------
+
+namespace {
+
+namespace os = shark::os;
+
+// タスクのスタックサイズ [bytes]
+constexpr std::uint32_t STACK_SEQUENCER = 4096;
+
+// 停止待ちの時間の余裕 [ms]（停止の目標時刻 + 最大の加速時間 + 安定の猶予時間に足す）
+constexpr std::uint32_t STOP_TIMEOUT_MARGIN = 1000;
+
+// 最大のデューティ比までの加速時間 [ms]
+constexpr std::uint32_t MAX_RAMP_TIME = 255 * MOTOR_RAMP_STEP_MS;
+
+// モーターの回転準備完了のビット
+constexpr std::uint32_t bitReady(std::uint32_t id)
+{
+    return 1 << id;
+}
+
+/*
+    射出1回分の情報
+
+    全モーターが加速を終えた時点で、最後に加速を終えたモーターの
+    完了通知から停止タイマーをセットし、タイマーのコールバックで
+    全モーターを続けて停止させる。
+*/
+struct Launch
+{
+    std::uint32_t mask;             // 駆動するモーター
+    std::atomic<std::uint32_t> ready;   // 回転準備が完了したモーター
+    std::int64_t target;            // 停止の目標時刻 [us]
+    std::uint32_t settle;           // 回転準備完了から停止までの最低時間 [ms]
+    std::atomic_bool armed;         // 停止タイマーをセットしたかどうか
+    std::int64_t stopped[NUM_MOTORS];   // 各モーターを停止した時刻 [us]
+};
+
+os::StaticTask<STACK_SEQUENCER> gSequencer; // シーケンサーのタスク
+shark::DeadlineTimer gStopTimer;            // モーター停止タイマー
+Launch gLaunch;                             // 実行中の射出
+
+// モーター停止（ESPタイマーのタスクから呼ばれる）
+void onStop(void*)
+{
+    // 全モーターの急停止による射出実行
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        if (gLaunch.mask & bitReady(i)) {
+            ATLAS.motors[i].stop();
+            gLaunch.stopped[i] = shark::DeadlineTimer::now();
+        }
+    }
+
+    // 停止時刻を記録してから（記録の時間を停止の間隔に含めない）
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        if (gLaunch.mask & bitReady(i)) {
+            trace(TraceEvent::MOTOR_STOPPED, i);
+        }
+    }
+
+    // シーケンサーに停止を通知
+    gSequencer.notify();
+}
+
+// モーターの加速完了（ESPタイマーのタスクから呼ばれる）
+void onSpunUp(void* arg)
+{
+    const auto id = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(arg));
+    trace(TraceEvent::MOTOR_SPUN_UP, id);
+
+    // 回転準備完了の通知
+    const std::uint32_t bits = gLaunch.ready.fetch_or(bitReady(id)) | bitReady(id);
+
+    // 全モーターの準備が整ったら停止タイマーをセットする（1度だけ）
+    if ((bits & gLaunch.mask) == gLaunch.mask && !gLaunch.armed.exchange(true)) {
+        const std::int64_t settled =
+            shark::DeadlineTimer::now() + 1000LL * gLaunch.settle;
+        if (!gStopTimer.arm(std::max(gLaunch.target, settled))) {
+            onStop(nullptr);
+        }
+    }
+}
+
+// モーターの加速開始（較正表から求めたデューティ比を返す）
+std::uint8_t spinUp(std::uint32_t id, const ELRParams& elr)
+{
+    const std::uint8_t duty = ATLAS.calib.duty(id, elr.sp());
+    void* arg = reinterpret_cast<void*>(static_cast<std::uintptr_t>(id));
+    if (!ATLAS.motors[id].rotateDutyAsync(duty, elr.isRight(), onSpunUp, arg)) {
+        // 加速できなかったモーターは準備完了として扱う
+        onSpunUp(arg);
+    }
+    return duty;
+}
+
+} // namespace
+
+//=============================================================================
+//
+// タスク
+//
+//=============================================================================
+
+// シーケンサー
+void LaunchSequencer::_taskSequencer(void* pvParams)
+{
+    auto& self = *static_cast<LaunchSequencer*>(pvParams);
+
+    Message msg;
+    while (true) {
+        // 指令待ち（ブロック）
+        if (!self._queue.receive(msg)) {
+            continue;
+        }
+
+        gLaunch.ready.store(0);
+        switch (msg.cmd) {
+        case LaunchCommand::AUTO_START:
+            self._runAuto(msg);
+            break;
+        case LaunchCommand::MANUAL_SHOOT:
+            self._runManual(msg);
+            break;
+        case LaunchCommand::SYNC_CALIBRATE:
+            self._runSyncCalibration();
+            break;
+        default:    // 待機中の中止指令は無視する
+            break;
+        }
+        // 射出中に溜まった指令は破棄する
+        // （IDLEにする前に破棄する。後だと、IDLEを見て送られた指令まで消える）
+        self._queue.reset();
+        self._state.store(LaunchState::IDLE);
+    }
+}
+
+//=============================================================================
+//
+// LaunchSequencer
+//
+//=============================================================================
+
+void LaunchSequencer::begin()
+{
+    // 2回目以降は何もしない
+    if (_queue.isCreated()) {
+        return;
+    }
+
+    // 指令キュー
+    _queue.begin();
+
+    // モーター停止タイマー
+    gStopTimer.begin("launchStop", onStop, nullptr);
+
+    // シーケンサー
+    gSequencer.start(
+        _taskSequencer,      // タスク
+        "taskLaunchSeq",     // タスク名
+        this,                // 起動パラメータ
+        2                    // 優先度（値が大きいほど優先順位が高い）
+    );
+}
+
+bool LaunchSequencer::post(LaunchCommand cmd)
+{
+    if (!_queue.isCreated()) {
+        return false;
+    }
+    Message msg {cmd, shark::DeadlineTimer::now()};
+    return _queue.send(msg);
+}
+
+LaunchTiming LaunchSequencer::timing() const
+{
+    shark::Lock lock(_mutexTiming);
+    return _timing;
+}
+
+bool LaunchSequencer::takeLastShot(LaunchShot& shot)
+{
+    shark::Lock lock(_mutexTiming);
+    if (!_hasLastShot) {
+        return false;
+    }
+    shot = _lastShot;
+    _hasLastShot = false;
+    return true;
+}
+
+bool LaunchSequencer::_waitAbort(std::uint32_t ms)
+{
+    const std::uint32_t start = os::millis();
+
+    Message msg;
+    while (true) {
+        const std::uint32_t elapsed = os::millis() - start;
+        if (elapsed >= ms) {
+            return false;
+        }
+        // 中止指令以外は読み捨てる
+        if (_queue.receive(msg, ms - elapsed) &&
+            msg.cmd == LaunchCommand::ABORT
+        ) {
+            return true;
+        }
+    }
+}
+
+void LaunchSequencer::_runAuto(const Message& msg)
+{
+    const auto& params = ATLAS.params;
+
+    // "Ready Set"の表示
+    ATLAS.view.autoModeCountdown(0);
+    trace(TraceEvent::COUNTDOWN, 0);
+
+    // 猶予時間の間、中止指令を待つ
+    _state.store(LaunchState::ARMED);
+    if (_waitAbort(params.latency())) {
+        trace(TraceEvent::LAUNCH_ABORTED);
+        ATLAS.view.autoModeAborted();
+        ATLAS.player.play(AUDIO_SE_CANCEL);
+        return;
+    }
+    _state.store(LaunchState::COUNTDOWN);
+
+    // モーターの停止時刻（カウントダウン + 同期調整時間 + 射出遅延時間）
+    const std::uint32_t ms = 4 * COUNTDOWN_INTERVAL + params.syncAdj() + params.delay();
+    const std::int64_t target = shark::DeadlineTimer::now() + 1000LL * ms;
+
+    // モーターの加速開始（カウントダウンと並行して加速する）
+    const auto index = params.autoModeELRIndex();
+    _prepare(bitReady(index), target, 0);
+    const std::uint8_t duty = spinUp(index, params.autoModeELR());
+
+    // カウントダウン音声
+    if (ATLAS.player.isEnabled()) {
+        ATLAS.player.play(AUDIO_COUNTDOWN);
+    }
+
+    // "3", "2", "1", "Go"の表示
+    std::uint32_t lastWake = os::millis();
+    ATLAS.view.autoModeCountdown(1);
+    trace(TraceEvent::COUNTDOWN, 1);
+    for (int i = 2; i < 5; ++i) {
+        os::delayUntil(lastWake, COUNTDOWN_INTERVAL);
+        ATLAS.view.autoModeCountdown(i);
+        trace(TraceEvent::COUNTDOWN, i);
+    }
+    os::delayUntil(lastWake, COUNTDOWN_INTERVAL);
+
+    // Shoot!（モーターはタイマーで停止する）
+    _state.store(LaunchState::SHOOT);
+
+    // 同期調整時間の後に"SHOOT"の表示
+    os::delay(params.syncAdj());
+    ATLAS.view.autoModeCountdown(5);
+    trace(TraceEvent::COUNTDOWN, 5);
+
+    // モーターの停止待ち（止まらなかった射出は較正に使わない）
+    if (!_waitStop(msg.time)) {
+        return;
+    }
+
+    // SP較正のために射出を記録する（BBPの計測結果と突き合わせる）
+    shark::Lock lock(_mutexTiming);
+    _lastShot.motor = static_cast<std::uint8_t>(index);
+    _lastShot.duty = duty;
+    _lastShot.time = os::millis();
+    _hasLastShot = true;
+}
+
+void LaunchSequencer::_runManual(const Message& msg)
+{
+    // 駆動するモーター
+    std::uint32_t mask = 0;
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        if (ATLAS.params.elr(i).enabledManual()) {
+            mask |= bitReady(i);
+        }
+    }
+    if (!mask) {
+        return;
+    }
+
+    // 全モーターの回転準備完了からモーター安定の猶予時間の後に停止する
+    _prepare(mask, 0, MOTOR_PREPARATORY_TIME);
+
+    // 全モーターの加速を同時に開始
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        if (mask & bitReady(i)) {
+            spinUp(i, ATLAS.params.elr(i));
+        }
+    }
+    _state.store(LaunchState::SHOOT);
+
+    // 全モーターの停止待ち
+    _waitStop(msg.time);
+}
+
+void LaunchSequencer::_runSyncCalibration()
+{
+    if (!ATLAS.player.isEnabled()) {
+        return;
+    }
+    _state.store(LaunchState::CALIBRATING);
+
+    // カウントダウン音声の再生開始までの時間を繰り返し計測する
+    std::int32_t samples[SYNC_CALIB_TRIALS];
+    std::uint32_t n = 0;
+    for (std::uint32_t i = 0; i < SYNC_CALIB_TRIALS; ++i) {
+        const std::int32_t latency =
+            ATLAS.player.measureLatency(AUDIO_COUNTDOWN, SYNC_CALIB_TIMEOUT);
+        if (latency >= 0) {
+            samples[n++] = latency;
+        }
+        os::delay(200);
+    }
+    if (n == 0) {
+        debugMsg(F("failed to measure audio latency"));
+        ATLAS.player.play(AUDIO_SE_ERROR);
+        return;
+    }
+
+    // 中央値を同期調整時間とする（SDカードの読み出しによる外れ値に強い）
+    // 高々 SYNC_CALIB_TRIALS 個なので挿入ソートで並べる
+    for (std::uint32_t i = 1; i < n; ++i) {
+        const std::int32_t v = samples[i];
+        std::uint32_t j = i;
+        for (; j > 0 && samples[j - 1] > v; --j) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = v;
+    }
+    ATLAS.params.setSyncAdj(static_cast<std::uint16_t>(samples[n / 2]));
+
+#if BUILD_TYPE != BUILD_RELEASE
+    Serial.printf("audio latency: %ld ms (%lu samples)\n",
+                  static_cast<long>(samples[n / 2]),
+                  static_cast<unsigned long>(n));
+#endif
+
+    // パラメータをファイルに保存する
+    if (File file = SPIFFS.open(PARAMS_FPATH, "w")) {
+        writeFile(file, ATLAS.params);
+        file.close();
+    }
+    ATLAS.player.play(AUDIO_SE_ACK);
+}
+
+void LaunchSequencer::_prepare(
+    std::uint32_t mask,
+    std::int64_t target,
+    std::uint32_t settle
+) {
+    gStopTimer.cancel();
+    os::takeNotify(0);
+
+    gLaunch.mask = mask;
+    gLaunch.target = target;
+    gLaunch.settle = settle;
+    gLaunch.armed.store(false);
+}
+
+bool LaunchSequencer::_waitStop(std::int64_t command)
+{
+    // タイマーのコールバックからの通知待ち
+    // （加速完了の通知が来ないと停止タイマーがセットされないので、時間を区切る）
+    const std::int64_t remain = std::max<std::int64_t>(
+        gLaunch.target - shark::DeadlineTimer::now(), 0);
+    const std::uint32_t timeout = static_cast<std::uint32_t>(remain / 1000)
+        + MAX_RAMP_TIME + gLaunch.settle + STOP_TIMEOUT_MARGIN;
+    if (!os::takeNotify(timeout)) {
+        _abortStop(timeout);
+        return false;
+    }
+
+    // 最初と最後に停止したモーター
+    std::int64_t first = INT64_MAX;
+    std::int64_t last = INT64_MIN;
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        if (gLaunch.mask & bitReady(i)) {
+            first = std::min(first, gLaunch.stopped[i]);
+            last = std::max(last, gLaunch.stopped[i]);
+        }
+    }
+
+    // 目標時刻はタイマーにセットした時刻
+    _record(first - command, first - gStopTimer.deadline(), last - first);
+    return true;
+}
+
+void LaunchSequencer::_abortStop(std::uint32_t timeout)
+{
+    // 遅れて届いた加速完了の通知で停止タイマーがセットされないようにする
+    gLaunch.armed.store(true);
+    gStopTimer.cancel();
+
+    // 全モーターを止める
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        ATLAS.motors[i].stop();
+    }
+
+    // 射出の情報を消す（タイマーと入れ違いの通知も捨てる）
+    gLaunch.mask = 0;
+    gLaunch.ready.store(0);
+    os::takeNotify(0);
+
+    trace(TraceEvent::LAUNCH_TIMEOUT, timeout);
+    debugMsg(F("motors did not stop in time"));
+    ATLAS.player.play(AUDIO_SE_ERROR);
+}
+
+void LaunchSequencer::_record(
+    std::int64_t latency,
+    std::int64_t error,
+    std::int64_t skew
+) {
+    const auto e = static_cast<std::int32_t>(error);
+    const auto k = static_cast<std::uint32_t>(skew);
+
+    // サイクルカウンタでは測れない長さなので、esp_timer で測った時間を記録する
+    ATLAS.latency.record(Probe::SHOT_TO_STOP, static_cast<std::uint32_t>(latency));
+    {
+        shark::Lock lock(_mutexTiming);
+        auto& t = _timing;
+
+        t.minError = (t.count == 0) ? e : std::min(t.minError, e);
+        t.maxError = (t.count == 0) ? e : std::max(t.maxError, e);
+        t.count += 1;
+        t.lastLatency = static_cast<std::uint32_t>(latency);
+        t.lastError = e;
+        t.lastSkew = k;
+        t.maxSkew = std::max(t.maxSkew, k);
+
+        // 平均と標準偏差（ジッター）
+        _sumError += e;
+        _sumError2 += static_cast<std::uint64_t>(static_cast<std::int64_t>(e) * e);
+        const double mean = static_cast<double>(_sumError) / t.count;
+        const double var = static_cast<double>(_sumError2) / t.count - mean * mean;
+        t.meanError = static_cast<std::int32_t>(std::lround(mean));
+        t.jitter = var > 0 ? static_cast<std::uint32_t>(std::lround(std::sqrt(var))) : 0;
+    }
+
+    trace(TraceEvent::LAUNCH_RESULT, static_cast<std::uint32_t>(latency),
+          static_cast<std::uint32_t>(e));
+    trace(TraceEvent::LAUNCH_SKEW, k);
+}
+
+//-----------------------------------------------------------------------------
+#endif  // #if ATLAS_FORMAT == ATLAS_FULL_SPEC
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -5,13 +5,12 @@
 #include "mode_process.hh"
 
 // C++標準ライブラリ
+#include <atomic>   // std::atomic_bool
 #include <cstring>
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
-#include <atomic>   // std::atomic_ulong
-#endif
 
 // Shark Lib
 #include "bbp_analyzer.hh"
+#include "os.hh"
 #include "statistics.hh"
 
 // Arduino
@@ -23,6 +22,8 @@
 #include "atlas_manager.hh"
 #include "utils.hh"
 #include "images.hh"
+#include "raw_record.hh"
+#include "trace.hh"
 
 namespace atlas
 {
@@ -31,6 +32,13 @@ namespace atlas
 // BBPからのデータ解析準備
 static shark::BBPAnalyzer gAnalyzer;
 
+// シュートのデータ列（B0-B7, 70-73）の最初のフレームを受信した時刻（サイクル）
+// 通知のコールバックだけが使う
+static constexpr std::uint8_t BBP_HEADER_ATTACH_DETACH = 0xA0;  // 着脱イベント
+static constexpr std::uint8_t BBP_HEADER_LIST_FIRST = 0xB0;     // データ列の先頭
+static std::uint32_t gSetStart = 0;
+static bool gSetStarted = false;
+
 // スキャン結果保持用
 static NimBLEAddress gFoundAddress;
 static std::atomic_bool gDeviceFound = false;
@@ -38,192 +46,6 @@ static std::atomic_bool gDeviceFound = false;
 // 接続状態
 static std::atomic_bool gDisconnected = true;
 
-// 自動発射状況
-static std::atomic_bool gIsAbortable = false;
-
-//=============================================================================
-//
-// タスク
-//
-//=============================================================================
-
-//-----------------------------------------------------------------------------
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
-//-----------------------------------------------------------------------------
-// イベントグループ
-static EventGroupHandle_t gEventGroup;
-
-// タスク制御
-#define BIT_START   (1 << 0)
-#define BIT_ABORT   (1 << 1)
-#define BIT_SHOOT   (1 << 2)
-
-// カウントダウンマスタータスク
-void taskCountMaster(void* pvParams)
-{
-    // イベントグループによるキャンセル処理
-    gIsAbortable.store(true);                   // キャンセル可能に
-    EventBits_t bits = xEventGroupWaitBits(     // キャンセル待ち
-        gEventGroup,
-        BIT_ABORT,                              // ABORT信号を待つ
-        pdFALSE,
-        pdFALSE,
-        pdMS_TO_TICKS(ATLAS.params.latency())   // キャンセル可能時間
-    );
-    gIsAbortable.store(false);                  // キャンセル不可能に
-
-    // キャンセル
-    if (bits & BIT_ABORT) {
-        debugMsg(F("canceled"));
-    }
-    // 継続
-    else {
-        // カウントダウン開始通知
-        xEventGroupSetBits(gEventGroup, BIT_START);
-
-        // 4秒カウント
-        TickType_t lastWake = xTaskGetTickCount();
-        const TickType_t interval = pdMS_TO_TICKS(1000);
-        for (int i = 0; i < 4; ++i) {
-            vTaskDelayUntil(&lastWake, interval);
-        }
-
-        // Shoot!のタイミングを全体通知
-        xEventGroupSetBits(gEventGroup, BIT_SHOOT);
-    }
-
-    // タスク終了処理
-    vTaskDelete(nullptr);
-}
-
-// モーター制御: オートモード
-void taskMotorAuto(void* pvParams)
-{
-    // 中止・開始待ち
-    EventBits_t bits = xEventGroupWaitBits(
-        gEventGroup,
-        BIT_START | BIT_ABORT,
-        pdFALSE,
-        pdFALSE,
-        portMAX_DELAY
-    );
-
-    // 中止
-    if (bits & BIT_ABORT) {
-       debugMsg(F("motor canceled"));
-    }
-    // 継続
-    else {
-        // 駆動するモーターインスタンスのキャッシュ
-        auto& motor = ATLAS.motors[ATLAS.params.autoModeELRIndex()];
-
-        // 回転開始
-        const auto& elr = ATLAS.params.autoModeELR();
-        motor.rotate(elr.sp(), elr.isRight());
-
-        // SHOOT号令待機
-        xEventGroupWaitBits(
-            gEventGroup,
-            BIT_SHOOT,
-            pdTRUE,
-            pdTRUE,
-            portMAX_DELAY
-        );
-
-        // 同期調整時間 + 射出遅延時間
-        vTaskDelay(pdMS_TO_TICKS(SYNC_ADJ_TIME + ATLAS.params.delay()));
-        
-        // モーターの急停止による射出実行
-        motor.stop();
-    }
-
-    // タスク終了処理
-    vTaskDelete(nullptr);
-}
-
-// 射出前カウントダウン表示
-void taskCountView(void* pvParams)
-{
-    // "Ready Set"の表示
-    ATLAS.view.autoModeCountdown(0);
-
-    // 中止 or 開始待ち
-    EventBits_t bits = xEventGroupWaitBits(
-        gEventGroup,
-        BIT_START | BIT_ABORT,
-        pdFALSE,
-        pdFALSE,
-        portMAX_DELAY
-    );
-
-    // 中止
-    if (bits & BIT_ABORT) {
-        // 中止信号が来たので中止のメッセージを表示する
-        ATLAS.view.autoModeAborted();
-    }
-    // 継続
-    else {
-        // "3"の表示
-        ATLAS.view.autoModeCountdown(1);
-
-        // "2", "1", "Go"の表示
-        TickType_t lastWake = xTaskGetTickCount();
-        const TickType_t interval = pdMS_TO_TICKS(1000);
-        for (int i = 2; i < 5; ++i) {
-            vTaskDelayUntil(&lastWake, interval);
-            ATLAS.view.autoModeCountdown(i);
-        }
-
-        // ZERO待ちで0表示
-        xEventGroupWaitBits(
-            gEventGroup,
-            BIT_SHOOT,
-            pdTRUE,
-            pdTRUE,
-            portMAX_DELAY
-        );
-        // 同期調整時間
-        vTaskDelay(pdMS_TO_TICKS(SYNC_ADJ_TIME));
-
-        // "SHOOT"の表示
-        ATLAS.view.autoModeCountdown(5);
-    }
-
-    // タスク終了処理
-    vTaskDelete(nullptr);
-}
-
-// 射出前カウントダウン音声
-void taskCountVoice(void* pvParams)
-{
-    // 中止 or 開始待ち
-    EventBits_t bits = xEventGroupWaitBits(
-        gEventGroup,
-        BIT_START | BIT_ABORT,
-        pdFALSE,
-        pdFALSE,
-        portMAX_DELAY
-    );
-
-    // 中止
-    if (bits & BIT_ABORT) {
-        // 中止SEを流す
-        ATLAS.player.play(AUDIO_SE_CANCEL);
-    }
-    // 継続
-    else {
-        // カウントダウン音声を流す
-        ATLAS.player.play(AUDIO_COUNTDOWN);
-    }
-    
-    // タスク終了処理
-    vTaskDelete(nullptr);
-}
-
-//-----------------------------------------------------------------------------
-#endif  // #if ATLAS_FORMAT == ATLAS_FULL_SPEC
-//-----------------------------------------------------------------------------
-
 //=============================================================================
 //
 // コールバック
@@ -253,13 +75,14 @@ class ClientCallbacks
 {
     void onConnect(NimBLEClient* client) override
     {
-        Serial.println("client connected");
+        trace(TraceEvent::BBP_CONNECTED);
+        ATLAS.boot.mark(BootStage::BBP_CONNECTED);
         gDisconnected.store(false);
     }
 
     void onDisconnect(NimBLEClient* pClient, int reason) override
     {
-        Serial.println("client disconnected");
+        trace(TraceEvent::BBP_DISCONNECTED, static_cast<std::uint32_t>(reason));
         gDisconnected.store(true);
     }
 };
@@ -268,7 +91,7 @@ static ClientCallbacks gClientCallbacks;
 // ベイがランチャーに装着された／ランチャーから外された
 void onBeyAttachedOrDetached()
 {
-    debugMsg(F("beyblade has been attached / detached"));
+    trace(TraceEvent::BEY_ATTACHED);
 
     // 表示更新
     ATLAS.view.autoModeStandby();
@@ -277,32 +100,72 @@ void onBeyAttachedOrDetached()
 // ベイが射出された
 void onBeyLaunched()
 {
-    debugMsg(F("beyblade has been launched"));
-
     // 状態更新
     ATLAS.state.setBey(false);
 
     // 統計データ更新
     std::uint16_t acc1, acc2;
-    ATLAS.result.update(gAnalyzer.sp(), gAnalyzer.raw(), acc1, acc2);
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+    const auto nEval = ATLAS.result.statsEval.total;
+#endif
+    {
+        ScopedLatency timer(ATLAS.latency, Probe::RESULT_UPDATE);
+        ATLAS.result.update(gAnalyzer.sp(), gAnalyzer.raw(), acc1, acc2);
+    }
+    trace(TraceEvent::BEY_LAUNCHED, gAnalyzer.sp(), ATLAS.result.statsEval.latestSP);
+
+//-----------------------------------------------------------------------------
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う
+//-----------------------------------------------------------------------------
+
+    // 電動ランチャーで射出した直後なら、評価SPからSP較正表を学習する
+    LaunchShot shot;
+    if (ATLAS.launcher.takeLastShot(shot) &&
+        ATLAS.result.statsEval.total != nEval &&   // 評価SPが有効
+        shark::os::millis() - shot.time < CALIB_SHOT_WINDOW
+    ) {
+        const auto evalSP = ATLAS.result.statsEval.latestSP;
+        if (ATLAS.calib.learn(shot.motor, shot.duty, evalSP)) {
+            if (File file = SPIFFS.open(CALIB_FPATH, "w")) {
+                writeFile(file, ATLAS.calib);
+                file.close();
+            }
+            trace(TraceEvent::CALIB_UPDATED, shot.motor, shot.duty);
+        }
+    }
+
+//-----------------------------------------------------------------------------
+#endif
+//-----------------------------------------------------------------------------
 
     // 表示更新
     ATLAS.view.autoModeSP(acc1, acc2);
 
     // 解析結果保存
-    if (File file = SPIFFS.open(RESULT_FPATH, "w")) {
-        writeFile(file, ATLAS.result);
-        file.close();
+    {
+        ScopedLatency timer(ATLAS.latency, Probe::FLASH_WRITE);
+        if (File file = SPIFFS.open(RESULT_FPATH, "w")) {
+            writeFile(file, ATLAS.result);
+            file.close();
+        }
     }
 
     // SPデータ保存（追記）
-    if (File file = SPIFFS.open(RAW_FPATH, "a")) {
-        if (file.size() < MAX_SIZE_SP_FILE) {
-            writeFile(file, ATLAS.result.statsOrig.total);
-            writeFile(file, gAnalyzer.sp());
-            writeFile(file, ATLAS.result.statsEval.latestSP);
-            writeFile(file, gAnalyzer.raw(), sizeof(std::uint16_t) * 32);
-            file.close();
+    {
+        ScopedLatency timer(ATLAS.latency, Probe::FLASH_WRITE);
+        if (File file = SPIFFS.open(RAW_FPATH, "a")) {
+            if (file.size() < MAX_SIZE_SP_FILE) {
+                RawRecord record;
+                record.total = ATLAS.result.statsOrig.total;
+                record.origSP = gAnalyzer.sp();
+                record.evalSP = ATLAS.result.statsEval.latestSP;
+                std::memcpy(record.profile, gAnalyzer.raw(), sizeof(record.profile));
+                writeFile(file, record);
+                file.close();
+            }
+            else {
+                timer.cancel();     // 書き込んでいない
+            }
         }
     }
 
@@ -313,7 +176,7 @@ void onBeyLaunched()
 // BLE通信のCRCエラー
 void onCRCError()
 {
-    debugMsg(F("CRC error"));
+    trace(TraceEvent::CRC_ERROR);
 
     // 状態更新
     ATLAS.state.setBey(false);
@@ -332,7 +195,7 @@ void onCRCError()
 // 電動ランチャーが有効になった
 void onELREnabled()
 {
-    debugMsg(F("ELR enabled"));
+    trace(TraceEvent::ELR_ENABLED);
 
     // 電動ランチャーを有効にする
     ATLAS.state.setELR(true);
@@ -345,7 +208,7 @@ void onELREnabled()
 // 電動ランチャーが無効になった
 void onELRDisabled()
 {
-    debugMsg(F("ELR disabled"));
+    trace(TraceEvent::ELR_DISABLED);
 
     // 電動ランチャーを有効にする
     ATLAS.state.setELR(false);
@@ -358,61 +221,20 @@ void onELRDisabled()
 // 電動ランチャーを回転させ始める
 void onLaunchStarted()
 {
-    debugMsg(F("beyblade will be launched after countdown"));
-
-    // イベントグループのビットをクリア
-    xEventGroupClearBits(gEventGroup, 0xFF);
-
-    // マスタータスク
-    xTaskCreate(
-        taskCountMaster,   // タスク
-        "taskCountMaster", // タスク名
-        4096,              // スタックメモリ
-        nullptr,           // 起動パラメータ
-        1,                 // 優先度（値が大きいほど優先順位が高い）
-        nullptr            // タスクハンドル
-    );
-
-    // モータータスクの投入
-    xTaskCreate(
-        taskMotorAuto,     // タスク
-        "taskMotorAuto",   // タスク名
-        4096,              // スタックメモリ
-        nullptr,           // 起動パラメータ
-        3,                 // 優先度（値が大きいほど優先順位が高い）
-        nullptr            // タスクハンドル
-    );
-
-    // カウントダウン表示タスクの投入
-    xTaskCreate(
-        taskCountView,     // タスク
-        "taskCountView",   // タスク名
-        4096,              // スタックメモリ
-        nullptr,           // 起動パラメータ
-        2,                 // 優先度（値が大きいほど優先順位が高い）
-        nullptr            // タスクハンドル
-    );
-
-    // カウントダウン音声タスクの投入
-    if (ATLAS.player.isEnabled()) {
-        xTaskCreate(
-            taskCountVoice,    // タスク
-            "taskCountVoice",  // タスク名
-            4096,              // スタックメモリ
-            nullptr,           // 起動パラメータ
-            2,                 // 優先度（値が大きいほど優先順位が高い）
-            nullptr            // タスクハンドル
-        );
-    }
+    trace(TraceEvent::LAUNCH_STARTED);
+    ATLAS.boot.mark(BootStage::FIRST_LAUNCH);
+
+    // 射出シーケンサーに開始指令を送る
+    ATLAS.launcher.post(LaunchCommand::AUTO_START);
 }
 
 // 射出がキャンセルされた
 void onLaunchCanceled()
 {
-    debugMsg(F("beyblade launching will be canceled"));
+    trace(TraceEvent::LAUNCH_CANCELED);
 
-    // 各タスクに中止信号を送る
-    xEventGroupSetBits(gEventGroup, BIT_ABORT);
+    // 射出シーケンサーに中止指令を送る
+    ATLAS.launcher.post(LaunchCommand::ABORT);
 }
 
 //-----------------------------------------------------------------------------
@@ -422,7 +244,7 @@ void onLaunchCanceled()
 // マニュアル/設定モードにスイッチされた
 void onSwitchedToManualMode()
 {
-    debugMsg(F("switched to manual mode"));
+    trace(TraceEvent::MANUAL_SWITCHED);
 
     // モードをマニュアル/設定モードに切り替える
     ATLAS.setMode(false);
@@ -439,13 +261,37 @@ void onNotifyData(
     std::size_t length,
     bool isNotify
 ) {
+    // 受信時刻（データ列の最初のフレームなら、解析完了までの計測の開始）
+    const std::uint32_t tArrival = LatencyProbes::cycles();
+
+    // 長さの足りないデータは読み捨てる
+    if (length < shark::BBPData::LENGTH) {
+        return;
+    }
+
     shark::BBPData bbpData;
 
     // コピー
     std::memcpy(bbpData.data(), data, shark::BBPData::LENGTH);
 
+    // データ列の先頭（先頭が抜けたときは、着脱イベント以外の最初のフレーム）から計測する
+    const std::uint8_t header = bbpData.header();
+    if (header == BBP_HEADER_LIST_FIRST ||
+        (!gSetStarted && header != BBP_HEADER_ATTACH_DETACH)
+    ) {
+        gSetStart = tArrival;
+        gSetStarted = true;
+    }
+
     // 値の解析
     auto bbpState = gAnalyzer.analyze(bbpData);
+    if (bbpState == shark::BBPState::FINISHED) {
+        ATLAS.latency.recordCycles(Probe::BBP_ANALYZE, LatencyProbes::cycles() - gSetStart);
+    }
+    if (bbpState == shark::BBPState::FINISHED || bbpState == shark::BBPState::ERROR) {
+        gSetStarted = false;    // データ列の終わり
+    }
+    trace(TraceEvent::BBP_NOTIFY, static_cast<std::uint32_t>(bbpState), length);
     ATLAS.state.setBey((static_cast<std::uint16_t>(bbpState) & 0x04) > 0);
     switch (bbpState) {
     case shark::BBPState::BEY_ATTACHED_S1:  // ベイがランチャーにセットされた
@@ -471,7 +317,7 @@ void onNotifyData(
         onLaunchStarted();
         break;
     case shark::BBPState::BEY_DETACHED_S2:  // 射出命令キャンセル
-        if (gIsAbortable.load()) {
+        if (ATLAS.launcher.isAbortable()) {
             onLaunchCanceled();
         }
         break;
@@ -503,11 +349,6 @@ void runAutoMode()
 
     ATLAS.state.clear();
 
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC
-    // イベントグループの作成
-    gEventGroup = xEventGroupCreate();
-#endif
-
     // BLE通信開始
     NimBLEDevice::init("");
 
@@ -518,6 +359,10 @@ void runAutoMode()
     scan->setScanCallbacks(&gScanCallbacks);
     scan->setActiveScan(true);
 
+    // クライアントは再接続のたびに作り直さず、モード中は使い回す
+    NimBLEClient* client = NimBLEDevice::createClient();
+    client->setClientCallbacks(&gClientCallbacks, false);
+
     while (ATLAS.isAutoMode()) {
         // BBPのアドバタイズを促すメッセージを表示
         ATLAS.view.autoModePromotion();
@@ -529,11 +374,8 @@ void runAutoMode()
             continue;
         }
 
-        NimBLEClient* client = NimBLEDevice::createClient();
-        client->setClientCallbacks(&gClientCallbacks, false);
         if (!client->connect(gFoundAddress)) {
             debugMsg(F("connection failed"));
-            NimBLEDevice::deleteClient(client);
             continue;
         }
 
@@ -541,7 +383,6 @@ void runAutoMode()
         if (!serv) {
             debugMsg(F("no service"));
             client->disconnect();
-            NimBLEDevice::deleteClient(client);
             continue;
         }
 
@@ -554,32 +395,36 @@ void runAutoMode()
             // 購読できるキャラクタリスティックではない
             debugMsg(F("not subscribable"));
         }
-        else if (!ch->subscribe(true, onNotifyData)) {
-            // キャラクタリスティックの購読に失敗した
-            debugMsg(F("subscription failed"));
-        }
         else {
-            ATLAS.player.play(AUDIO_SE_ACK);  // 接続完了のアナウンス音
-            ATLAS.state.setBBP(true);         // 状態を更新
-            ATLAS.view.autoModeStandby();     // 描画
-
-            // BBPとATLASの通信開始
-            while (client->isConnected()) {
-                if (ATLAS.isManualMode()) {
-                    ATLAS.state.setELR(false);
-                    // デバイスからの切断とクライアントの削除
-                    if (client->isConnected()) {
-                        if (ch && ch->canNotify()) {
-                            ch->unsubscribe();
+            // 購読した直後に届くベイの装着の通知を落とさないように、先に状態を更新する
+            ATLAS.state.setBBP(true);
+            if (!ch->subscribe(true, onNotifyData)) {
+                // キャラクタリスティックの購読に失敗した
+                debugMsg(F("subscription failed"));
+                ATLAS.state.setBBP(false);
+            }
+            else {
+                ATLAS.player.play(AUDIO_SE_ACK);  // 接続完了のアナウンス音
+                ATLAS.view.autoModeStandby();     // 描画
+
+                // BBPとATLASの通信開始
+                while (client->isConnected()) {
+                    if (ATLAS.isManualMode()) {
+                        ATLAS.state.setELR(false);
+                        // デバイスからの切断とクライアントの削除
+                        if (client->isConnected()) {
+                            if (ch && ch->canNotify()) {
+                                ch->unsubscribe();
+                            }
                         }
+                        break;
                     }
-                    break;
+                    delay(1);
                 }
-                delay(1);
             }
         }
 
-        // クライアントの削除
+        // デバイスからの切断
         if (client->isConnected()) {
             client->disconnect();
             while (!gDisconnected.load()) {
@@ -587,25 +432,18 @@ void runAutoMode()
             }
             delay(50);
         }
-        NimBLEDevice::deleteClient(client);
         gDeviceFound.store(false);
 
         // BBPとATLASのセッション終了の処理
         ATLAS.player.play(AUDIO_SE_CANCEL);  // 音声案内
-        ATLAS.state.setBBP(false);           // 状態更新
-        ATLAS.state.setBey(false);           // 状態更新
+        ATLAS.state.setBBP(false);           // 状態更新（ベイの装着も解除）
         delay(1);
     }
 
     // 終了処理
     scan->stop();
     scan->clearResults();
-    NimBLEDevice::deinit(true);
-
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC
-    // イベントグループの削除
-    vEventGroupDelete(gEventGroup);
-#endif
+    NimBLEDevice::deinit(true);  // クライアントもここで削除される
 
     debugMsg(F("[auto/measurement mode] out"));
 }
@@ -5,7 +5,8 @@
 #include "mode_process.hh"
 
 // C++標準ライブラリ
-#include <atomic>   // std::atomic_ulong
+#include <algorithm>  // std::min
+#include <atomic>     // std::atomic_bool, std::atomic_uint8_t, std::atomic_uint16_t
 #include <cstring>
 
 // Arduino
@@ -13,9 +14,16 @@
 #include <NimBLEDevice.h>
 #include <SPIFFS.h>
 
+// shark lib
+#include "lock.hh"
+#include "os.hh"
+
 // ATLAS
 #include "atlas_manager.hh"
+#include "ble_protocol.hh"
 #include "device_info.hh"
+#include "raw_record.hh"
+#include "trace.hh"
 #include "utils.hh"
 #include "setting.hh"
 
@@ -28,12 +36,25 @@ static NimBLEService* gService = nullptr;
 
 // 生データ転送用
 static NimBLECharacteristic* gCharDataRaw;              // キャラクタリスティック
-static QueueHandle_t gQueueDataTrans = nullptr;         // 送信開始
-static QueueHandle_t gQueueDataAck = nullptr;           // ACK受信用
-static TaskHandle_t gHandleTaskDataTrans = nullptr;     // データ転送タスクハンドル
-static constexpr std::uint16_t WINDOW_SIZE = 10;        // 送信ウィンドウサイズ
-static constexpr std::uint16_t PAYLOAD_SIZE = (64 + 2 * 3) * 3;  // 210 bytes
+static constexpr std::uint32_t STACK_DATA_TRANS = 4096; // データ転送タスクのスタック
+static shark::os::StaticQueue<RawCtrlCommand, 4> gQueueDataTrans;  // 送信開始・再開
+static shark::os::StaticQueue<std::uint16_t, RAW_WINDOW_SIZE> gQueueDataAck;    // ACK受信用
+static shark::os::StaticTask<STACK_DATA_TRANS> gTaskDataTrans;      // データ転送タスク
 static std::atomic_bool gNotifyEnabled = false;         // 送信可否
+static shark::Mutex gMutexTransfer;                     // 転送中はBLEを終了しない
+static std::atomic_uint16_t gMtu = 23;                  // 接続中のMTU（交換前は23）
+static std::atomic_uint16_t gConnHandle = 0;            // 接続ハンドル
+static std::atomic_uint16_t gConnInterval = 0;          // 接続間隔 [1.25ms]
+static std::atomic_uint8_t gPhy = BLE_GAP_LE_PHY_1M;    // 送信のPHY
+static std::atomic_uint16_t gDataLength = 27;           // 送信のLLの最大ペイロード [bytes]
+static ble_gap_event_listener gGapListener;             // LLの最大ペイロードの変更の受信用
+static RawTransferReport gRawReport;                    // 直前の転送の結果
+static shark::Mutex gMutexRawReport;                    // gRawReport の読み書き
+
+#if ATLAS_TRACE
+// トレースの送り出し用
+static NimBLECharacteristic* gCharTrace = nullptr;
+#endif
 
 // デバイス情報
 static constexpr atlas::DeviceInfo DEVICE_INFO {
@@ -49,145 +70,164 @@ static constexpr atlas::DeviceInfo DEVICE_INFO {
     }
 };
 
-//-----------------------------------------------------------------------------
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
-//-----------------------------------------------------------------------------
-
-// イベントグループ
-static EventGroupHandle_t gEventGroup;
-
-// タスク制御
-#define  BIT_SHOOT  (1 << 0)
-
-//-----------------------------------------------------------------------------
-#endif  // #if ATLAS_FORMAT == ATLAS_FULL_SPEC
-//-----------------------------------------------------------------------------
-
 //=============================================================================
 //
 // タスク
 //
 //=============================================================================
 
+/*
+    生データ転送の入出力（ファイルから読み、RAW_DATAの通知で送る）
+
+    gMutexTransfer を持ったまま使うこと。gNotifyEnabled は中断の合図にすぎず、
+    確認してから通知するまでの間にBLEが終了しないことはロックで保証する。
+*/
+class RawDataPort
+    : public RawSender::Port
+{
+public:
+    explicit RawDataPort(File& file) : _file(file) {}
+
+    std::size_t read(std::uint8_t* data, std::size_t size) override {
+        return _file.read(data, size);
+    }
+
+    bool notify(const std::uint8_t* data, std::size_t size) override {
+        return gCharDataRaw->notify(data, size);
+    }
+
+    // 送信バッファが空くまで待つ（yield だと優先度の低いタスクが動けないので、1ティック休む）
+    void waitTxSpace() override {
+        shark::os::delay(1);
+    }
+
+    bool waitAck(std::uint32_t timeout) override {
+        return shark::os::takeNotify(timeout);
+    }
+
+    bool takeAck(std::uint16_t& seq) override {
+        return gQueueDataAck.receive(seq, 0);
+    }
+
+    // 新しいコマンドが来たか、切断・購読の解除・モードの終了で送れなくなったら中断
+    bool aborted() override {
+        return gQueueDataTrans.count() > 0 || !gNotifyEnabled.load();
+    }
+
+    void acked(std::uint16_t numAcked, std::uint16_t numPackets) override {
+        trace(TraceEvent::RAW_SEND_ACKED, numAcked, numPackets);
+    }
+
+private:
+    File& _file;
+};
+
+/*
+    バルク転送の開始
+
+    転送の間だけ、最短の接続間隔・Data Length Extension・2M PHY を要求する。
+    どれもセントラル（スマートフォン）が受け入れたときだけ変わり、結果は
+    onConnParamsUpdate / onPhyUpdate / onGapEvent で知らされる。
+    gMutexTransfer を持ったまま呼ぶこと（BLEの終了と排他する）。
+*/
+static void beginBulkTransfer()
+{
+    const std::uint16_t conn = gConnHandle.load();
+    gServer->updateConnParams(conn, ATLAS_BULK_INTERVAL_MIN, ATLAS_BULK_INTERVAL_MAX,
+                              0, ATLAS_CONN_TIMEOUT);
+    gServer->setDataLen(conn, ATLAS_BULK_DATA_LENGTH);
+    gServer->updatePhy(conn, BLE_GAP_LE_PHY_2M_MASK, BLE_GAP_LE_PHY_2M_MASK, 0);
+}
+
+/*
+    バルク転送の終了
+
+    接続間隔だけを緩める（Data Length Extension と 2M PHY は、同じデータなら
+    無線の時間が短くなるだけなので戻さない）。切断・モードの終了で中断したときは、
+    接続がないので何もしない。
+    gMutexTransfer を持ったまま呼ぶこと。フラグの確認から要求までの間に切断されても
+    NimBLEがエラーを返すだけで、NimBLEの終了はロックが終わるまで待たされる。
+*/
+static void endBulkTransfer()
+{
+    if (!gNotifyEnabled.load()) {
+        return;
+    }
+    gServer->updateConnParams(gConnHandle.load(), ATLAS_IDLE_INTERVAL_MIN, ATLAS_IDLE_INTERVAL_MAX,
+                              0, ATLAS_CONN_TIMEOUT);
+}
+
 // 生データ転送タスク
 void taskDataTrans(void* pvParams)
 {
-    std::uint8_t cmd;
-    std::uint8_t buf[PAYLOAD_SIZE + 2];  // シーケンス番号の分が2bytes
+    RawCtrlCommand cmd;
 
     while (true) {
-        // 通知待ち（ブロック）
-        if (xQueueReceive(gQueueDataTrans, &cmd, portMAX_DELAY) != pdTRUE) {
+        // 通知待ち（ブロック）。このタスクはモードを跨いで常駐する
+        if (!gQueueDataTrans.receive(cmd)) {
             continue;
         }
 
-        // クライアントがsubscribeしているか
+        // 転送が終わるまでBLEを終了させない（runManualMode の終了処理と排他する）
+        shark::Lock transfer(gMutexTransfer);
+
+        // クライアントがsubscribeしているか（終了処理の後は常に false）
         if (!gNotifyEnabled.load()) {
-            debugMsg(F("not subscribed"));
+            trace(TraceEvent::RAW_NOT_SENT, 0);
             continue;
         }
 
         // ファイルを開く
         File file = SPIFFS.open(RAW_FPATH, "r");
         if (!file) {
-            debugMsg(F("file not found"));
+            trace(TraceEvent::RAW_NOT_SENT, 1);
             continue;
         }
 
-        // サイズ計算等の準備
+        // 再開なら指定の位置から
         const std::uint32_t totalSize = file.size();
-        const std::uint32_t numPackets =
-            (totalSize + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE;
-
-        // シーケンス番号
-        std::uint16_t seq = 0;
-        std::uint16_t lastAck = 0;
-
-        debugMsg(F("start sending SP raw data..."));
-
-        Serial.printf("File size: %u\n", file.size());
-        int counter = 1;
-
-        while (seq < numPackets) {
-            // ウィンドウ分送信
-            while (seq < (lastAck + WINDOW_SIZE) && seq < numPackets) {
-                // ファイルの内容をバッファに読み込む
-                std::size_t size = file.read(buf + 2, PAYLOAD_SIZE);
-
-                // SEQ付与
-                buf[0] = seq & 0xff;
-                buf[1] = seq >> 8;
-
-                // 値をセット
-                gCharDataRaw->setValue(buf, size + 2);
-
-                // 送信
-                while (!gCharDataRaw->notify()) {
-                    taskYIELD();
-                }
-
-                seq += 1;
-            }
+        std::uint32_t offset = 0;
+        if (cmd.type == RawCtrlCommand::Type::RESUME) {
+            offset = std::min(cmd.offset, totalSize);
+            file.seek(offset);
+        }
 
-            // ACK待ち
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // 前回の転送の残りのACKと通知を捨てる（シーケンス番号は転送ごとに0から）
+        gQueueDataAck.reset();
+        shark::os::takeNotify(0);
 
-            // ACK反映
-            std::uint16_t ack;
-            while (xQueueReceive(gQueueDataAck, &ack, 0) == pdTRUE) {
-                if (ack >= lastAck) {
-                    lastAck = ack + 1;  // ← 次に送るべき位置
-                }
-            }
+        // MTUに収まる長さで送る
+        const std::uint16_t payloadSize = rawPayloadSize(gMtu.load());
+        trace(TraceEvent::RAW_SEND_STARTED,
+              totalSize - offset, rawNumPackets(totalSize - offset, payloadSize));
+        const std::uint32_t tStart = shark::os::millis();
 
-            // 中断チェック
-            if (uxQueueMessagesWaiting(gQueueDataTrans)) {
-                debugMsg(F("raw data sending aborted"));
-                break;
-            }
-        }
+        beginBulkTransfer();
+        RawDataPort port(file);
+        const auto outcome = RawSender::run(port, totalSize - offset, payloadSize);
         file.close();
+        const std::uint32_t elapsed = shark::os::millis() - tStart;
+        endBulkTransfer();
+
+        // 結果を残す（RAW_CTRL の読み出しで返す）
+        std::uint32_t goodput;
+        {
+            shark::Lock lock(gMutexRawReport);
+            gRawReport.record(outcome, elapsed);
+            gRawReport.interval = gConnInterval.load();
+            gRawReport.dataLength = gDataLength.load();
+            gRawReport.phy = gPhy.load();
+            goodput = gRawReport.goodput;
+        }
 
-        debugMsg(F("data sending completed"));
+        if (outcome.status != RawSender::Status::DONE) {
+            trace(TraceEvent::RAW_SEND_ABORTED, outcome.sent);
+        }
+        trace(TraceEvent::RAW_SEND_DONE, outcome.sent, elapsed);
+        trace(TraceEvent::RAW_SEND_RATE, goodput, gConnInterval.load());
     }
-    // タスク終了処理
-    vTaskDelete(nullptr);
 }
 
-//-----------------------------------------------------------------------------
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う場合
-//-----------------------------------------------------------------------------
-
-// モーター制御：マニュアルモード
-void taskMotorManual(void* pvParams)
-{
-    // モーターIDの取得
-    auto id = *(static_cast<std::uint32_t*>(pvParams));
-
-    // 回転開始
-    const auto& elr = ATLAS.params.elr(id);
-    ATLAS.motors[id].rotate(elr.sp(), elr.isRight());
-
-    // SHOOT号令待機
-    xEventGroupWaitBits(
-        gEventGroup,
-        BIT_SHOOT,
-        pdTRUE,
-        pdTRUE,
-        portMAX_DELAY
-    );
-
-    // 射出
-    ATLAS.motors[id].stop();
-
-    // タスク終了処理
-    vTaskDelete(nullptr);
-}
-
-//-----------------------------------------------------------------------------
-#endif  // #if ATLAS_FORMAT == ATLAS_FULL_SPEC
-//-----------------------------------------------------------------------------
-
 //=============================================================================
 //
 // コールバック
@@ -203,6 +243,13 @@ class ServerCallbacks
     ) override {
         debugMsg(F("client connected"));
 
+        // MTU交換の前の値・接続時の接続パラメータ
+        gMtu.store(connInfo.getMTU());
+        gConnHandle.store(connInfo.getConnHandle());
+        gConnInterval.store(connInfo.getConnInterval());
+        gPhy.store(BLE_GAP_LE_PHY_1M);
+        gDataLength.store(27);  // Data Length Extension の前の値
+
         // ACK音を鳴らす
         ATLAS.player.play(AUDIO_SE_ACK);
         // クライアントが接続された
@@ -219,6 +266,15 @@ class ServerCallbacks
     ) override {
         debugMsg(F("client disconnected"));
 
+        // 送信中の生データ転送を止める（ACKを待ったまま残らないように起こす）
+        gNotifyEnabled.store(false);
+        gTaskDataTrans.notify();
+
+#if ATLAS_TRACE
+        // トレースはシリアルに戻す
+        Trace::setSink(nullptr);
+#endif
+
         // キャンセル音を鳴らす
         ATLAS.player.play(AUDIO_SE_CANCEL);
         // クライアントが切断された
@@ -228,7 +284,39 @@ class ServerCallbacks
         // 再アドバタイズ
         server->startAdvertising();
     }
+
+    // MTU交換時
+    void onMTUChange(std::uint16_t mtu, NimBLEConnInfo& connInfo) override {
+        gMtu.store(mtu);
+    }
+
+    // 接続パラメータの更新時
+    void onConnParamsUpdate(NimBLEConnInfo& connInfo) override {
+        gConnInterval.store(connInfo.getConnInterval());
+    }
+
+    // PHYの更新時
+    void onPhyUpdate(NimBLEConnInfo& connInfo, std::uint8_t txPhy, std::uint8_t rxPhy) override {
+        gPhy.store(txPhy);
+    }
 };
+static ServerCallbacks gServerCallbacks;
+
+/*
+    GAPイベント（NimBLEServerCallbacks に無いものだけを見る）
+
+    Data Length Extension の結果は NimBLEServerCallbacks で知らされないので、
+    ホストのイベントのリスナーで受け取る。
+*/
+static int onGapEvent(ble_gap_event* event, void* arg)
+{
+    if (event->type == BLE_GAP_EVENT_DATA_LEN_CHG &&
+        event->data_len_chg.conn_handle == gConnHandle.load()
+    ) {
+        gDataLength.store(event->data_len_chg.max_tx_octets);
+    }
+    return 0;
+}
 
 // デバイス情報
 class DevInfoCallbacks
@@ -239,6 +327,80 @@ class DevInfoCallbacks
         ch->setValue(DEVICE_INFO);
     }
 };
+static DevInfoCallbacks gDevInfoCallbacks;
+
+// ヒープ使用状況
+class HeapInfoCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onRead(NimBLECharacteristic* ch, NimBLEConnInfo& conn_info) override {
+        debugMsg(F("read heap info"));
+        ch->setValue(ATLAS.heap.report());
+    }
+};
+static HeapInfoCallbacks gHeapInfoCallbacks;
+
+// 描画の計測結果
+class RenderStatsCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onRead(NimBLECharacteristic* ch, NimBLEConnInfo& conn_info) override {
+        debugMsg(F("read render stats"));
+        ch->setValue(ATLAS.view.renderStats());
+    }
+};
+static RenderStatsCallbacks gRenderStatsCallbacks;
+
+// 遅延の計測結果（書き込みで消去）
+class LatencyCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onRead(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        debugMsg(F("read latency report"));
+        ch->setValue(ATLAS.latency.report());
+    }
+
+    void onWrite(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        debugMsg(F("clear latency report"));
+        ATLAS.latency.clear();
+    }
+};
+static LatencyCallbacks gLatencyCallbacks;
+
+// 起動の段階ごとの時刻
+class BootCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onRead(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        debugMsg(F("read boot report"));
+        ch->setValue(ATLAS.boot.report());
+    }
+};
+static BootCallbacks gBootCallbacks;
+
+#if ATLAS_TRACE
+// トレースをBLEの通知で送る（送り出しタスクから呼ばれる）
+static bool traceSink(const std::uint8_t* data, std::size_t size)
+{
+    gCharTrace->setValue(data, size);
+    return gCharTrace->notify();
+}
+
+// トレースの送り出し先
+class TraceCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onSubscribe(
+        NimBLECharacteristic* ch,
+        NimBLEConnInfo& connInfo,
+        std::uint16_t subValue
+    ) override {
+        // 購読中はBLE、それ以外はシリアルに送る
+        Trace::setSink((subValue & 0x0001) ? traceSink : nullptr);
+    }
+};
+static TraceCallbacks gTraceCallbacks;
+#endif
 
 // パラメータの読み書き
 class ParamsCallbacks
@@ -255,8 +417,13 @@ class ParamsCallbacks
     void onWrite(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
         debugMsg(F("write parameters"));
 
-        // コピー
+        // コピー（同期調整時間は本体で較正した値を保持する）
+        const auto syncAdj = ATLAS.params.syncAdj();
         ATLAS.params = ch->getValue<Params>();
+        if (!ATLAS.params.hasSyncAdj()) {
+            // 予約領域を0で送るクライアントからの書き込み（0を書き込むならビットを立てる）
+            ATLAS.params.setSyncAdj(syncAdj);
+        }
 
         // パラメータの正規化
         ATLAS.params.regulate();
@@ -274,6 +441,7 @@ class ParamsCallbacks
         }
     }
 };
+static ParamsCallbacks gParamsCallbacks;
 
 // 結果関連
 class ResultCallbacks
@@ -311,6 +479,7 @@ class ResultCallbacks
         }
     }
 };
+static ResultCallbacks gResultCallbacks;
 
 // 生データの読み出し制御
 class RawCtrlCallbacks
@@ -325,31 +494,38 @@ class RawCtrlCallbacks
             size = static_cast<std::uint32_t>(file.size());
             file.close();
         }
-        ch->setValue(size);
+
+        // 直前の転送の結果を続けて返す
+        RawTransferReport report;
+        {
+            shark::Lock lock(gMutexRawReport);
+            report = gRawReport;
+        }
+        report.size = size;
+        ch->setValue(report);
     }
 
     void onWrite(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
-        auto cmd = ch->getValue();
-
-        // cmdが2バイトならACK処理
-        if (cmd.length() == 2) {
-            std::uint16_t ack =
-                static_cast<std::uint16_t>(cmd[0]) |
-                static_cast<std::uint16_t>(cmd[1]) << 8;
-
-            xQueueSend(gQueueDataAck, &ack, 0);
-
-            if (gHandleTaskDataTrans) {
-                xTaskNotifyGive(gHandleTaskDataTrans);
-            }
-            return;
+        auto value = ch->getValue();
+        const auto cmd = RawCtrlCommand::decode(value.data(), value.length());
+
+        switch (cmd.type) {
+        case RawCtrlCommand::Type::ACK:
+            gQueueDataAck.send(cmd.seq);
+            gTaskDataTrans.notify();
+            break;
+        case RawCtrlCommand::Type::START:
+        case RawCtrlCommand::Type::RESUME:
+            debugMsg(F("start notify raw data"));
+            gQueueDataTrans.send(cmd);
+            gTaskDataTrans.notify();    // 送信中なら中断させる
+            break;
+        default:
+            break;
         }
-
-        debugMsg(F("start notify raw data"));
-        std::uint8_t ctrl = static_cast<std::uint16_t>(cmd[0]);
-        xQueueSend(gQueueDataTrans, &ctrl, 0);
     }
 };
+static RawCtrlCallbacks gRawCtrlCallbacks;
 
 // 生データの読み出し購読
 class RawDataCallbacks
@@ -370,6 +546,7 @@ class RawDataCallbacks
         }
     }
 };
+static RawDataCallbacks gRawDataCallbacks;
 
 //-----------------------------------------------------------------------------
 #if ATLAS_FORMAT == ATLAS_FULL_SPEC  // 電動ランチャー制御として使う
@@ -382,32 +559,80 @@ class ManualShootCallbacks
     void onWrite(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
         debugMsg(F("launch beyblade"));
 
-        // モータータスクの投入
-        char taskname[14];
-        for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
-            if (!ATLAS.params.elr(i).enabledManual()) continue;
-
-            // タスク名
-            std::sprintf(taskname, "taskMotor_m%lu", i+1);
-
-            // タスクの投入
-            xTaskCreate(
-                taskMotorManual, // タスク
-                taskname,        // タスク名
-                4096,            // スタックメモリ
-                &i,              // 起動パラメータ（モーターID）
-                3,               // 優先度（値が大きいほど優先順位が高い）
-                nullptr          // タスクハンドル
-            );
+        // 射出シーケンサーに射出指令を送る
+        ATLAS.boot.mark(BootStage::FIRST_LAUNCH);
+        ATLAS.launcher.post(LaunchCommand::MANUAL_SHOOT);
+    }
+};
+static ManualShootCallbacks gManualShootCallbacks;
+
+// 射出タイミングの計測結果
+class LaunchTimingCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onRead(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        debugMsg(F("read launch timing"));
+        ch->setValue(ATLAS.launcher.timing());
+    }
+};
+static LaunchTimingCallbacks gLaunchTimingCallbacks;
+
+// SP較正表の読み書き
+class CalibrationCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onRead(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        debugMsg(F("read calibration"));
+        ch->setValue(ATLAS.calib);
+    }
+
+    void onWrite(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        auto value = ch->getValue();
+
+        // 全体の書き込み
+        if (value.length() == sizeof(MotorCalibration)) {
+            debugMsg(F("write calibration"));
+            ATLAS.calib = ch->getValue<MotorCalibration>();
+            ATLAS.calib.regulate();
+        }
+        // 1バイトならリセット（0xFFは全モーター）
+        else if (value.length() == 1) {
+            debugMsg(F("reset calibration"));
+            if (value[0] == 0xFF) {
+                ATLAS.calib.initialize();
+            }
+            else {
+                ATLAS.calib.reset(value[0]);
+            }
+        }
+        else {
+            return;
         }
 
-        // 待機
-        vTaskDelay(pdMS_TO_TICKS(MOTOR_PREPARATORY_TIME));
+        // ACK音
+        ATLAS.player.play(AUDIO_SE_ACK);
+
+        // 較正表をファイルに保存する
+        if (File file = SPIFFS.open(CALIB_FPATH, "w")) {
+            writeFile(file, ATLAS.calib);
+            file.close();
+        }
+    }
+};
+static CalibrationCallbacks gCalibrationCallbacks;
+
+// 音声の同期調整時間の較正指令
+class SyncCalibrationCallbacks
+    : public NimBLECharacteristicCallbacks
+{
+    void onWrite(NimBLECharacteristic* ch, NimBLEConnInfo& connInfo) override {
+        debugMsg(F("calibrate audio sync"));
 
-        // Shoot!のタイミングを全体通知
-        xEventGroupSetBits(gEventGroup, BIT_SHOOT);
+        // 射出シーケンサーに較正指令を送る（結果はパラメータに保存される）
+        ATLAS.launcher.post(LaunchCommand::SYNC_CALIBRATE);
     }
 };
+static SyncCalibrationCallbacks gSyncCalibrationCallbacks;
 
 //-----------------------------------------------------------------------------
 #endif  // #if ATLAS_FORMAT == ATLAS_FULL_SPEC
@@ -426,6 +651,7 @@ class ModeSwitchCallbacks
         ATLAS.setMode(true);
     }
 };
+static ModeSwitchCallbacks gModeSwitchCallbacks;
 
 //-----------------------------------------------------------------------------
 #endif
@@ -444,11 +670,6 @@ void runManualMode()
     // 状態のクリア
     ATLAS.state.clear();
 
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC
-    // イベントグループの作成
-    gEventGroup = xEventGroupCreate();
-#endif
-
     // BLE初期化
     NimBLEDevice::init(ATLAS_LOCAL_NAME);
     NimBLEDevice::setMTU(ATLAS_MTU_SIZE);
@@ -462,22 +683,59 @@ void runManualMode()
     // コールバックの登録
     //-------------------------------------------------------------------------
     // サーバー
-    gServer->setCallbacks(new ServerCallbacks);
+    gServer->setCallbacks(&gServerCallbacks, false);
 
     // デバイス情報
     NimBLECharacteristic* charDevInfo = gService->createCharacteristic(
         ATLAS_CHR_DEVINFO,
         NIMBLE_PROPERTY::READ
     );
-    charDevInfo->setCallbacks(new DevInfoCallbacks);
+    charDevInfo->setCallbacks(&gDevInfoCallbacks);
     charDevInfo->setValue(DEVICE_INFO);
 
+    // ヒープ使用状況
+    NimBLECharacteristic* charHeapInfo = gService->createCharacteristic(
+        ATLAS_CHR_HEAPINFO,
+        NIMBLE_PROPERTY::READ
+    );
+    charHeapInfo->setCallbacks(&gHeapInfoCallbacks);
+
+    // 描画の計測結果
+    NimBLECharacteristic* charRenderStats = gService->createCharacteristic(
+        ATLAS_CHR_RENDER,
+        NIMBLE_PROPERTY::READ
+    );
+    charRenderStats->setCallbacks(&gRenderStatsCallbacks);
+
+    // 遅延の計測結果
+    NimBLECharacteristic* charLatency = gService->createCharacteristic(
+        ATLAS_CHR_LATENCY,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE
+    );
+    charLatency->setCallbacks(&gLatencyCallbacks);
+
+    // 起動の段階ごとの時刻
+    NimBLECharacteristic* charBoot = gService->createCharacteristic(
+        ATLAS_CHR_BOOT,
+        NIMBLE_PROPERTY::READ
+    );
+    charBoot->setCallbacks(&gBootCallbacks);
+
+#if ATLAS_TRACE
+    // トレース
+    gCharTrace = gService->createCharacteristic(
+        ATLAS_CHR_TRACE,
+        NIMBLE_PROPERTY::NOTIFY
+    );
+    gCharTrace->setCallbacks(&gTraceCallbacks);
+#endif
+
     // パラメータ読み書き
     NimBLECharacteristic* charParams = gService->createCharacteristic(
         ATLAS_CHR_PARAMS,
         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE
     );
-    charParams->setCallbacks(new ParamsCallbacks);
+    charParams->setCallbacks(&gParamsCallbacks);
     charParams->setValue(ATLAS.params);
 
     // 解析結果
@@ -485,7 +743,7 @@ void runManualMode()
         ATLAS_CHR_RESULT,
         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE
     );
-    charResult->setCallbacks(new ResultCallbacks);
+    charResult->setCallbacks(&gResultCallbacks);
     charResult->setValue(ATLAS.result);
 
     // 生データ制御
@@ -493,7 +751,7 @@ void runManualMode()
         ATLAS_CHR_RAW_CTRL,
         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE
     );
-    charStatsCtrl->setCallbacks(new RawCtrlCallbacks);
+    charStatsCtrl->setCallbacks(&gRawCtrlCallbacks);
     charStatsCtrl->setValue(0);
 
     // 生データ取得
@@ -501,7 +759,7 @@ void runManualMode()
         ATLAS_CHR_RAW_DATA,
         NIMBLE_PROPERTY::NOTIFY
     );
-    gCharDataRaw->setCallbacks(new RawDataCallbacks);
+    gCharDataRaw->setCallbacks(&gRawDataCallbacks);
 
 #if ATLAS_FORMAT == ATLAS_FULL_SPEC
     // 手動射出
@@ -509,7 +767,28 @@ void runManualMode()
         ATLAS_CHR_SHOOT,
         NIMBLE_PROPERTY::WRITE
     );
-    charManualShoot->setCallbacks(new ManualShootCallbacks);
+    charManualShoot->setCallbacks(&gManualShootCallbacks);
+
+    // 射出タイミングの計測結果
+    NimBLECharacteristic* charLaunchTiming = gService->createCharacteristic(
+        ATLAS_CHR_LAUNCH,
+        NIMBLE_PROPERTY::READ
+    );
+    charLaunchTiming->setCallbacks(&gLaunchTimingCallbacks);
+
+    // SP較正表
+    NimBLECharacteristic* charCalib = gService->createCharacteristic(
+        ATLAS_CHR_CALIB,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE
+    );
+    charCalib->setCallbacks(&gCalibrationCallbacks);
+
+    // 音声の同期調整時間の較正
+    NimBLECharacteristic* charSync = gService->createCharacteristic(
+        ATLAS_CHR_SYNC,
+        NIMBLE_PROPERTY::WRITE
+    );
+    charSync->setCallbacks(&gSyncCalibrationCallbacks);
 #endif
 
 #if SWITCH_TYPE != SW_SLIDE  // スライドスイッチ以外
@@ -518,7 +797,7 @@ void runManualMode()
         ATLAS_CHR_SWITCH,
         NIMBLE_PROPERTY::WRITE
     );
-    charModeSwitch->setCallbacks(new ModeSwitchCallbacks);
+    charModeSwitch->setCallbacks(&gModeSwitchCallbacks);
 #endif
 
     //-------------------------------------------------------------------------
@@ -528,6 +807,9 @@ void runManualMode()
     // サービス開始
     gService->start();
 
+    // LLの最大ペイロードの変更を受け取る
+    ble_gap_event_listener_register(&gGapListener, onGapEvent, nullptr);
+
     // アドバタイズ開始
     NimBLEAdvertising* advertising = NimBLEDevice::getAdvertising();
     advertising->addServiceUUID(ATLAS_SERVICE);
@@ -535,17 +817,18 @@ void runManualMode()
     advertising->setName(ATLAS_LOCAL_NAME);
     advertising->start();
 
-    // データ転送タスク起動
-    gQueueDataAck = xQueueCreate(10, sizeof(std::uint16_t));
-    gQueueDataTrans = xQueueCreate(4, sizeof(std::uint8_t));
-    xTaskCreate(
-        taskDataTrans,
-        "taskDataTrans",
-        4096,
-        nullptr,
-        1,
-        &gHandleTaskDataTrans
-    );
+    // データ転送タスク起動（初回のみ、静的領域に確保して常駐させる）
+    if (!gTaskDataTrans.isCreated()) {
+        gRawReport.clear();
+        gQueueDataAck.begin();
+        gQueueDataTrans.begin();
+        gTaskDataTrans.start(taskDataTrans, "taskDataTrans", nullptr, 1);
+    }
+    else {
+        // 前回のセッションの残りを破棄する
+        gQueueDataAck.reset();
+        gQueueDataTrans.reset();
+    }
 
     debugMsg(F("[manual/setting mode] BLE advertising started"));
 
@@ -566,13 +849,17 @@ void runManualMode()
     // 終了処理
     //-------------------------------------------------------------------------
 
-    // 終了処理
-    NimBLEDevice::deinit(true);
-
-#if ATLAS_FORMAT == ATLAS_FULL_SPEC
-    // イベントグループの削除
-    vEventGroupDelete(gEventGroup);
+    // 送信中の生データ転送を止めて、終わるまで待つ（NimBLEの終了後に通知しないように）
+    gNotifyEnabled.store(false);
+    gTaskDataTrans.notify();
+    {
+        shark::Lock transfer(gMutexTransfer);
+    }
+#if ATLAS_TRACE
+    Trace::setSink(nullptr);    // 送り出し中の通知が終わってから終了する
 #endif
+    ble_gap_event_listener_unregister(&gGapListener);
+    NimBLEDevice::deinit(true);
 
     debugMsg(F("[manual/setting mode] out"));
 }
@@ -0,0 +1,199 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "motor_calibration.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min, std::max, std::clamp
+#include <cstdlib>      // std::abs
+
+// ATLAS
+#include "setting.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// 補間の固定小数点（1.0 = 256）
+constexpr std::int32_t CALIB_ONE = 256;
+
+// 学習率の下限（1/CALIB_MIN_RATE）
+constexpr std::int32_t CALIB_MIN_RATE = 8;
+
+// 隣り合う点のデューティ比の差
+constexpr std::int32_t CALIB_STEP = 16;
+
+// 外れ値とみなす予測値からのずれ（予測値に対する割合の逆数）
+constexpr std::int32_t CALIB_OUTLIER_RATIO = 2;
+
+// モーターの最大回転数
+constexpr std::uint32_t maxRPM(std::uint32_t motor)
+{
+    return motor == 0 ? MOTOR1_MAX_RPM : MOTOR2_MAX_RPM;
+}
+
+} // namespace
+
+std::uint8_t MotorCalibration::duty(std::uint32_t motor, std::uint32_t sp) const noexcept
+{
+    if (motor >= MAX_MOTORS) {
+        return 1;
+    }
+    const auto& table = _tables[motor];
+    constexpr std::uint32_t N = CalibrationTable::NUM_POINTS;
+
+    // 最初の点より下は原点との間を線形補間する
+    if (sp <= table.sp[0]) {
+        const std::int32_t s0 = std::max<std::int32_t>(table.sp[0], 1);
+        const std::int32_t d0 = CalibrationTable::dutyAt(0);
+        const std::int32_t d = (static_cast<std::int32_t>(sp) * d0 + s0 / 2) / s0;
+        return static_cast<std::uint8_t>(std::max<std::int32_t>(d, 1));
+    }
+
+    // 最後の点を超えるときは最大のデューティ比
+    if (sp >= table.sp[N-1]) {
+        return 255;
+    }
+
+    // 目標SPを挟む2点の間を逆補間する
+    std::uint32_t i = 1;
+    while (table.sp[i] < sp) {
+        ++i;
+    }
+    const std::int32_t s0 = table.sp[i-1];
+    const std::int32_t ds = table.sp[i] - s0;
+    if (ds == 0) {
+        return static_cast<std::uint8_t>(CalibrationTable::dutyAt(i));
+    }
+    const std::int32_t t = ((static_cast<std::int32_t>(sp) - s0) * CALIB_ONE) / ds;
+    const std::int32_t d = CalibrationTable::dutyAt(i-1)
+                         + (CALIB_STEP * t + CALIB_ONE / 2) / CALIB_ONE;
+    return static_cast<std::uint8_t>(std::min<std::int32_t>(d, 255));
+}
+
+std::uint32_t MotorCalibration::sp(std::uint32_t motor, std::uint32_t duty) const noexcept
+{
+    if (motor >= MAX_MOTORS) {
+        return 0;
+    }
+    const auto& table = _tables[motor];
+    constexpr std::uint32_t N = CalibrationTable::NUM_POINTS;
+    constexpr std::uint32_t d0 = CalibrationTable::dutyAt(0);
+
+    // 最初の点より下は原点との間を線形補間する
+    if (duty <= d0) {
+        return (table.sp[0] * duty + d0 / 2) / d0;
+    }
+
+    const std::uint32_t i = (duty - d0) / CALIB_STEP;
+    if (i >= N - 1) {
+        return table.sp[N-1];
+    }
+    const std::int32_t frac = (duty - d0) % CALIB_STEP;
+    const std::int32_t s0 = table.sp[i];
+    const std::int32_t ds = table.sp[i+1] - s0;
+    return static_cast<std::uint32_t>(s0 + (ds * frac + CALIB_STEP / 2) / CALIB_STEP);
+}
+
+bool MotorCalibration::learn(
+    std::uint32_t motor,
+    std::uint32_t duty,
+    std::uint32_t measured
+) noexcept
+{
+    constexpr std::uint32_t N = CalibrationTable::NUM_POINTS;
+    constexpr std::uint32_t d0 = CalibrationTable::dutyAt(0);
+
+    // 最初の点より低いデューティ比は学習しない（SPの計測が安定しない）
+    if (motor >= MAX_MOTORS || duty < d0 || duty > 255) {
+        return false;
+    }
+    auto& table = _tables[motor];
+
+    // 外れ値（計測ミス・ベイの接触など）は捨てる
+    const std::int32_t predicted = static_cast<std::int32_t>(this->sp(motor, duty));
+    const std::int32_t residual = static_cast<std::int32_t>(measured) - predicted;
+    if (std::abs(residual) > predicted / CALIB_OUTLIER_RATIO) {
+        return false;
+    }
+
+    // 予測に使った2点に、補間の重みに応じて残差を配分する
+    const std::uint32_t i = std::min((duty - d0) / CALIB_STEP, N - 1);
+    const std::int32_t frac = i < N - 1 ? (duty - d0) % CALIB_STEP : 0;
+    const std::int32_t weights[2] = {CALIB_STEP - frac, frac};
+
+    for (std::uint32_t k = 0; k < 2; ++k) {
+        if (weights[k] == 0) {
+            continue;
+        }
+        const std::uint32_t j = i + k;
+
+        // 学習率は回数が少ないうちは大きく（単純平均）、以降は 1/8 で一定（指数移動平均）
+        const std::int32_t rate = std::min<std::int32_t>(table.count[j] + 1, CALIB_MIN_RATE);
+        const std::int32_t delta = residual * weights[k] / (CALIB_STEP * rate);
+        const std::int32_t value = table.sp[j] + delta;
+        table.sp[j] = static_cast<std::uint16_t>(std::clamp<std::int32_t>(value, 1, 0xFFFF));
+        if (table.count[j] < 0xFF) {
+            ++table.count[j];
+        }
+    }
+
+    this->regulate();
+    return true;
+}
+
+std::uint32_t MotorCalibration::samples(std::uint32_t motor) const noexcept
+{
+    if (motor >= MAX_MOTORS) {
+        return 0;
+    }
+    std::uint32_t total = 0;
+    for (auto count : _tables[motor].count) {
+        total += count;
+    }
+    return total;
+}
+
+void MotorCalibration::reset(std::uint32_t motor) noexcept
+{
+    if (motor >= MAX_MOTORS) {
+        return;
+    }
+    auto& table = _tables[motor];
+
+    // MotorDriver のSP → デューティ比の換算式の逆
+    for (std::uint32_t i = 0; i < CalibrationTable::NUM_POINTS; ++i) {
+        table.sp[i] = static_cast<std::uint16_t>(
+            CalibrationTable::dutyAt(i) * maxRPM(motor) / 256 + 1
+        );
+        table.count[i] = 0;
+    }
+}
+
+void MotorCalibration::regulate() noexcept
+{
+    for (auto& table : _tables) {
+        // 0除算を避ける
+        if (table.sp[0] == 0) {
+            table.sp[0] = 1;
+        }
+        // デューティ比に対して単調増加（広義）にする
+        for (std::uint32_t i = 1; i < CalibrationTable::NUM_POINTS; ++i) {
+            if (table.sp[i] < table.sp[i-1]) {
+                table.sp[i] = table.sp[i-1];
+            }
+        }
+    }
+}
+
+void MotorCalibration::initialize() noexcept
+{
+    for (std::uint32_t motor = 0; motor < MAX_MOTORS; ++motor) {
+        this->reset(motor);
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
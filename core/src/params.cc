@@ -85,6 +85,28 @@ MainSPView Params::mainSPView() const noexcept
     return static_cast<MainSPView>(_flags.mainSP);
 }
 
+// オートモードの同期調整時間 [ms]を返す
+std::uint16_t Params::syncAdj() const noexcept
+{
+    return static_cast<std::uint16_t>(_flags.syncAdj) * 2;
+}
+
+// オートモードの同期調整時間 [ms]を設定する
+void Params::setSyncAdj(std::uint16_t ms) noexcept
+{
+    if (ms > SYNC_ADJ_UPPER_LIMIT) {
+        ms = SYNC_ADJ_UPPER_LIMIT;
+    }
+    _flags.syncAdj = (ms + 1) / 2;
+    _flags.syncAdjValid = 1;
+}
+
+// 書き込みで同期調整時間を上書きするかどうかを返す
+bool Params::hasSyncAdj() const noexcept
+{
+    return _flags.syncAdjValid;
+}
+
 // 値を適正化する
 void Params::regulate() noexcept
 {
@@ -104,6 +126,11 @@ void Params::regulate() noexcept
     if (this->delay() > DELAY_UPPER_LIMIT) {
         _delay = DELAY_UPPER_LIMIT / 2;
     }
+
+    // 同期調整時間
+    if (this->syncAdj() > SYNC_ADJ_UPPER_LIMIT) {
+        _flags.syncAdj = SYNC_ADJ_UPPER_LIMIT / 2;
+    }
 }
 
 // 値を初期化する
@@ -113,6 +140,9 @@ void Params::initialize() noexcept
     _delay = DEFAULT_DELAY / 2;
     _flags.elrAutoMode = 0;
     _flags.mainSP = 0;
+    _flags.syncAdj = DEFAULT_SYNC_ADJ / 2;
+    _flags.syncAdjValid = 1;
+    _flags.reserved = 0;
     _elr1.initialize();
     _elr2.initialize();
 }
@@ -4,17 +4,29 @@
 */
 #include "result.hh"
 
-#include <Arduino.h>
+// C++標準ライブラリ
+#include <cmath>    // std::isnan
 
 namespace atlas {
 //-----------------------------------------------------------------------------
 
+// 実数を16ビット符号なし整数に飽和変換する（NaN, 負値は0）
+static std::uint16_t toUint16(double value)
+{
+    if (std::isnan(value) || value <= 0) return 0;
+    if (value >= 0xFFFF) return 0xFFFF;
+    return static_cast<std::uint16_t>(value);
+}
+
 static double calcAcc(
     const std::uint16_t* t,
     const std::uint16_t* sp,
     std::uint16_t iBegin,
     std::uint16_t iEnd
 ) {
+    // 回帰直線を引くには2点以上が必要
+    if (iEnd < iBegin + 2) return 0;
+
     const std::uint32_t N = iEnd - iBegin;
     std::uint32_t sumX = 0;
     std::uint32_t sumY = 0;
@@ -53,13 +65,15 @@ void Result::update(
 )
 {
     std::uint16_t evalSP = 0;
+    acc1 = 0;
+    acc2 = 0;
 
     //-------------------------------------------------------------------------
     // プロファイルのデコード
     //-------------------------------------------------------------------------
     std::uint16_t T[32];
     std::uint16_t SP[32];
-    std::uint16_t size;
+    std::uint16_t size = 0;
     // 経過時間
     std::uint16_t elapsedTime = 0;
 
@@ -77,7 +91,7 @@ void Result::update(
         auto dt = static_cast<double>(nRefs) / 125;
 
         // ランチャーの回転数（シュートパワー）[rpm], 60000 は ms->min の変換
-        auto sp = static_cast<std::uint16_t>(60000 / dt);
+        auto sp = toUint16(60000 / dt);
 
         // その回転が終了したときの、ランチャー引き始めからの時間t [ms]
         elapsedTime += static_cast<std::uint16_t>(dt);
@@ -155,7 +169,7 @@ void Result::update(
 
                     // P2'から傾き a で延長したときの、ピーク位置 P1' における期待SP値の計算
                     // 念のため、4%の安全係数を掛けておく
-                    std::uint16_t extSP = 1.04 * ( a * (T[i-1] - t_m2) + sp_m2);
+                    std::uint16_t extSP = toUint16(1.04 * ( a * (T[i-1] - t_m2) + sp_m2));
 
                     // 期待値を超える SP が P1' で記録されている場合は、異常値の可能性が高い
                     if ((extSP < sp_m1) && (i >= MAX_PEAK_LENGTH)) {
@@ -193,10 +207,12 @@ void Result::update(
         //---------------------------------------------------------------------
         // 加速度データの計算
         //---------------------------------------------------------------------
-        double a1 = calcAcc(T, SP, 1, peakIndex - 3);
-        double a2 = calcAcc(T, SP, peakIndex - 3, peakIndex + 1);
-        acc1 = a1 >= 0 ? static_cast<std::uint16_t>(a1) : 0;
-        acc2 = a1 >= 0 ? static_cast<std::uint16_t>(a2) : 0;
+        // ピーク位置が3未満でもアンダーフローしないようにする
+        const std::uint16_t iMid = peakIndex >= 3 ? peakIndex - 3 : 0;
+        double a1 = calcAcc(T, SP, 1, iMid);
+        double a2 = calcAcc(T, SP, iMid, peakIndex + 1);
+        acc1 = a1 >= 0 ? toUint16(a1) : 0;
+        acc2 = a1 >= 0 ? toUint16(a2) : 0;
     }
 
     //-------------------------------------------------------------------------
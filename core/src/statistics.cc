@@ -8,9 +8,6 @@
 #include <cmath>       // std::sqrt
 #include <algorithm>   // std::max, std::min
 
-#include <Arduino.h>
-
-
 namespace atlas {
 //-----------------------------------------------------------------------------
 
@@ -59,7 +56,7 @@ void Statistics::update(std::uint16_t sp) noexcept
 
     // SP合計
     _sumSP  += sp;
-    _sumSP2 += sp * sp;
+    _sumSP2 += static_cast<std::uint64_t>(sp) * sp;
 
     // 平均SP
     double mean = _sumSP / static_cast<double>(this->total);
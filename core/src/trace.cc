@@ -0,0 +1,164 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "trace.hh"
+
+//-----------------------------------------------------------------------------
+#if ATLAS_TRACE
+//-----------------------------------------------------------------------------
+
+// C++標準ライブラリ
+#include <atomic>       // std::atomic
+#include <cstring>      // std::memcpy
+
+// Arduino
+#include <Arduino.h>
+
+// shark lib
+#include "lock.hh"
+#include "os.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0,
+              "TRACE_BUFFER_SIZE must be a power of 2");
+
+// 送り出しタスクのスタックサイズ [bytes]
+constexpr std::uint32_t STACK_TRACE = 2048;
+
+/*
+    リングバッファの1件
+
+    ready には書き込みを終えた記録の通し番号 + 1 が入る。送り出し側は
+    これが期待する番号になるまで読まない（書き込み途中の記録を送らない）。
+*/
+struct Slot
+{
+    TraceRecord record;
+    std::atomic<std::uint32_t> ready;
+};
+
+Slot gSlots[TRACE_BUFFER_SIZE];
+std::atomic<std::uint32_t> gHead{0};        // 次に確保する通し番号
+std::atomic<std::uint32_t> gTail{0};        // 次に送り出す通し番号
+std::atomic<std::uint32_t> gDropped{0};     // 捨てた記録の数
+shark::Mutex gMutexSink;                    // 送り出し中は送り出し先を変えない
+Trace::Sink gSink = nullptr;                // 送り出し先（nullptr ならシリアル）
+
+shark::os::StaticTask<STACK_TRACE> gTaskTrace;    // 送り出しタスク
+
+bool serialSink(const std::uint8_t* data, std::size_t size)
+{
+    return Serial.write(data, size) == size;
+}
+
+// 送り出しタスク
+void taskTrace(void* pvParams)
+{
+    std::uint8_t frame[sizeof(TraceFrameHeader)
+                       + TraceFrameHeader::MAX_RECORDS * sizeof(TraceRecord)];
+
+    std::uint32_t lastWake = shark::os::millis();
+    while (true) {
+        shark::os::delayUntil(lastWake, TRACE_DRAIN_MS);
+
+        // 書き込みを終えた記録を、フレームに収まる数ずつ送る
+        while (true) {
+            std::uint32_t tail = gTail.load(std::memory_order_relaxed);
+            std::uint8_t count = 0;
+            auto* records = frame + sizeof(TraceFrameHeader);
+            while (count < TraceFrameHeader::MAX_RECORDS) {
+                const Slot& slot = gSlots[tail & (TRACE_BUFFER_SIZE - 1)];
+                if (slot.ready.load(std::memory_order_acquire) != tail + 1) {
+                    break;
+                }
+                std::memcpy(records + count * sizeof(TraceRecord),
+                            &slot.record, sizeof(TraceRecord));
+                count += 1;
+                tail += 1;
+            }
+            if (count == 0) {
+                break;
+            }
+            gTail.store(tail, std::memory_order_release);
+
+            const TraceFrameHeader header {
+                .magic0  = TraceFrameHeader::MAGIC0,
+                .magic1  = TraceFrameHeader::MAGIC1,
+                .version = TraceFrameHeader::VERSION,
+                .count   = count,
+                .dropped = gDropped.load(std::memory_order_relaxed)
+            };
+            std::memcpy(frame, &header, sizeof(header));
+
+            const std::size_t size = sizeof(header) + count * sizeof(TraceRecord);
+            shark::Lock lock(gMutexSink);
+            if (!(gSink ? gSink : serialSink)(frame, size)) {
+                gDropped.fetch_add(count, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void Trace::begin()
+{
+    if (gTaskTrace.isCreated()) {
+        return;
+    }
+
+#if BUILD_TYPE == BUILD_RELEASE
+    // リリースビルドではシリアルを開いていない
+    Serial.begin(9600);
+#endif
+
+    // 最も低い優先度で動かす（他のタスクの実行を遅らせない）
+    gTaskTrace.start(
+        taskTrace,              // タスク
+        "taskTrace",            // タスク名
+        nullptr,                // 起動パラメータ
+        0                       // 優先度（値が大きいほど優先順位が高い）
+    );
+    push(TraceEvent::TRACE_STARTED, TRACE_BUFFER_SIZE, 0);
+}
+
+void Trace::push(TraceEvent event, std::uint32_t arg0, std::uint32_t arg1) noexcept
+{
+    // 空きがあれば通し番号を1つ確保する（満杯なら捨てて数える）
+    std::uint32_t seq = gHead.load(std::memory_order_relaxed);
+    do {
+        if (seq - gTail.load(std::memory_order_acquire) >= TRACE_BUFFER_SIZE) {
+            gDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } while (!gHead.compare_exchange_weak(seq, seq + 1, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+
+    Slot& slot = gSlots[seq & (TRACE_BUFFER_SIZE - 1)];
+    slot.record.time = static_cast<std::uint32_t>(shark::os::now());
+    slot.record.seq = static_cast<std::uint16_t>(seq);
+    slot.record.event = static_cast<std::uint8_t>(event);
+    slot.record.reserved = 0;
+    slot.record.arg0 = arg0;
+    slot.record.arg1 = arg1;
+    slot.ready.store(seq + 1, std::memory_order_release);
+}
+
+void Trace::setSink(Sink sink) noexcept
+{
+    // 送り出し中なら終わるまで待つ（BLEの終了前に呼べば、以後は通知しない）
+    shark::Lock lock(gMutexSink);
+    gSink = sink;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+
+//-----------------------------------------------------------------------------
+#endif  // #if ATLAS_TRACE
+//-----------------------------------------------------------------------------
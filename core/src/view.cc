@@ -5,11 +5,11 @@
 #include "view.hh"
 
 // C++標準ライブラリ
+#include <cmath>   // std::ceil
 #include <cstdio>  // std::snprintf
-#include <cstring> // std::strlen
+#include <cstring> // std::strlen, std::memcpy, std::memset, std::memcmp
 
 // Atlas lib
-#include "lock.hh"
 #include "image_number.hh"
 
 // Atlas
@@ -25,17 +25,49 @@ View::View()
 {
 }
 
-// スプラッシュスクリーン
-void View::splashScreen()
+void View::render(const Request& request)
 {
-    // ロック
-    shark::Lock lock(_mutex);
+    this->clear();              // 画面のクリア
+    this->applyTextColor();     // フォントカラー
 
-    // 画面のクリア
-    this->clear();
-    
+    switch (request.screen) {
+    case Screen::SPLASH:
+        this->_drawSplashScreen();
+        break;
+    case Screen::MANUAL_STANDBY:
+        this->_drawManualModeStandby();
+        break;
+    case Screen::AUTO_STANDBY:
+        this->_drawAutoModeStandby();
+        break;
+    case Screen::AUTO_ERROR:
+        this->_drawAutoModeError();
+        break;
+    case Screen::AUTO_ABORTED:
+        this->_drawAutoModeAborted();
+        break;
+    case Screen::AUTO_PROMOTION:
+        this->_drawAutoModePromotion();
+        break;
+    case Screen::AUTO_SP:
+        this->_drawAutoModeSP(request.acc1, request.acc2);
+        break;
+    case Screen::AUTO_COUNTDOWN:
+        this->_drawAutoModeCountdown(request.countdown);
+        break;
+    case Screen::NONE:
+        break;
+    }
+}
+
+//=============================================================================
+// スプラッシュスクリーン
+//=============================================================================
+
+void View::_drawSplashScreen()
+{
     // さめ大臣のロゴ表示
-    this->image(26, 8, img::sharkMinisterLogo, 76, 52);
+    this->image(26, 8, img::sharkMinisterLogo);
 
     // バージョン表記
     this->applyTextColor();
@@ -47,9 +79,6 @@ void View::splashScreen()
         MAJOR_VERSION, MINOR_VERSION, REVISION
     );
     this->text(128-w, 0, 1, buf);
-
-    // 表示
-    this->show();
 }
 
 //=============================================================================
@@ -103,6 +132,36 @@ void View::_showHist()
 {
     // 表示するヒストグラムの取得
     const auto& hist = ATLAS.statistics().hist;
+    auto& cache = _histCache;
+
+    // 統計が変わったとき（表示する統計を切り替えたときを含む）だけ計算し直す
+    if (cache.source != &hist ||
+        std::memcmp(&cache.snapshot, &hist, sizeof(Histogram)) != 0
+    ) {
+        // 更新中に読んでも、写しと描画が食い違わないように写しから作る
+        cache.source = &hist;
+        cache.snapshot = hist;
+        this->_buildHistCache(cache.snapshot);
+    }
+    // 軸は描画済みのページを重ねる
+    else if (std::uint8_t* buf = this->buffer()) {
+        std::uint8_t* dst = buf + HistCache::AXIS_PAGE * SCREEN_WIDTH;
+        for (std::uint32_t i = 0; i < sizeof(cache.axis); ++i) {
+            dst[i] |= cache.axis[i];
+        }
+    }
+
+    // ヒストグラム
+    for (std::uint8_t k = 0; k < cache.numBars; ++k) {
+        const std::uint8_t h = cache.barH[k];
+        this->fillRect(cache.barX[k], 54-h, cache.barWidth, h);
+    }
+}
+
+void View::_buildHistCache(const Histogram& hist)
+{
+    auto& cache = _histCache;
+
     std::int16_t i0 = hist.minIndex;
     std::int16_t i1 = hist.maxIndex;
     if (hist.maxCount == 0 || i0 > i1) {
@@ -131,16 +190,25 @@ void View::_showHist()
     }
     const std::int16_t d = 120 / m;
 
+    // 軸のページを空にしてから描画し、描画結果を保存する
+    std::uint8_t* buf = this->buffer();
+    std::uint8_t* axis = buf ? buf + HistCache::AXIS_PAGE * SCREEN_WIDTH : nullptr;
+    std::uint8_t saved[sizeof(cache.axis)];
+    if (axis) {
+        std::memcpy(saved, axis, sizeof(saved));
+        std::memset(axis, 0, sizeof(saved));
+    }
+
     // 軸描画
     this->line(0, 54, 127, 54);
     std::int16_t xTicks = 4;
-    char buf[4];
+    char buf4[4];
     for (std::int16_t i = 0; i <= m; ++i) {
         // ticks
         this->line(xTicks, 55, xTicks, 55);
 
         // ticks label
-        const std::int16_t len = std::snprintf(buf, 4, "%d", L + i * step);
+        const std::int16_t len = std::snprintf(buf4, 4, "%d", L + i * step);
         std::int16_t xLabel;
         // 先頭
         if (i == 0) {
@@ -155,29 +223,40 @@ void View::_showHist()
             xLabel = xTicks - len * 3 + 1;
         }
         // テキスト
-        this->text(xLabel, 57, 1, buf);
+        this->text(xLabel, 57, 1, buf4);
 
         // next
         xTicks += d;
     }
 
-    // ヒストグラム
+    // 軸の描画結果を保存し、元の内容と重ねる
+    if (axis) {
+        std::memcpy(cache.axis, axis, sizeof(cache.axis));
+        for (std::uint32_t i = 0; i < sizeof(saved); ++i) {
+            axis[i] |= saved[i];
+        }
+    }
+
+    // 棒の位置と高さ
+    cache.numBars = 0;
     if (hist.maxCount > 0) {
-        std::int16_t w = d / (5 * step);
+        const std::int16_t w = d / (5 * step);
         std::int16_t x = 4 + w * (
             (L1000 - L * 1000) / HIST_BIN_WIDTH
         );
         for (std::int16_t i = i0; i <= i1; ++i) {
             if (auto v = hist.at(i)) {
-                auto h = static_cast<std::uint8_t>(
+                cache.barX[cache.numBars] = x;
+                cache.barH[cache.numBars] = static_cast<std::uint8_t>(
                     std::ceil(
                         static_cast<double>(v) / hist.maxCount * 42
                     )
                 );
-                this->fillRect(x, 54-h, w, h);
+                cache.numBars += 1;
             }
             x += w;
         }
+        cache.barWidth = w;
     }
 }
 
@@ -274,11 +353,8 @@ void View::_showDocumentInfo()
 //=============================================================================
 // マニュアルモード
 //=============================================================================
-void View::manualModeStandby()
+void View::_drawManualModeStandby()
 {
-    shark::Lock lock(_mutex);   // ロック
-    this->clear();              // 画面のクリア
-    this->applyTextColor();     // フォントカラー
     this->_manualModeHeader();  // ヘッダの表示
 
     switch (ATLAS.state.pageM()) {
@@ -303,9 +379,6 @@ void View::manualModeStandby()
         this->_showPageInfo("MANUAL");
         break;
     }
-
-    // 描画
-    this->show();
 }
 
 void View::_manualModeHeader()
@@ -339,43 +412,38 @@ void View::_manualModeHeader()
 // オートモード
 //=============================================================================
 
+//! カウントダウンの表示（圧縮した画像、または数字1桁）
 struct CountDownImage
 {
     constexpr CountDownImage(
         std::int16_t x_,
         std::int16_t y_,
-        const std::uint8_t* image_,
-        std::int16_t w_,
-        std::int16_t h_
+        const shark::PackedBitmap* image_,
+        std::uint8_t digit_
     )
         : x(x_)
         , y(y_)
         , image(image_)
-        , w(w_)
-        , h(h_)
+        , digit(digit_)
     {
     }
     std::int16_t x;
     std::int16_t y;
-    const std::uint8_t* image;
-    std::int16_t w;
-    std::int16_t h;
+    const shark::PackedBitmap* image;   //!< nullptr なら数字を表示
+    std::uint8_t digit;
 };
 
 constexpr CountDownImage countdown_images[6] = {
-    CountDownImage(36, 23, atlas::img::cndReadyset, 57, 29),
-    CountDownImage(55, 26, shark::digitW18_3, 18, 24),
-    CountDownImage(55, 26, shark::digitW18_2, 18, 24),
-    CountDownImage(55, 26, shark::digitW18_1, 18, 24),
-    CountDownImage(39, 26, atlas::img::cndGo, 50, 21),
-    CountDownImage(16, 26, atlas::img::cndShoot, 97, 21)
+    CountDownImage(36, 23, &atlas::img::cndReadyset, 0),
+    CountDownImage(55, 26, nullptr, 3),
+    CountDownImage(55, 26, nullptr, 2),
+    CountDownImage(55, 26, nullptr, 1),
+    CountDownImage(39, 26, &atlas::img::cndGo, 0),
+    CountDownImage(16, 26, &atlas::img::cndShoot, 0)
 };
 
-void View::autoModePromotion()
+void View::_drawAutoModePromotion()
 {
-    shark::Lock lock(_mutex);  // ロック
-    this->clear();             // 画面のクリア
-    this->applyTextColor();    // フォントカラー
     this->_autoModeHeader();   // ヘッダの表示
 
     /*
@@ -387,16 +455,10 @@ void View::autoModePromotion()
     this->text(4, 16, 1, "START YOUR PASS AND");
     this->text(4, 25, 1, "HOLD DOWN THE BUTTON");
     this->image(4, 36, img::promotion_BBP, 119, 22);
-
-    // 描画
-    this->show();
 }
 
-void View::autoModeStandby()
+void View::_drawAutoModeStandby()
 {
-    shark::Lock lock(_mutex);  // ロック
-    this->clear();             // 画面のクリア
-    this->applyTextColor();    // フォントカラー
     this->_autoModeHeader();   // ヘッダの表示
 
     switch (ATLAS.state.pageA()) {
@@ -413,47 +475,29 @@ void View::autoModeStandby()
         this->_showPageInfo("PARAMS");
         break;
     }
-
-    // 描画
-    this->show();
 }
 
-void View::autoModeError()
+void View::_drawAutoModeError()
 {
-    shark::Lock lock(_mutex);  // ロック
-    this->clear();             // 画面のクリア
-    this->applyTextColor();    // フォントカラー
     this->_autoModeHeader();   // ヘッダの表示
 
     // エラーの表示
     this->image(15, 26, img::crcError, 98, 26);
-
-    // 描画
-    this->show();
 }
 
-void View::autoModeAborted()
+void View::_drawAutoModeAborted()
 {
-    shark::Lock lock(_mutex);   // ロック
-    this->clear();              // 画面のクリア
-    this->applyTextColor();     // フォントカラー
     this->_autoModeHeader();    // ヘッダの表示
 
     // キャンセルの表示
-    this->image(18, 26, img::elrCanceled, 92, 26);
-
-    // 描画
-    this->show();
+    this->image(18, 26, img::elrCanceled);
 }
 
-void View::autoModeSP(
+void View::_drawAutoModeSP(
     std::uint16_t acc1,
     std::uint16_t acc2
 )
 {
-    shark::Lock lock(_mutex);  // ロック
-    this->clear();             // 画面のクリア
-    this->applyTextColor();    // フォントカラー
     this->_autoModeHeader();   // ヘッダの表示
 
     const std::uint16_t evalSP = ATLAS.result.statsEval.latestSP;
@@ -520,28 +564,19 @@ void View::autoModeSP(
     else {
         this->number(offset, 56, 1, acc2);
     }
-
-    // 描画
-    this->show();
 }
 
-void View::autoModeCountdown(int i)
+void View::_drawAutoModeCountdown(int i)
 {
-    shark::Lock lock(_mutex);  // ロック
-    this->clear();             // 画面のクリア
-    this->applyTextColor();    // フォントカラー
     this->_autoModeHeader();   // ヘッダの表示
 
-    this->image(
-        countdown_images[i].x,
-        countdown_images[i].y,
-        countdown_images[i].image,
-        countdown_images[i].w,
-        countdown_images[i].h
-    );
-
-    // 描画
-    this->show();
+    const auto& cd = countdown_images[i];
+    if (cd.image) {
+        this->image(cd.x, cd.y, *cd.image);
+    }
+    else {
+        this->numberW18(cd.x, cd.y, cd.digit);
+    }
 }
 
 void View::_autoModeHeader()
@@ -549,18 +584,21 @@ void View::_autoModeHeader()
     // モードアイコン
     this->image(0, 0, img::modeA, 14, 8);
 
+    // 状態は1度だけ読み出す（アイコンの組み合わせを一貫させる）
+    const auto state = ATLAS.state.snapshot();
+
     // バトルパス接続状態
-    if (ATLAS.state.isBBPReady()) {
+    if (state.isBBPReady()) {
         this->image(20, 0, img::bbpIcon, 10, 8);
     }
 
     // ベイの装着状態
-    if (ATLAS.state.isBeyReady()) {
+    if (state.isBeyReady()) {
         this->image(34, 0, img::beyIcon, 10, 8);
     }
 
     // 電動ランチャーの状態
-    if (ATLAS.state.isELREnabled()) {
+    if (state.isELREnabled()) {
         this->image(
             48, 0,
             ATLAS.params.autoModeELRIndex() == 0 ? img::elr1Icon : img::elr2Icon,
@@ -0,0 +1,175 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    画面表示の描画タスク
+
+    表示メソッドからの描画要求を受け取り、フレーム間隔ごとにまとめて描画・転送する。
+    画面ごとの描画（View::render）は view.cc にあり、ホストのツールからも使う。
+*/
+#include "view.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+
+// Atlas lib
+#include "lock.hh"
+#include "os.hh"
+
+// Atlas
+#include "atlas_manager.hh"
+#include "setting.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+namespace os = shark::os;
+
+// 描画タスクのスタックサイズ [bytes]
+constexpr std::uint32_t STACK_RENDER = 4096;
+
+os::StaticTask<STACK_RENDER> gTaskRender;
+
+} // namespace
+
+bool View::begin(std::uint8_t screenAddr)
+{
+    if (!DisplayDriver::begin(screenAddr)) {
+        return false;
+    }
+
+    // 描画タスク（2回目以降は作らない）
+    return gTaskRender.start(
+        _taskRender,            // タスク
+        "taskRender",           // タスク名
+        this,                   // 起動パラメータ
+        1                       // 優先度（値が大きいほど優先順位が高い）
+    );
+}
+
+RenderStats View::renderStats() const
+{
+    shark::Lock lock(_mutex);
+    return _stats;
+}
+
+//=============================================================================
+// 描画要求
+//=============================================================================
+
+void View::splashScreen()
+{
+    this->_post({Screen::SPLASH, 0, 0, 0});
+}
+
+void View::manualModeStandby()
+{
+    this->_post({Screen::MANUAL_STANDBY, 0, 0, 0});
+}
+
+void View::autoModeStandby()
+{
+    this->_post({Screen::AUTO_STANDBY, 0, 0, 0});
+}
+
+void View::autoModeError()
+{
+    this->_post({Screen::AUTO_ERROR, 0, 0, 0});
+}
+
+void View::autoModeAborted()
+{
+    this->_post({Screen::AUTO_ABORTED, 0, 0, 0});
+}
+
+void View::autoModePromotion()
+{
+    this->_post({Screen::AUTO_PROMOTION, 0, 0, 0});
+}
+
+void View::autoModeSP(std::uint16_t acc1, std::uint16_t acc2)
+{
+    this->_post({Screen::AUTO_SP, 0, acc1, acc2});
+}
+
+void View::autoModeCountdown(int i)
+{
+    this->_post({Screen::AUTO_COUNTDOWN, static_cast<std::int8_t>(i), 0, 0});
+}
+
+void View::_post(const Request& request)
+{
+    {
+        shark::Lock lock(_mutex);
+        _request = request;
+        _stats.requests += 1;
+    }
+    gTaskRender.notify();
+}
+
+//=============================================================================
+// 描画タスク
+//=============================================================================
+
+void View::_taskRender(void* pvParams)
+{
+    auto& self = *static_cast<View*>(pvParams);
+
+    const std::uint32_t interval = VIEW_FRAME_INTERVAL_MS;
+    std::uint32_t lastFrame = os::millis() - interval;
+
+    while (true) {
+        // 描画要求待ち（ブロック）
+        os::takeNotify();
+
+        // 前のフレームから最小間隔を空ける（その間の要求はまとめる）
+        const std::uint32_t elapsed = os::millis() - lastFrame;
+        if (elapsed < interval) {
+            os::delay(interval - elapsed);
+        }
+        lastFrame = os::millis();
+        os::takeNotify(0);
+
+        // 最新の描画要求
+        Request request;
+        {
+            shark::Lock lock(self._mutex);
+            request = self._request;
+        }
+
+        // バッファへの描画
+        const std::int64_t t0 = os::now();
+        self.render(request);
+
+        // 画面への転送
+        const std::int64_t t1 = os::now();
+        self.show();
+        const std::int64_t t2 = os::now();
+
+        // 計測結果の記録
+        const auto render = static_cast<std::uint32_t>(t1 - t0);
+        const auto flush = static_cast<std::uint32_t>(t2 - t1);
+        const auto bytes = self.lastFlushBytes();
+        ATLAS.latency.record(Probe::DISPLAY_FLUSH, flush);
+        shark::Lock lock(self._mutex);
+        auto& st = self._stats;
+        st.frames += 1;
+        st.lastRender = render;
+        st.maxRender = std::max(st.maxRender, render);
+        st.lastFlush = flush;
+        st.maxFlush = std::max(st.maxFlush, flush);
+        st.lastBytes = bytes;
+        self._sumRender += render;
+        self._sumFlush += flush;
+        self._sumBytes += bytes;
+        st.meanRender = static_cast<std::uint32_t>(self._sumRender / st.frames);
+        st.meanFlush = static_cast<std::uint32_t>(self._sumFlush / st.frames);
+        st.meanBytes = static_cast<std::uint32_t>(self._sumBytes / st.frames);
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
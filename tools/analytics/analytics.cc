@@ -0,0 +1,247 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    生データファイル（/raw.dat）の集計ツール
+
+    複数の機器から吸い出した raw.dat をメモリマップで読み込み、
+    機器ごと・セッションごとの統計情報（Statistics / Histogram）を
+    並列に計算して CSV または JSON で出力する。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::atoi
+#include <memory>       // std::unique_ptr
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// ATLAS
+#include "shot_analytics.hh"
+#include "parallel.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+//! コマンドライン引数
+struct Options
+{
+    unsigned jobs = 0;              //!< 並列数
+    bool json = false;              //!< JSONで出力するか
+    bool sessions = false;          //!< セッションごとの集計も出力するか
+    atlas::EvalSource source = atlas::EvalSource::RECORDED;
+    std::vector<std::string> files;
+};
+
+//! 入力ファイル
+struct Device
+{
+    std::string path;       //!< ファイルパス
+    std::string name;       //!< 機器名
+    atlas::MappedLog log;   //!< マップしたファイル
+};
+
+//! 集計単位
+struct Unit
+{
+    std::size_t device;         //!< 機器の番号
+    unsigned session;           //!< セッション番号（0は機器全体）
+    atlas::LogSegment segment;  //!< 対象区間
+    atlas::Result result;       //!< 集計結果
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [-j N] [-f csv|json] [-s] [-r] raw.dat...\n"
+        "  -j N          number of worker threads (default: CPU cores)\n"
+        "  -f csv|json   output format (default: csv)\n"
+        "  -s            also output per-session statistics\n"
+        "  -r            recompute evalSP from profiles with Result::update\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            opts.jobs = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-f" && i + 1 < argc) {
+            std::string fmt = argv[++i];
+            if (fmt != "csv" && fmt != "json") return false;
+            opts.json = (fmt == "json");
+        }
+        else if (arg == "-s") {
+            opts.sessions = true;
+        }
+        else if (arg == "-r") {
+            opts.source = atlas::EvalSource::RECOMPUTED;
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        }
+        else {
+            opts.files.push_back(arg);
+        }
+    }
+    return !opts.files.empty();
+}
+
+/*!
+    機器名をファイルパスから決める
+    - device1/raw.dat → device1
+    - device1.dat     → device1
+*/
+std::string deviceName(const std::string& path)
+{
+    auto slash = path.find_last_of('/');
+    std::string base = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (base == "raw.dat" && slash != std::string::npos && slash > 0) {
+        auto parent = path.substr(0, slash);
+        auto p = parent.find_last_of('/');
+        return p == std::string::npos ? parent : parent.substr(p + 1);
+    }
+    auto dot = base.find_last_of('.');
+    return dot == std::string::npos ? base : base.substr(0, dot);
+}
+
+//! JSON文字列のエスケープ
+std::string jsonString(const std::string& s)
+{
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void printCsvHeader()
+{
+    std::printf("device,session,first,shots,"
+                "orig_total,orig_latest,orig_mean,orig_stdev,orig_min,orig_max,"
+                "eval_total,eval_latest,eval_mean,eval_stdev,eval_min,eval_max\n");
+}
+
+void printCsvStats(const atlas::Statistics& s)
+{
+    std::printf(",%u,%u,%u,%u,%u,%u",
+                s.total, s.latestSP, s.meanSP, s.stdevSP, s.minSP, s.maxSP);
+}
+
+void printCsv(const Device& dev, const Unit& u)
+{
+    std::printf("%s,", dev.name.c_str());
+    if (u.session == 0) {
+        std::printf("all");
+    }
+    else {
+        std::printf("%u", u.session);
+    }
+    std::printf(",%zu,%zu", u.segment.first, u.segment.count);
+    printCsvStats(u.result.statsOrig);
+    printCsvStats(u.result.statsEval);
+    std::printf("\n");
+}
+
+void printJsonStats(const char* key, const atlas::Statistics& s)
+{
+    const auto& h = s.hist;
+    std::printf(
+        "\"%s\":{\"total\":%u,\"latest\":%u,\"mean\":%u,\"stdev\":%u,"
+        "\"min\":%u,\"max\":%u,\"hist\":{\"minSP\":%u,\"binWidth\":%u,"
+        "\"maxCount\":%u,\"counts\":[",
+        key, s.total, s.latestSP, s.meanSP, s.stdevSP, s.minSP, s.maxSP,
+        h.minSP, h.binWidth, h.maxCount
+    );
+    for (std::uint32_t i = 0; i < HIST_NUM_BINS; ++i) {
+        std::printf(i ? ",%u" : "%u", h.at(i));
+    }
+    std::printf("]}}");
+}
+
+void printJson(const Device& dev, const Unit& u, bool first)
+{
+    std::printf("%s\n  {\"device\":%s,\"session\":", first ? "" : ",",
+                jsonString(dev.name).c_str());
+    if (u.session == 0) {
+        std::printf("\"all\"");
+    }
+    else {
+        std::printf("%u", u.session);
+    }
+    std::printf(",\"first\":%zu,\"shots\":%zu,", u.segment.first, u.segment.count);
+    printJsonStats("orig", u.result.statsOrig);
+    std::printf(",");
+    printJsonStats("eval", u.result.statsEval);
+    std::printf("}");
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (opts.jobs == 0) {
+        opts.jobs = atlas::defaultConcurrency();
+    }
+
+    // ファイルのマップと集計単位の列挙
+    int status = 0;
+    std::vector<std::unique_ptr<Device>> devices;
+    std::vector<Unit> units;
+    for (const auto& path : opts.files) {
+        auto dev = std::make_unique<Device>();
+        dev->path = path;
+        dev->name = deviceName(path);
+
+        std::string error;
+        if (!dev->log.open(path, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            status = 1;
+            continue;
+        }
+
+        const std::size_t index = devices.size();
+        units.push_back({index, 0, {0, dev->log.size()}, {}});
+        if (opts.sessions) {
+            unsigned session = 1;
+            for (const auto& seg : atlas::splitSessions(dev->log)) {
+                units.push_back({index, session++, seg, {}});
+            }
+        }
+        devices.push_back(std::move(dev));
+    }
+
+    // 集計
+    atlas::parallelFor(units.size(), opts.jobs, [&](std::size_t i) {
+        auto& u = units[i];
+        u.result = atlas::summarize(devices[u.device]->log, u.segment, opts.source);
+    });
+
+    // 出力
+    if (opts.json) {
+        std::printf("[");
+        for (std::size_t i = 0; i < units.size(); ++i) {
+            printJson(*devices[units[i].device], units[i], i == 0);
+        }
+        std::printf("\n]\n");
+    }
+    else {
+        printCsvHeader();
+        for (const auto& u : units) {
+            printCsv(*devices[u.device], u);
+        }
+    }
+    return status;
+}
@@ -0,0 +1,250 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    ベイバトルパスの合成データ生成ツール
+
+    ランチャーの引きの物理モデル（加速カーブ、ピークSP、紐の巻き戻り、
+    センサーノイズ、計測抜け）から、BBPAnalyzer が受け取るnotifyデータ列
+    （A0, B0-B7, 70-73）を生成する。
+
+    - フレーム列をファイルに書き出して、回帰テスト用のコーパスを作る（-w）
+    - オートモードと同じ処理（解析 → 統計更新 → 生データ保存）に流して、
+      スループットを計測する（既定）
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdio>       // std::printf, std::fprintf, std::fopen
+#include <cstdlib>      // std::atoi, std::atof
+#include <random>       // std::uniform_real_distribution
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// shark lib
+#include "bbp_analyzer.hh"
+
+// ATLAS
+#include "result.hh"
+#include "raw_record.hh"
+#include "bbp_synth.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+//! コマンドライン引数
+struct Options
+{
+    unsigned shots = 1000;          //!< シュート数
+    std::uint32_t seed = 1;         //!< 乱数シード
+    double peakMin = 6000;          //!< ピークSPの下限
+    double peakMax = 14000;         //!< ピークSPの上限
+    double rewindRate = 0.3;        //!< 紐の巻き戻りが起きる確率
+    double rewindBump = 0.08;       //!< 巻き戻りの大きさ（ピークSP比）
+    double noise = 0.01;            //!< センサーノイズ
+    double dropout = 0;             //!< 計測抜けの確率
+    double crcError = 0;            //!< チェックサムエラーの確率
+    unsigned repeat = 1;            //!< ベンチマークの繰り返し回数
+    bool elr = false;               //!< 電動ランチャー連動
+    std::string framesPath;         //!< フレーム列の出力先
+    std::string rawPath;            //!< 生データの出力先
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -n SHOTS          number of shots (default: 1000)\n"
+        "  -s SEED           random seed (default: 1)\n"
+        "  --peak MIN:MAX    peak SP range in rpm (default: 6000:14000)\n"
+        "  --rewind P:BUMP   string rewind probability and size (default: 0.3:0.08)\n"
+        "  --noise SIGMA     relative sensor noise (default: 0.01)\n"
+        "  --dropout P       probability of a zero profile point (default: 0)\n"
+        "  --crc-error P     probability of a broken checksum (default: 0)\n"
+        "  --elr             emit frames with the ELR flag enabled\n"
+        "  --repeat N        feed the frames N times when benchmarking\n"
+        "  -w FILE           write the notify frames (17 bytes each) to FILE\n"
+        "  -o FILE           write records as onBeyLaunched does to FILE\n",
+        prog
+    );
+}
+
+bool parsePair(const char* s, double& a, double& b)
+{
+    return std::sscanf(s, "%lf:%lf", &a, &b) == 2;
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-n" && hasValue) {
+            opts.shots = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-s" && hasValue) {
+            opts.seed = static_cast<std::uint32_t>(std::atol(argv[++i]));
+        }
+        else if (arg == "--peak" && hasValue) {
+            if (!parsePair(argv[++i], opts.peakMin, opts.peakMax)) return false;
+        }
+        else if (arg == "--rewind" && hasValue) {
+            if (!parsePair(argv[++i], opts.rewindRate, opts.rewindBump)) return false;
+        }
+        else if (arg == "--noise" && hasValue) {
+            opts.noise = std::atof(argv[++i]);
+        }
+        else if (arg == "--dropout" && hasValue) {
+            opts.dropout = std::atof(argv[++i]);
+        }
+        else if (arg == "--crc-error" && hasValue) {
+            opts.crcError = std::atof(argv[++i]);
+        }
+        else if (arg == "--repeat" && hasValue) {
+            opts.repeat = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "--elr") {
+            opts.elr = true;
+        }
+        else if (arg == "-w" && hasValue) {
+            opts.framesPath = argv[++i];
+        }
+        else if (arg == "-o" && hasValue) {
+            opts.rawPath = argv[++i];
+        }
+        else {
+            return false;
+        }
+    }
+    return opts.peakMin <= opts.peakMax;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    //-------------------------------------------------------------------------
+    // フレーム列の生成
+    //-------------------------------------------------------------------------
+    atlas::BBPFrameGenerator gen(opts.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<shark::BBPData> frames;
+    std::vector<atlas::SyntheticShot> shots;
+    if (opts.elr) {
+        gen.enableELR(frames);
+    }
+    for (unsigned i = 0; i < opts.shots; ++i) {
+        atlas::LaunchModel model;
+        model.peakSP = opts.peakMin + (opts.peakMax - opts.peakMin) * uniform(gen.rng());
+        model.pullTime = 80 + 80 * uniform(gen.rng());
+        model.pullCurve = 1.0 + uniform(gen.rng());
+        model.rewindBump = uniform(gen.rng()) < opts.rewindRate ? opts.rewindBump : 0;
+        model.noise = opts.noise;
+        model.dropout = opts.dropout;
+
+        bool corrupt = uniform(gen.rng()) < opts.crcError;
+        shots.push_back(gen.shot(model, frames, corrupt));
+    }
+
+    if (!opts.framesPath.empty()) {
+        FILE* fp = std::fopen(opts.framesPath.c_str(), "wb");
+        if (!fp) {
+            std::fprintf(stderr, "cannot open %s\n", opts.framesPath.c_str());
+            return 1;
+        }
+        std::fwrite(frames.data(), shark::BBPData::LENGTH, frames.size(), fp);
+        std::fclose(fp);
+        std::printf("%zu frames (%u shots) written to %s\n",
+                    frames.size(), opts.shots, opts.framesPath.c_str());
+        if (opts.rawPath.empty()) {
+            return 0;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    // オートモードと同じ処理に流す
+    //-------------------------------------------------------------------------
+    FILE* raw = nullptr;
+    if (!opts.rawPath.empty()) {
+        raw = std::fopen(opts.rawPath.c_str(), "wb");
+        if (!raw) {
+            std::fprintf(stderr, "cannot open %s\n", opts.rawPath.c_str());
+            return 1;
+        }
+    }
+
+    shark::BBPAnalyzer analyzer;
+    atlas::Result result;
+    std::size_t finished = 0;
+    std::size_t crcErrors = 0;
+    std::size_t mismatches = 0;
+
+    auto t0 = Clock::now();
+    for (unsigned r = 0; r < opts.repeat; ++r) {
+        result.initialize();
+        std::size_t next = 0;   // 次に解析結果が出るはずのシュート
+        for (const auto& frame : frames) {
+            switch (analyzer.analyze(frame)) {
+            case shark::BBPState::FINISHED: {
+                // 統計データ更新
+                std::uint16_t acc1 = 0, acc2 = 0;
+                result.update(analyzer.sp(), analyzer.raw(), acc1, acc2);
+
+                // 生データ保存（初回のみ）
+                if (raw && r == 0) {
+                    atlas::RawRecord record;
+                    record.total = result.statsOrig.total;
+                    record.origSP = analyzer.sp();
+                    record.evalSP = result.statsEval.latestSP;
+                    std::copy(analyzer.raw(), analyzer.raw() + 32, record.profile);
+                    std::fwrite(&record, sizeof(record), 1, raw);
+                }
+
+                // BBP記録SPの取り出しの検証
+                if (r == 0 && next < shots.size() && analyzer.sp() != shots[next].origSP) {
+                    mismatches += 1;
+                }
+                finished += 1;
+                next += 1;
+                analyzer.clear();
+                break;
+            }
+            case shark::BBPState::ERROR:
+                crcErrors += 1;
+                next += 1;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    if (raw) {
+        std::fclose(raw);
+    }
+
+    const auto& stats = result.statsEval;
+    std::printf(
+        "%zu frames x %u: %zu shots analyzed, %zu CRC errors, %zu SP mismatches\n"
+        "eval: mean %u, stdev %u, min %u, max %u\n"
+        "%.3f s, %.0f frames/s, %.0f shots/s\n",
+        frames.size(), opts.repeat, finished, crcErrors, mismatches,
+        stats.meanSP, stats.stdevSP, stats.minSP, stats.maxSP,
+        sec, sec > 0 ? frames.size() * opts.repeat / sec : 0.0,
+        sec > 0 ? finished / sec : 0.0
+    );
+    return 0;
+}
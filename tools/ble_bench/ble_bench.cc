@@ -0,0 +1,519 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    BLEの同期のベンチマーク
+
+    ATLASのGATTサービスのエミュレーター（tools/common/atlas_emulator.hh）と
+    ホストのクライアント（tools/common/atlas_client.hh）を、擬似的なBLE接続
+    （tools/common/ble_loopback.hh）でつなぎ、OSの抽象化層のホスト実装
+    （tools/common/host/os_sim.cc）の仮想時刻の上で、複数の機器の同期を同時に行う。
+
+    1台ごとに次を行い、生データの転送のスループットと、無線の上限に対する効率を表示する。
+    エミュレーターはファームウェアと同じく、転送の間だけ短い接続間隔・DLE・2M PHY を要求する
+    （-B 0 で要求しない）。
+
+    - 接続してデバイス情報・パラメータを読み、パラメータを書き戻す
+    - 生データを読み出す（途中で切断されたら、接続し直して受信済みの位置から再開する）
+    - 受信した生データ・解析結果がエミュレーターのものと一致するか確かめる
+    - 機器が記録した転送の結果（RAW_CTRL の読み出し値）を読む
+    - 同期の間、別のタスクがパラメータ・解析結果・遅延の計測結果を読み続ける
+      （ATTの要求が生データの通知と混ざっても壊れないこと）
+
+    不一致・同期の失敗があれば終了コード1で終わる。同じ seed なら同じ結果になる。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max, std::min
+#include <atomic>       // std::atomic_bool
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdint>      // std::uint32_t, std::int64_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::strtoul, std::strtod
+#include <cstring>      // std::memcmp
+#include <memory>       // std::unique_ptr
+#include <random>       // std::mt19937, std::exponential_distribution
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// shark lib
+#include "os.hh"
+#include "sim.hh"
+
+// ATLAS
+#include "atlas_client.hh"
+#include "atlas_emulator.hh"
+#include "ble_loopback.hh"
+#include "setting.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+using namespace atlas;
+namespace os = shark::os;
+
+// タスクの優先度（エミュレーターの生データ転送タスクはファームウェアと同じ1）
+constexpr std::uint8_t MAIN_PRIORITY = 5;
+constexpr std::uint8_t INJECTOR_PRIORITY = 4;
+constexpr std::uint8_t SYNC_PRIORITY = 3;
+constexpr std::uint8_t READER_PRIORITY = 2;
+constexpr std::uint8_t SENDER_PRIORITY = 1;
+
+// 再接続までの時間 [ms]
+constexpr std::uint32_t RECONNECT_DELAY = 200;
+
+// 生データの読み出しを諦めるまでの試行回数
+constexpr std::uint32_t MAX_ATTEMPTS = 1000;
+
+//! コマンドライン引数
+struct Options
+{
+    std::uint32_t devices = 4;          //!< 機器の数
+    std::uint32_t records = 1000;       //!< 1台の生データのレコード数
+    os::sim::Config sim {1, 5, 20};     //!< シミュレーションの設定
+    LinkConfig link;                    //!< 接続の設定
+    std::uint32_t disconnectMean = 3000;    //!< 1台あたりの切断の平均間隔 [ms]（0なら切断しない）
+    std::uint32_t readerPeriod = 100;   //!< 同時に読み出す間隔 [ms]（0なら読み出さない）
+    bool bulkTransfer = true;           //!< 転送の間、接続パラメータの変更を要求するか
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -k DEVICES        number of devices synced at once (default: 4)\n"
+        "  -n RECORDS        raw data records per device, 70 bytes each (default: 1000)\n"
+        "  -s SEED           random seed (default: 1)\n"
+        "  -c US             mean CPU time per OS call (default: 5)\n"
+        "  -t US             mean timer dispatch latency (default: 20)\n"
+        "  -m MTU            ATT MTU (default: %u)\n"
+        "  -i US             connection interval chosen by the central (default: 30000)\n"
+        "  -I US             shortest interval the central accepts (default: 7500)\n"
+        "  -e US             connection event length, 0 = whole interval (default: 0)\n"
+        "  -l BYTES          longest LL payload the central accepts, 27 = no DLE (default: 251)\n"
+        "  -2 0|1            central supports 2M PHY (default: 1)\n"
+        "  -B 0|1            request bulk parameters during transfers (default: 1)\n"
+        "  -b BUFFERS        notifications the peripheral can queue (default: 12)\n"
+        "  -d MS             mean time between disconnects per device, 0 = none (default: 3000)\n"
+        "  -r MS             period of concurrent reads, 0 = none (default: 100)\n",
+        prog, static_cast<unsigned>(ATLAS_MTU_SIZE)
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const auto value = std::strtoul(argv[++i], nullptr, 10);
+        if (arg == "-k") {
+            opts.devices = value;
+        }
+        else if (arg == "-n") {
+            opts.records = value;
+        }
+        else if (arg == "-s") {
+            opts.sim.seed = value;
+        }
+        else if (arg == "-c") {
+            opts.sim.callCost = value;
+        }
+        else if (arg == "-t") {
+            opts.sim.timerLatency = value;
+        }
+        else if (arg == "-m") {
+            opts.link.mtu = static_cast<std::uint16_t>(value);
+        }
+        else if (arg == "-i") {
+            opts.link.interval = value;
+        }
+        else if (arg == "-I") {
+            opts.link.minInterval = value;
+        }
+        else if (arg == "-e") {
+            opts.link.eventLength = value;
+        }
+        else if (arg == "-l") {
+            opts.link.maxDataLength = static_cast<std::uint16_t>(value);
+        }
+        else if (arg == "-2") {
+            opts.link.phy2M = value != 0;
+        }
+        else if (arg == "-B") {
+            opts.bulkTransfer = value != 0;
+        }
+        else if (arg == "-b") {
+            opts.link.txBuffers = static_cast<std::uint8_t>(value);
+        }
+        else if (arg == "-d") {
+            opts.disconnectMean = value;
+        }
+        else if (arg == "-r") {
+            opts.readerPeriod = value;
+        }
+        else {
+            return false;
+        }
+    }
+    return opts.devices > 0 &&
+           23 <= opts.link.mtu && opts.link.mtu <= ATLAS_MTU_SIZE &&
+           opts.link.interval >= 1000 && opts.link.minInterval >= 1000 &&
+           (opts.link.eventLength == 0 || opts.link.eventLength >= 1000) &&
+           opts.link.maxDataLength >= LINK_DEFAULT_DATA_LENGTH &&
+           opts.link.txBuffers > 0;
+}
+
+//-----------------------------------------------------------------------------
+// 機器
+//-----------------------------------------------------------------------------
+
+struct Device
+{
+    explicit Device(const LinkConfig& config)
+        : link(emulator, config), client(link) {}
+
+    std::uint32_t index = 0;
+    AtlasEmulator emulator;
+    BleLoopback link;
+    AtlasClient client;
+    os::StaticTask<4096> syncTask;
+    os::StaticTask<4096> readerTask;
+
+    std::vector<std::uint8_t> received;     // 受信した生データ
+    std::int64_t rawStart = -1;             // 生データの読み出しを始めた時刻 [us]
+    std::int64_t rawEnd = -1;               // 読み出し終えた時刻 [us]
+    std::uint32_t attempts = 0;             // 生データの読み出しの回数
+    std::uint32_t packets = 0;              // 受信した通知の数
+    std::uint32_t disconnects = 0;          // 切断された回数
+    std::uint32_t timeouts = 0;             // 通知が来なくなった回数
+    std::uint32_t protocolErrors = 0;       // シーケンス番号の飛びなど
+    std::uint32_t reads = 0;                // 同時の読み出しの成功回数
+    std::uint32_t errors = 0;               // 不一致
+    RawTransferReport report;               // 機器が記録した最後の転送の結果
+    bool synced = false;                    // 同期できたか
+    std::atomic_bool done = false;          // 同期を終えたか
+};
+
+std::vector<std::unique_ptr<Device>> gDevices;
+Options gOpts;
+os::StaticQueue<std::uint32_t, 64> gDone;   // 同期を終えた機器の番号
+
+// 不一致を表示する
+void mismatch(Device& device, const char* what)
+{
+    std::printf("error: device %u: %s (t = %.3f s)\n", device.index, what, os::now() / 1e6);
+    device.errors += 1;
+}
+
+// 接続し直す
+void reconnect(Device& device)
+{
+    device.link.disconnect();
+    os::delay(RECONNECT_DELAY);
+    device.link.connect();
+}
+
+//-----------------------------------------------------------------------------
+// タスク
+//-----------------------------------------------------------------------------
+
+// 同期（Webアプリの同期ボタンと同じ手順）
+void taskSync(void* arg)
+{
+    auto& device = *static_cast<Device*>(arg);
+    auto& client = device.client;
+    auto& emulator = device.emulator;
+
+    device.link.connect();
+
+    // デバイス情報
+    DeviceInfo info;
+    while (client.readDeviceInfo(info) == AtlasClient::Status::DISCONNECTED) {
+        reconnect(device);
+    }
+    if (std::memcmp(&info, &emulator.deviceInfo, sizeof(DeviceInfo)) != 0) {
+        mismatch(device, "device info");
+    }
+
+    // パラメータを読んで書き戻す
+    Params params;
+    while (client.readParams(params) != AtlasClient::Status::OK ||
+           client.writeParams(params) != AtlasClient::Status::OK) {
+        reconnect(device);
+    }
+    if (std::memcmp(&params, &emulator.params, sizeof(Params)) != 0) {
+        mismatch(device, "params");
+    }
+
+    // 生データ（切断されたら再開する）
+    device.rawStart = os::now();
+    while (device.attempts < MAX_ATTEMPTS) {
+        device.attempts += 1;
+        const auto status = client.readRawData(device.received);
+        device.packets += client.rawPackets;
+        if (status == AtlasClient::Status::OK) {
+            device.synced = true;
+            break;
+        }
+        switch (status) {
+        case AtlasClient::Status::DISCONNECTED:
+            device.disconnects += 1;
+            break;
+        case AtlasClient::Status::TIMEOUT:
+            device.timeouts += 1;
+            break;
+        default:
+            device.protocolErrors += 1;
+            break;
+        }
+        reconnect(device);
+    }
+    device.rawEnd = os::now();
+
+    if (!device.synced) {
+        mismatch(device, "raw data not synced");
+    }
+    else if (device.received != emulator.rawData) {
+        mismatch(device, "raw data corrupted");
+    }
+
+    // 解析結果
+    Result result;
+    while (client.readResult(result) != AtlasClient::Status::OK) {
+        reconnect(device);
+    }
+    if (std::memcmp(&result, &emulator.result, sizeof(Result)) != 0) {
+        mismatch(device, "result");
+    }
+
+    // 機器が記録した転送の結果
+    while (client.readRawReport(device.report) != AtlasClient::Status::OK) {
+        reconnect(device);
+    }
+    if (device.synced && device.report.size != emulator.rawData.size()) {
+        mismatch(device, "raw transfer report");
+    }
+
+    device.done.store(true);
+    gDone.send(device.index, os::FOREVER);
+    while (true) {
+        os::takeNotify();
+    }
+}
+
+// 同期と同時の読み出し（同期が終わるまで）
+void taskReader(void* arg)
+{
+    auto& device = *static_cast<Device*>(arg);
+    auto& client = device.client;
+    auto& emulator = device.emulator;
+
+    std::uint32_t turn = 0;
+    while (!device.done.load()) {
+        os::delay(gOpts.readerPeriod);
+
+        AtlasClient::Status status;
+        bool same = true;
+        switch (turn++ % 3) {
+        case 0: {
+            Params params;
+            status = client.readParams(params);
+            same = std::memcmp(&params, &emulator.params, sizeof(Params)) == 0;
+            break;
+        }
+        case 1: {
+            Result result;
+            status = client.readResult(result);
+            same = std::memcmp(&result, &emulator.result, sizeof(Result)) == 0;
+            break;
+        }
+        default: {
+            // MTUより長い値（Read Blob）
+            std::vector<std::uint8_t> value;
+            status = device.link.read(Characteristic::LATENCY, value)
+                ? AtlasClient::Status::OK : AtlasClient::Status::DISCONNECTED;
+            same = value.size() == sizeof(LatencyReport) &&
+                   std::memcmp(value.data(), &emulator.latency, sizeof(LatencyReport)) == 0;
+            break;
+        }
+        }
+
+        // 切断中の失敗は問わない
+        if (status == AtlasClient::Status::OK) {
+            device.reads += 1;
+            if (!same) {
+                mismatch(device, "concurrent read");
+            }
+        }
+        else if (status == AtlasClient::Status::PROTOCOL_ERROR) {
+            mismatch(device, "concurrent read: protocol error");
+        }
+    }
+    while (true) {
+        os::takeNotify();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// 集計
+//-----------------------------------------------------------------------------
+
+// 接続の上限のスループット（接続イベントの間、通知を送り続けたとき） [bytes/s]
+double linkCapacity(const LinkConfig& link, std::uint32_t interval,
+                    std::uint16_t dataLength, std::uint8_t phy)
+{
+    const std::uint16_t payload = rawPayloadSize(link.mtu);
+    const std::uint32_t length = link.eventLength ? std::min(link.eventLength, interval) : interval;
+    const std::uint32_t time = BleLoopback::pduTime(
+        RAW_HEADER_SIZE + payload + ATT_NOTIFY_OVERHEAD, dataLength, phy);
+    return 1e6 * payload * (length - 150) / interval / time;
+}
+
+// 転送の間の接続（セントラルがバルク転送の要求を受け入れたとき）
+void bulkLink(const LinkConfig& link, std::uint32_t& interval,
+              std::uint16_t& dataLength, std::uint8_t& phy)
+{
+    interval = link.interval;
+    dataLength = LINK_DEFAULT_DATA_LENGTH;
+    phy = LINK_PHY_1M;
+    if (gOpts.bulkTransfer) {
+        interval = std::max<std::uint32_t>(ATLAS_BULK_INTERVAL_MIN * 1250, link.minInterval);
+        interval = std::min<std::uint32_t>(
+            interval, std::max<std::uint32_t>(ATLAS_BULK_INTERVAL_MAX * 1250, link.minInterval));
+        dataLength = std::min<std::uint16_t>(ATLAS_BULK_DATA_LENGTH, link.maxDataLength);
+        phy = link.phy2M ? LINK_PHY_2M : LINK_PHY_1M;
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (!parseArgs(argc, argv, gOpts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    os::sim::begin(MAIN_PRIORITY, gOpts.sim);
+    gDone.begin();
+
+    // 機器ごとに乱数の生データ・解析結果を用意する
+    std::mt19937 rng(gOpts.sim.seed ^ 0x5eedU);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (std::uint32_t i = 0; i < gOpts.devices; ++i) {
+        auto device = std::make_unique<Device>(gOpts.link);
+        device->index = i;
+        device->emulator.bulkTransfer = gOpts.bulkTransfer;
+        device->emulator.rawData.resize(gOpts.records * sizeof(RawRecord));
+        for (auto& b : device->emulator.rawData) {
+            b = static_cast<std::uint8_t>(byte(rng));
+        }
+        auto* result = reinterpret_cast<std::uint8_t*>(&device->emulator.result);
+        for (std::size_t k = 0; k < sizeof(Result); ++k) {
+            result[k] = static_cast<std::uint8_t>(byte(rng));
+        }
+        gDevices.push_back(std::move(device));
+    }
+
+    const auto wallStart = Clock::now();
+    const std::int64_t simStart = os::now();
+
+    for (auto& device : gDevices) {
+        device->link.begin();
+        device->emulator.begin(SENDER_PRIORITY);
+        device->syncTask.start(taskSync, "sync", device.get(), SYNC_PRIORITY);
+        if (gOpts.readerPeriod > 0) {
+            device->readerTask.start(taskReader, "reader", device.get(), READER_PRIORITY);
+        }
+    }
+
+    // 同期が終わるまで、ランダムな時刻に切断する（メインのタスクが行う）
+    std::exponential_distribution<double> gap(
+        gOpts.disconnectMean ? 1.0 * gOpts.devices / gOpts.disconnectMean : 1.0);
+    std::uniform_int_distribution<std::uint32_t> pick(0, gOpts.devices - 1);
+    std::uint32_t finished = 0;
+    std::uint32_t injected = 0;
+    while (finished < gOpts.devices) {
+        std::uint32_t index;
+        if (gOpts.disconnectMean == 0) {
+            gDone.receive(index);
+            finished += 1;
+            continue;
+        }
+        const auto wait = static_cast<std::uint32_t>(gap(rng)) + 1;
+        if (gDone.receive(index, wait)) {
+            finished += 1;
+            continue;
+        }
+        auto& device = *gDevices[pick(rng)];
+        if (!device.done.load() && device.link.isConnected()) {
+            device.link.disconnect();
+            injected += 1;
+        }
+    }
+
+    const double wall = std::chrono::duration<double>(Clock::now() - wallStart).count();
+    const double simSec = (os::now() - simStart) / 1e6;
+    std::uint32_t bulkInterval;
+    std::uint16_t bulkDataLength;
+    std::uint8_t bulkPhy;
+    bulkLink(gOpts.link, bulkInterval, bulkDataLength, bulkPhy);
+    const double connCapacity = linkCapacity(
+        gOpts.link, gOpts.link.interval, LINK_DEFAULT_DATA_LENGTH, LINK_PHY_1M);
+    const double capacity = linkCapacity(gOpts.link, bulkInterval, bulkDataLength, bulkPhy);
+
+    std::printf("seed %u, %u device(s), %u records (%u bytes) each\n",
+                gOpts.sim.seed, gOpts.devices, gOpts.records,
+                static_cast<unsigned>(gOpts.records * sizeof(RawRecord)));
+    std::printf("link: MTU %u (payload %u), event length %.2f ms, %u TX buffers\n",
+                gOpts.link.mtu, rawPayloadSize(gOpts.link.mtu),
+                gOpts.link.eventLength / 1000.0, gOpts.link.txBuffers);
+    std::printf("  on connect:  interval %.2f ms, LL payload %u, 1M PHY: %.1f kB/s max\n",
+                gOpts.link.interval / 1000.0, LINK_DEFAULT_DATA_LENGTH, connCapacity / 1000);
+    std::printf("  transfers:   interval %.2f ms, LL payload %u, %uM PHY: %.1f kB/s max%s\n",
+                bulkInterval / 1000.0, bulkDataLength, bulkPhy, capacity / 1000,
+                gOpts.bulkTransfer ? "" : " (bulk parameters not requested)");
+    std::printf("%-6s %9s %8s %6s %6s %6s %9s %8s %6s %6s %9s %6s %4s %4s\n",
+                "device", "bytes", "packets", "tries", "disc", "t/o", "time [s]",
+                "kB/s", "eff", "reads", "dev kB/s", "int", "dle", "phy");
+
+    std::uint32_t errors = 0;
+    std::uint64_t totalBytes = 0;
+    std::uint64_t totalSent = 0;
+    std::uint64_t requests = 0;
+    double sumGoodput = 0;
+    for (auto& device : gDevices) {
+        const double sec = (device->rawEnd - device->rawStart) / 1e6;
+        const double goodput = sec > 0 ? device->received.size() / sec : 0;
+        const auto& report = device->report;
+        std::printf("%-6u %9zu %8u %6u %6u %6u %9.3f %8.1f %5.0f%% %6u %9.1f %6.2f %4u %3uM\n",
+                    device->index, device->received.size(), device->packets,
+                    device->attempts, device->disconnects, device->timeouts, sec,
+                    goodput / 1000, 100 * goodput / capacity, device->reads,
+                    report.goodput / 1000.0, report.interval * 1.25, report.dataLength, report.phy);
+        errors += device->errors + device->protocolErrors;
+        totalBytes += device->received.size();
+        totalSent += device->emulator.sentBytes.load();
+        requests += device->link.requests();
+        sumGoodput += goodput;
+    }
+
+    std::printf("goodput: %.1f kB/s per device (mean), %.1f kB/s in total; "
+                "sent %.2fx the raw data (resends)\n",
+                sumGoodput / gOpts.devices / 1000, totalBytes / simSec / 1000,
+                totalBytes ? 1.0 * totalSent / totalBytes : 0.0);
+    std::printf("%u disconnect(s) injected, %llu ATT request(s)\n",
+                injected, static_cast<unsigned long long>(requests));
+    std::printf("simulated %.1f s in %.2f s wall: x%.0f, %llu switches, %llu preemptions\n",
+                simSec, wall, simSec / wall,
+                static_cast<unsigned long long>(os::sim::switches()),
+                static_cast<unsigned long long>(os::sim::preemptions()));
+    std::printf("%u error(s)\n", errors);
+
+    os::sim::exit(errors ? 1 : 0);
+}
@@ -0,0 +1,436 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    ボタン入力の合成波形ツール
+
+    チャタリング（押下・解放の直後のエッジの連続）と、チャタリング除去時間より
+    短いノイズを含むボタン操作の波形を乱数で生成し、ファームウェアと同じ
+    ButtonDebouncer に割り込み駆動と同じタイミング（エッジのたびに除去タイマーを
+    セットし直す）で流して、次を確認する。
+
+    - 短押しは PRESS → CLICK、長押しは PRESS → LONG_PRESS → RELEASE になること
+    - ノイズだけではイベントが出ないこと
+    - 操作からイベントまでの遅れ（割り込み駆動と、従来の10msポーリングとの比較）
+
+    期待と異なるイベント列があれば終了コード1を返す。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min, std::max
+#include <cstdint>      // std::int64_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::atoi, std::atol, std::atof
+#include <random>       // std::mt19937, std::uniform_real_distribution
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// shark lib
+#include "button_debouncer.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using shark::ButtonDebouncer;
+using shark::ButtonEvent;
+
+//! コマンドライン引数
+struct Options
+{
+    unsigned presses = 1000;        //!< ボタン操作の回数
+    std::uint32_t seed = 1;         //!< 乱数シード
+    std::uint32_t debounceMs = 20;  //!< チャタリング除去の時間 [ms]（SW_DEBOUNCE_MS）
+    std::uint32_t longPressMs = 800;//!< 長押し判定の時間 [ms]（SW_LONGPRESS_MS）
+    std::uint32_t pollMs = 10;      //!< 比較するポーリング周期 [ms]
+    double bounceMs = 5;            //!< チャタリングが続く最大時間 [ms]
+    unsigned bounces = 8;           //!< チャタリングのエッジ数の最大値
+    double glitchRate = 0.1;        //!< ノイズ（短いパルス）が混ざる確率
+    bool verbose = false;           //!< イベント列を表示する
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -n PRESSES        number of button operations (default: 1000)\n"
+        "  -s SEED           random seed (default: 1)\n"
+        "  --debounce MS     debounce time (default: 20)\n"
+        "  --long MS         long press time (default: 800)\n"
+        "  --poll MS         polling period of the baseline (default: 10)\n"
+        "  --bounce MS:N     bounce duration and max edges (default: 5:8)\n"
+        "  --glitch P        probability of a short noise pulse (default: 0.1)\n"
+        "  -v                print every event\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-n" && hasValue) {
+            opts.presses = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-s" && hasValue) {
+            opts.seed = static_cast<std::uint32_t>(std::atol(argv[++i]));
+        }
+        else if (arg == "--debounce" && hasValue) {
+            opts.debounceMs = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "--long" && hasValue) {
+            opts.longPressMs = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "--poll" && hasValue) {
+            opts.pollMs = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "--bounce" && hasValue) {
+            if (std::sscanf(argv[++i], "%lf:%u", &opts.bounceMs, &opts.bounces) != 2) {
+                return false;
+            }
+        }
+        else if (arg == "--glitch" && hasValue) {
+            opts.glitchRate = std::atof(argv[++i]);
+        }
+        else if (arg == "-v") {
+            opts.verbose = true;
+        }
+        else {
+            return false;
+        }
+    }
+    // チャタリングが除去時間より長いと、押下と解放の判定が揺らぐ
+    return opts.bounceMs < opts.debounceMs;
+}
+
+//! 入力のエッジ（押下状態の変化）
+struct Edge
+{
+    std::int64_t time;  //!< 時刻 [us]
+    bool pressed;       //!< 変化後に押されているかどうか
+};
+
+//! 確定したイベント
+struct Fired
+{
+    std::int64_t time;  //!< 時刻 [us]
+    ButtonEvent event;  //!< イベント
+};
+
+//! ボタン操作1回分
+struct Operation
+{
+    std::int64_t press;     //!< 押し始めの時刻 [us]
+    std::int64_t release;   //!< 離し始めの時刻 [us]
+    bool isLong;            //!< 長押しかどうか
+};
+
+const char* name(ButtonEvent event)
+{
+    switch (event) {
+    case ButtonEvent::PRESS:      return "PRESS";
+    case ButtonEvent::CLICK:      return "CLICK";
+    case ButtonEvent::LONG_PRESS: return "LONG_PRESS";
+    case ButtonEvent::RELEASE:    return "RELEASE";
+    default:                      return "NONE";
+    }
+}
+
+//! 合成波形の生成
+class TraceGenerator
+{
+public:
+    TraceGenerator(const Options& opts)
+        : _opts(opts), _rng(opts.seed) {}
+
+    /*!
+        @brief  ボタン操作1回分の波形を追加する
+        @param[in,out]  t      現在時刻 [us]（操作の後の時刻に進める）
+        @param[out]     edges  エッジ列
+        @return         ボタン操作
+    */
+    Operation append(std::int64_t& t, std::vector<Edge>& edges)
+    {
+        // 前の操作から十分に空ける（その間にノイズが入ることがある）
+        t += us(200 + 800 * uniform());
+        if (uniform() < _opts.glitchRate) {
+            const std::int64_t width = us(_opts.debounceMs * 0.5 * uniform());
+            edges.push_back({t, true});
+            edges.push_back({t + std::max<std::int64_t>(width, 1), false});
+            t += us(200);
+        }
+
+        // 判定の境界付近（除去時間 + チャタリングの幅）は避けて、短押しと長押しを作る
+        const double margin = _opts.debounceMs + _opts.bounceMs + 20;
+        Operation op;
+        op.isLong = uniform() < 0.3;
+        const double hold = op.isLong
+            ? _opts.longPressMs + margin + 1000 * uniform()
+            : margin + (_opts.longPressMs - 2 * margin) * uniform();
+
+        op.press = t;
+        bounce(t, true, edges);
+        op.release = op.press + us(hold);
+        t = op.release;
+        bounce(t, false, edges);
+        return op;
+    }
+
+private:
+    // 0以上1未満の乱数
+    double uniform() {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(_rng);
+    }
+
+    // ms → us
+    static std::int64_t us(double ms) {
+        return static_cast<std::int64_t>(ms * 1000);
+    }
+
+    // チャタリングを含む状態変化（最後のエッジが最終状態になる）
+    void bounce(std::int64_t& t, bool pressed, std::vector<Edge>& edges)
+    {
+        const unsigned n = _opts.bounces
+            ? std::uniform_int_distribution<unsigned>(0, _opts.bounces / 2)(_rng) * 2
+            : 0;
+        std::vector<std::int64_t> times;
+        for (unsigned i = 0; i < n; ++i) {
+            times.push_back(t + 1 + us(_opts.bounceMs * uniform()));
+        }
+        std::sort(times.begin(), times.end());
+
+        edges.push_back({t, pressed});
+        bool level = pressed;
+        for (auto time : times) {
+            level = !level;
+            if (time > edges.back().time) {
+                edges.push_back({time, level});
+            }
+            else {
+                edges.back().pressed = level;
+            }
+        }
+        // 偶数回の反転なので、最終状態は pressed になる
+    }
+
+private:
+    const Options& _opts;
+    std::mt19937 _rng;
+};
+
+//! 割り込み駆動（ファームウェアの Button と同じタイマーの使い方）
+std::vector<Fired> runInterrupt(const Options& opts, const std::vector<Edge>& edges)
+{
+    ButtonDebouncer debouncer;
+    debouncer.configure(opts.debounceMs, opts.longPressMs);
+    debouncer.reset();
+
+    std::vector<Fired> fired;
+    std::int64_t debounceAt = -1;   // チャタリング除去タイマー
+    std::int64_t longAt = -1;       // 長押しタイマー
+    bool level = false;             // 現在の入力
+    std::size_t next = 0;
+
+    auto dispatch = [&](std::int64_t t, ButtonEvent event) {
+        longAt = debouncer.longPressDeadline();
+        if (event != ButtonEvent::NONE) {
+            fired.push_back({t, event});
+        }
+    };
+
+    while (true) {
+        // 次に起きること（エッジ・除去タイマー・長押しタイマーのうち最も早いもの）
+        const std::int64_t tEdge = next < edges.size() ? edges[next].time : INT64_MAX;
+        const std::int64_t tDebounce = debounceAt >= 0 ? debounceAt : INT64_MAX;
+        const std::int64_t tLong = longAt >= 0 ? longAt : INT64_MAX;
+        const std::int64_t t = std::min({tEdge, tDebounce, tLong});
+        if (t == INT64_MAX) {
+            break;
+        }
+
+        if (t == tEdge) {
+            // 割り込み：除去タイマーをセットし直す
+            level = edges[next++].pressed;
+            debounceAt = t + debouncer.debounceUs();
+        }
+        else if (t == tDebounce) {
+            debounceAt = -1;
+            dispatch(t, debouncer.settle(level, t));
+        }
+        else {
+            dispatch(t, debouncer.expire(t));
+        }
+    }
+    return fired;
+}
+
+//! 従来のポーリング（一定周期で読み、変化がない時間で状態を確定する）
+std::vector<Fired> runPolling(const Options& opts, const std::vector<Edge>& edges)
+{
+    const std::int64_t period = opts.pollMs * 1000LL;
+    const std::int64_t debounce = opts.debounceMs * 1000LL;
+    const std::int64_t longPress = opts.longPressMs * 1000LL;
+
+    std::vector<Fired> fired;
+    bool state = false;         // 確定した状態
+    bool last = false;          // 前回読んだ入力
+    bool longFired = false;
+    std::int64_t tChange = 0;   // 入力が最後に変化した時刻
+    std::int64_t tPress = 0;    // 押下が確定した時刻
+    std::size_t next = 0;
+    bool level = false;
+
+    const std::int64_t end = edges.empty() ? 0 : edges.back().time + longPress + 2 * debounce;
+    for (std::int64_t t = period / 3; t < end; t += period) {
+        while (next < edges.size() && edges[next].time <= t) {
+            level = edges[next++].pressed;
+        }
+        if (level != last) {
+            tChange = t;
+        }
+        if (t - tChange > debounce && level != state) {
+            state = level;
+            if (state) {
+                tPress = t;
+                longFired = false;
+                fired.push_back({t, ButtonEvent::PRESS});
+            }
+            else {
+                fired.push_back({t, longFired ? ButtonEvent::RELEASE : ButtonEvent::CLICK});
+            }
+        }
+        last = level;
+        if (state && !longFired && t - tPress > longPress) {
+            longFired = true;
+            fired.push_back({t, ButtonEvent::LONG_PRESS});
+        }
+    }
+    return fired;
+}
+
+//! 遅れの集計 [us]
+struct Latency
+{
+    std::int64_t min = INT64_MAX;
+    std::int64_t max = 0;
+    double sum = 0;
+    std::size_t count = 0;
+
+    void add(std::int64_t v) {
+        min = std::min(min, v);
+        max = std::max(max, v);
+        sum += v;
+        ++count;
+    }
+
+    void print(const char* label) const {
+        if (count == 0) {
+            std::printf("  %-22s -\n", label);
+            return;
+        }
+        std::printf("  %-22s min %7.2f  mean %7.2f  max %7.2f  jitter %6.2f ms\n",
+                    label, min / 1000.0, sum / count / 1000.0, max / 1000.0,
+                    (max - min) / 1000.0);
+    }
+};
+
+/*!
+    @brief  イベント列を期待と照合し、遅れを集計する
+    @return 期待と異なった操作の数
+*/
+std::size_t evaluate(
+    const char* label,
+    const std::vector<Operation>& ops,
+    const std::vector<Fired>& fired,
+    bool verbose
+) {
+    Latency press, click, release;
+    std::size_t errors = 0;
+    std::size_t k = 0;
+
+    for (std::size_t i = 0; i < ops.size(); ++i) {
+        const auto& op = ops[i];
+        const std::int64_t until = i + 1 < ops.size() ? ops[i + 1].press : INT64_MAX;
+
+        // この操作に対応するイベント（次の操作の押し始めまで）
+        std::vector<Fired> got;
+        while (k < fired.size() && fired[k].time < until) {
+            // 操作より前のイベントはノイズに反応したもの
+            if (fired[k].time < op.press) {
+                ++errors;
+                if (verbose) {
+                    std::printf("%s: spurious %s at %.3f ms\n",
+                                label, name(fired[k].event), fired[k].time / 1000.0);
+                }
+            }
+            else {
+                got.push_back(fired[k]);
+            }
+            ++k;
+        }
+
+        const bool ok = op.isLong
+            ? got.size() == 3 && got[0].event == ButtonEvent::PRESS &&
+              got[1].event == ButtonEvent::LONG_PRESS && got[2].event == ButtonEvent::RELEASE
+            : got.size() == 2 && got[0].event == ButtonEvent::PRESS &&
+              got[1].event == ButtonEvent::CLICK;
+        if (!ok) {
+            ++errors;
+        }
+        else {
+            press.add(got[0].time - op.press);
+            if (op.isLong) {
+                release.add(got[2].time - op.release);
+            }
+            else {
+                click.add(got[1].time - op.release);
+            }
+        }
+
+        if (verbose) {
+            std::printf("%s: #%zu %s press %.3f release %.3f ->",
+                        label, i, op.isLong ? "long " : "short",
+                        op.press / 1000.0, op.release / 1000.0);
+            for (const auto& f : got) {
+                std::printf(" %s@%.3f", name(f.event), f.time / 1000.0);
+            }
+            std::printf("%s\n", ok ? "" : "  <-- unexpected");
+        }
+    }
+
+    std::printf("%s: %zu operations, %zu unexpected\n", label, ops.size(), errors);
+    press.print("press -> PRESS");
+    click.print("release -> CLICK");
+    release.print("release -> RELEASE");
+    return errors;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // 合成波形の生成
+    TraceGenerator gen(opts);
+    std::vector<Edge> edges;
+    std::vector<Operation> ops;
+    std::int64_t t = 0;
+    for (unsigned i = 0; i < opts.presses; ++i) {
+        ops.push_back(gen.append(t, edges));
+    }
+    std::printf("%zu edges, %u operations, debounce %u ms, long press %u ms\n",
+                edges.size(), opts.presses, opts.debounceMs, opts.longPressMs);
+
+    // 割り込み駆動と従来のポーリングの比較
+    const std::size_t errors = evaluate("interrupt", ops, runInterrupt(opts, edges), opts.verbose);
+    evaluate("polling", ops, runPolling(opts, edges), opts.verbose);
+
+    return errors == 0 ? 0 : 1;
+}
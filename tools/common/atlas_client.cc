@@ -0,0 +1,207 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "atlas_client.hh"
+
+// C++標準ライブラリ
+#include <cstring>      // std::memcpy
+#include <type_traits>  // std::is_trivially_copyable_v
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+const char* AtlasClient::statusName(Status status) noexcept
+{
+    switch (status) {
+    case Status::OK:             return "ok";
+    case Status::DISCONNECTED:   return "disconnected";
+    case Status::TIMEOUT:        return "timeout";
+    case Status::PROTOCOL_ERROR: return "protocol error";
+    }
+    return "?";
+}
+
+template <typename T>
+AtlasClient::Status AtlasClient::readValue(Characteristic chr, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "value is not trivially copyable");
+
+    std::vector<std::uint8_t> bytes;
+    if (!_transport.read(chr, bytes)) {
+        return this->failure();
+    }
+    if (bytes.size() != sizeof(T)) {
+        return Status::PROTOCOL_ERROR;
+    }
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return Status::OK;
+}
+
+AtlasClient::Status AtlasClient::writeValue(
+    Characteristic chr,
+    const std::uint8_t* data,
+    std::size_t size
+) {
+    return _transport.write(chr, data, size) ? Status::OK : this->failure();
+}
+
+//=============================================================================
+// 設定・結果
+//=============================================================================
+
+AtlasClient::Status AtlasClient::readDeviceInfo(DeviceInfo& info)
+{
+    return this->readValue(Characteristic::DEVINFO, info);
+}
+
+AtlasClient::Status AtlasClient::readParams(Params& params)
+{
+    return this->readValue(Characteristic::PARAMS, params);
+}
+
+AtlasClient::Status AtlasClient::writeParams(const Params& params)
+{
+    return this->writeValue(
+        Characteristic::PARAMS,
+        reinterpret_cast<const std::uint8_t*>(&params),
+        sizeof(Params)
+    );
+}
+
+AtlasClient::Status AtlasClient::readResult(Result& result)
+{
+    return this->readValue(Characteristic::RESULT, result);
+}
+
+AtlasClient::Status AtlasClient::clearResult()
+{
+    // 書き込む値は何でもよい（Webアプリと同じく1バイト）
+    const std::uint8_t value = 1;
+    return this->writeValue(Characteristic::RESULT, &value, 1);
+}
+
+AtlasClient::Status AtlasClient::shoot()
+{
+    const std::uint8_t value = 1;
+    return this->writeValue(Characteristic::SHOOT, &value, 1);
+}
+
+AtlasClient::Status AtlasClient::switchToAutoMode()
+{
+    const std::uint8_t value = 1;
+    return this->writeValue(Characteristic::SWITCH, &value, 1);
+}
+
+AtlasClient::Status AtlasClient::readBootReport(BootReport& report)
+{
+    return this->readValue(Characteristic::BOOT, report);
+}
+
+//=============================================================================
+// 生データ
+//=============================================================================
+
+AtlasClient::Status AtlasClient::readRawSize(std::uint32_t& size)
+{
+    RawTransferReport report;
+    const Status status = this->readRawReport(report);
+    size = report.size;
+    return status;
+}
+
+AtlasClient::Status AtlasClient::readRawReport(RawTransferReport& report)
+{
+    report.clear();
+
+    // 先頭の4バイトはファイルのバイト数（古いファームウェアはこれだけを返す）
+    std::vector<std::uint8_t> bytes;
+    if (!_transport.read(Characteristic::RAW_CTRL, bytes)) {
+        return this->failure();
+    }
+    if (bytes.size() == sizeof(report.size)) {
+        std::memcpy(&report.size, bytes.data(), sizeof(report.size));
+    }
+    else if (bytes.size() >= sizeof(RawTransferReport)) {
+        std::memcpy(&report, bytes.data(), sizeof(RawTransferReport));
+    }
+    else {
+        return Status::PROTOCOL_ERROR;
+    }
+    return Status::OK;
+}
+
+AtlasClient::Status AtlasClient::readRawData(std::vector<std::uint8_t>& data)
+{
+    this->rawPackets = 0;
+
+    std::uint32_t total = 0;
+    if (Status status = this->readRawSize(total); status != Status::OK) {
+        return status;
+    }
+
+    // ファイルが変わっていれば（短くなっていれば）先頭から
+    if (data.size() > total) {
+        data.clear();
+    }
+    const auto offset = static_cast<std::uint32_t>(data.size());
+    if (offset == total) {
+        return Status::OK;
+    }
+
+    if (!_transport.subscribe(Characteristic::RAW_DATA, true)) {
+        return this->failure();
+    }
+
+    // 前の転送の残りの通知を捨てる
+    GattNotification notification;
+    while (_transport.waitNotification(notification, 0)) {}
+
+    // 転送開始（途中からなら再開）
+    RawCtrlCommand cmd {RawCtrlCommand::Type::START, 0, 0};
+    if (offset > 0) {
+        cmd.type = RawCtrlCommand::Type::RESUME;
+        cmd.offset = offset;
+    }
+    std::uint8_t bytes[RawCtrlCommand::MAX_SIZE];
+    if (Status status = this->writeValue(Characteristic::RAW_CTRL, bytes, cmd.encode(bytes));
+        status != Status::OK) {
+        return status;
+    }
+
+    data.resize(total);
+    RawReceiver receiver;
+    receiver.begin(data.data(), total, offset);
+
+    Status status = Status::OK;
+    while (true) {
+        if (!_transport.waitNotification(notification, this->notificationTimeout)) {
+            status = this->failure();
+            break;
+        }
+        if (notification.chr != Characteristic::RAW_DATA) {
+            continue;
+        }
+        this->rawPackets += 1;
+
+        const auto event = receiver.onPacket(notification.data, notification.size);
+        if (event == RawReceiver::Event::INVALID) {
+            status = Status::PROTOCOL_ERROR;
+            break;
+        }
+        if (event == RawReceiver::Event::ACK || event == RawReceiver::Event::DONE) {
+            const RawCtrlCommand ack {RawCtrlCommand::Type::ACK, receiver.ackSeq(), 0};
+            status = this->writeValue(Characteristic::RAW_CTRL, bytes, ack.encode(bytes));
+            if (status != Status::OK || event == RawReceiver::Event::DONE) {
+                break;
+            }
+        }
+    }
+
+    // 受信できたところまで残す（次の呼び出しで再開する）
+    data.resize(receiver.received());
+    return status;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -0,0 +1,151 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_ATLAS_CLIENT_HH
+#define ATLAS_TOOLS_ATLAS_CLIENT_HH
+
+// C++標準ライブラリ
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t, std::uint16_t, std::uint32_t
+#include <vector>   // std::vector
+
+// ATLAS
+#include "ble_protocol.hh"
+#include "boot_profile.hh"
+#include "device_info.hh"
+#include "params.hh"
+#include "result.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 受信した通知
+struct GattNotification
+{
+    Characteristic chr;     //!< キャラクタリスティック
+    std::uint16_t size;     //!< バイト数
+    std::uint8_t data[ATLAS_MTU_SIZE - ATT_NOTIFY_OVERHEAD];  //!< 値
+};
+
+/*!
+    @brief  クライアント（セントラル）側のGATTの操作
+
+    BLEのスタックごとに実装する（tools/common/ble_loopback.hh はホスト上の擬似的な接続）。
+    どの操作も、切断されていれば失敗する。
+*/
+class GattTransport
+{
+public:
+    virtual ~GattTransport() = default;
+
+    //! 値を読み出す（MTUより長い値も全て読む）
+    virtual bool read(Characteristic chr, std::vector<std::uint8_t>& value) = 0;
+
+    //! 値を書き込む（応答を待つ）
+    virtual bool write(Characteristic chr, const std::uint8_t* data, std::size_t size) = 0;
+
+    //! 通知を購読する / やめる
+    virtual bool subscribe(Characteristic chr, bool enable) = 0;
+
+    //! 通知を timeout [ms] まで待つ（切断されたら false）
+    virtual bool waitNotification(GattNotification& notification, std::uint32_t timeout) = 0;
+
+    //! ATTのMTU
+    virtual std::uint16_t mtu() const = 0;
+
+    //! 接続しているか
+    virtual bool isConnected() const = 0;
+};
+
+/*!
+    @brief  ATLASのクライアント
+
+    Webアプリ（docs/）と同じ手順でATLASを操作する。
+    生データの読み出しは、切断されても受信済みの位置から再開できる。
+*/
+class AtlasClient
+{
+public:
+    //! 操作の結果
+    enum class Status : std::uint8_t
+    {
+        OK,             //!< 成功
+        DISCONNECTED,   //!< 切断された
+        TIMEOUT,        //!< 応答がない
+        PROTOCOL_ERROR  //!< 値の長さ・シーケンス番号が合わない
+    };
+
+    //! 結果の名前
+    static const char* statusName(Status status) noexcept;
+
+    explicit AtlasClient(GattTransport& transport) noexcept
+        : _transport(transport) {}
+
+    //! デバイス情報を読み出す
+    Status readDeviceInfo(DeviceInfo& info);
+
+    //! パラメータを読み出す
+    Status readParams(Params& params);
+
+    //! パラメータを書き込む
+    Status writeParams(const Params& params);
+
+    //! 解析結果を読み出す
+    Status readResult(Result& result);
+
+    //! 解析結果と生データを消去する
+    Status clearResult();
+
+    //! 手動で射出する（フルスペックのみ）
+    Status shoot();
+
+    //! オートモードに切り替える（スライドスイッチ以外）
+    Status switchToAutoMode();
+
+    //! 起動の段階ごとの時刻を読み出す
+    Status readBootReport(BootReport& report);
+
+    //! 生データファイルのバイト数を読み出す
+    Status readRawSize(std::uint32_t& size);
+
+    /*!
+        @brief  生データファイルのバイト数と、直前の転送の結果を読み出す
+        @note   バイト数だけを返す古いファームウェアなら、結果は転送していない状態になる
+    */
+    Status readRawReport(RawTransferReport& report);
+
+    /*!
+        @brief  生データファイルを読み出す
+        @param[in,out]  data  受信したデータ。途中まで受信したもの（失敗したときの値）を
+                              渡すと、その続きから受信する
+    */
+    Status readRawData(std::vector<std::uint8_t>& data);
+
+public:
+    //! 生データの通知を待つ最大時間 [ms]
+    std::uint32_t notificationTimeout = 2000;
+
+    //! 直前の readRawData で受け取った通知の数
+    std::uint32_t rawPackets = 0;
+
+private:
+    //! 決まった長さの値を読み出す
+    template <typename T>
+    Status readValue(Characteristic chr, T& value);
+
+    //! 値を書き込む
+    Status writeValue(Characteristic chr, const std::uint8_t* data, std::size_t size);
+
+    //! 失敗の理由
+    inline Status failure() const {
+        return _transport.isConnected() ? Status::TIMEOUT : Status::DISCONNECTED;
+    }
+
+private:
+    GattTransport& _transport;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
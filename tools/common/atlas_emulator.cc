@@ -0,0 +1,310 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "atlas_emulator.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min
+#include <cstring>      // std::memcpy, std::memset
+#include <type_traits>  // std::is_trivially_copyable_v
+
+// ATLAS
+#include "setting.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+namespace os = shark::os;
+
+// 値をバイト列にする
+template <typename T>
+void assign(std::vector<std::uint8_t>& value, const T& data)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "value is not trivially copyable");
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&data);
+    value.assign(bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+//=============================================================================
+// 生データ転送
+//=============================================================================
+
+// 生データ転送の入出力（rawData から読み、RAW_DATAの通知で送る）
+class AtlasEmulator::RawPort
+    : public RawSender::Port
+{
+public:
+    RawPort(AtlasEmulator& device, std::uint32_t offset)
+        : _device(device), _pos(offset) {}
+
+    std::size_t read(std::uint8_t* data, std::size_t size) override {
+        const auto& raw = _device.rawData;
+        const std::size_t length = std::min(size, raw.size() - std::min<std::size_t>(_pos, raw.size()));
+        std::memcpy(data, raw.data() + _pos, length);
+        _pos += length;
+        return length;
+    }
+
+    bool notify(const std::uint8_t* data, std::size_t size) override {
+        if (!_device._link->notify(Characteristic::RAW_DATA, data, size)) {
+            return false;
+        }
+        _device.sentBytes += static_cast<std::uint32_t>(size - RAW_HEADER_SIZE);
+        return true;
+    }
+
+    void waitTxSpace() override {
+        os::delay(1);
+    }
+
+    bool waitAck(std::uint32_t timeout) override {
+        return os::takeNotify(timeout);
+    }
+
+    bool takeAck(std::uint16_t& seq) override {
+        return _device._queueDataAck.receive(seq, 0);
+    }
+
+    bool aborted() override {
+        return _device._queueDataTrans.count() > 0 || !_device._notifyEnabled.load();
+    }
+
+private:
+    AtlasEmulator& _device;
+    std::size_t _pos;
+};
+
+void AtlasEmulator::taskDataTrans(void* arg)
+{
+    auto& self = *static_cast<AtlasEmulator*>(arg);
+    RawCtrlCommand cmd;
+
+    while (true) {
+        if (!self._queueDataTrans.receive(cmd)) {
+            continue;
+        }
+        if (!self._notifyEnabled.load() || !self._link) {
+            continue;
+        }
+
+        // 再開なら指定の位置から
+        const auto totalSize = static_cast<std::uint32_t>(self.rawData.size());
+        std::uint32_t offset = 0;
+        if (cmd.type == RawCtrlCommand::Type::RESUME) {
+            offset = std::min(cmd.offset, totalSize);
+        }
+
+        // 前回の転送の残りのACKと通知を捨てる
+        self._queueDataAck.reset();
+        os::takeNotify(0);
+
+        self.transfers += 1;
+        const std::uint32_t tStart = os::millis();
+        self.beginBulkTransfer();
+        RawPort port(self, offset);
+        const auto outcome = RawSender::run(port, totalSize - offset, rawPayloadSize(self._mtu.load()));
+        const std::uint32_t elapsed = os::millis() - tStart;
+        self.endBulkTransfer();
+        if (outcome.status == RawSender::Status::DONE) {
+            self.completed += 1;
+        }
+
+        // 結果を残す（RAW_CTRL の読み出しで返す）
+        self._rawReport.record(outcome, elapsed);
+        self._rawReport.interval = self._connInterval.load();
+        self._rawReport.dataLength = self._dataLength.load();
+        self._rawReport.phy = self._phy.load();
+    }
+}
+
+void AtlasEmulator::beginBulkTransfer()
+{
+    if (!this->bulkTransfer) {
+        return;
+    }
+    _link->updateConnParams(ATLAS_BULK_INTERVAL_MIN, ATLAS_BULK_INTERVAL_MAX);
+    _link->setDataLen(ATLAS_BULK_DATA_LENGTH);
+    _link->updatePhy(true);
+}
+
+void AtlasEmulator::endBulkTransfer()
+{
+    if (!this->bulkTransfer || !_notifyEnabled.load()) {
+        return;
+    }
+    _link->updateConnParams(ATLAS_IDLE_INTERVAL_MIN, ATLAS_IDLE_INTERVAL_MAX);
+}
+
+//=============================================================================
+// AtlasEmulator
+//=============================================================================
+
+AtlasEmulator::AtlasEmulator()
+{
+    deviceInfo.version.rev = REVISION;
+    deviceInfo.version.minor = MINOR_VERSION;
+    deviceInfo.version.major = MAJOR_VERSION;
+    deviceInfo.condition.format = ATLAS_FORMAT;
+    deviceInfo.condition.switchType = SWITCH_TYPE;
+    deviceInfo.condition.elrStyle = NUM_MOTORS - 1;
+    deviceInfo.condition.reserved = 0;
+
+    params.initialize();
+    result.clear();
+    std::memset(&latency, 0, sizeof(latency));
+    latency.numProbes = LatencyReport::NUM_PROBES;
+    latency.numBuckets = LatencyHistogram::NUM_BUCKETS;
+    std::memset(&boot, 0, sizeof(boot));
+    boot.numStages = BootReport::NUM_STAGES;
+    _rawReport.clear();
+}
+
+void AtlasEmulator::begin(std::uint8_t priority)
+{
+    _queueDataAck.begin();
+    _queueDataTrans.begin();
+    _taskDataTrans.start(taskDataTrans, "taskDataTrans", this, priority);
+}
+
+void AtlasEmulator::onConnect(BleLoopback& link)
+{
+    _link = &link;
+    _mtu.store(23);
+    _connInterval.store(static_cast<std::uint16_t>(link.interval() / 1250));
+    _phy.store(LINK_PHY_1M);
+    _dataLength.store(link.dataLength());
+}
+
+void AtlasEmulator::onDisconnect()
+{
+    // 送信中の生データ転送を止める
+    _notifyEnabled.store(false);
+    _taskDataTrans.notify();
+}
+
+void AtlasEmulator::onMTUChange(std::uint16_t mtu)
+{
+    _mtu.store(mtu);
+}
+
+void AtlasEmulator::onConnParamsUpdate(std::uint16_t interval)
+{
+    _connInterval.store(interval);
+}
+
+void AtlasEmulator::onPhyUpdate(std::uint8_t phy)
+{
+    _phy.store(phy);
+}
+
+void AtlasEmulator::onDataLengthChange(std::uint16_t length)
+{
+    _dataLength.store(length);
+}
+
+bool AtlasEmulator::onRead(Characteristic chr, std::vector<std::uint8_t>& value)
+{
+    switch (chr) {
+    case Characteristic::DEVINFO:
+        assign(value, this->deviceInfo);
+        return true;
+    case Characteristic::LATENCY:
+        assign(value, this->latency);
+        return true;
+    case Characteristic::BOOT:
+        assign(value, this->boot);
+        return true;
+    case Characteristic::PARAMS:
+        this->params.regulate();
+        assign(value, this->params);
+        return true;
+    case Characteristic::RESULT:
+        assign(value, this->result);
+        return true;
+    case Characteristic::RAW_CTRL: {
+        // 直前の転送の結果を続けて返す
+        RawTransferReport report = _rawReport;
+        report.size = static_cast<std::uint32_t>(this->rawData.size());
+        assign(value, report);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool AtlasEmulator::onWrite(Characteristic chr, const std::uint8_t* data, std::size_t size)
+{
+    switch (chr) {
+    case Characteristic::LATENCY:
+        std::memset(this->latency.probes, 0, sizeof(this->latency.probes));
+        return true;
+
+    case Characteristic::PARAMS: {
+        if (size != sizeof(Params)) {
+            return false;
+        }
+        // 同期調整時間は本体で較正した値を保持する
+        const auto syncAdj = this->params.syncAdj();
+        std::memcpy(&this->params, data, sizeof(Params));
+        if (!this->params.hasSyncAdj()) {
+            this->params.setSyncAdj(syncAdj);
+        }
+        this->params.regulate();
+        return true;
+    }
+
+    case Characteristic::RESULT:
+        this->result.clear();
+        this->rawData.clear();
+        return true;
+
+    case Characteristic::RAW_CTRL: {
+        const auto cmd = RawCtrlCommand::decode(data, size);
+        switch (cmd.type) {
+        case RawCtrlCommand::Type::ACK:
+            _queueDataAck.send(cmd.seq);
+            _taskDataTrans.notify();
+            break;
+        case RawCtrlCommand::Type::START:
+        case RawCtrlCommand::Type::RESUME:
+            _queueDataTrans.send(cmd);
+            _taskDataTrans.notify();
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+#if ATLAS_FORMAT == ATLAS_FULL_SPEC
+    case Characteristic::SHOOT:
+        this->shoots += 1;
+        return true;
+#endif
+
+#if SWITCH_TYPE != SW_SLIDE
+    case Characteristic::SWITCH:
+        this->autoMode = true;
+        return true;
+#endif
+
+    default:
+        return false;
+    }
+}
+
+void AtlasEmulator::onSubscribe(Characteristic chr, bool enabled)
+{
+    if (chr == Characteristic::RAW_DATA) {
+        _notifyEnabled.store(enabled);
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -0,0 +1,100 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_ATLAS_EMULATOR_HH
+#define ATLAS_TOOLS_ATLAS_EMULATOR_HH
+
+// C++標準ライブラリ
+#include <atomic>   // std::atomic_bool, std::atomic_uint8_t, std::atomic_uint16_t, std::atomic_uint32_t
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t, std::uint16_t, std::uint32_t
+#include <vector>   // std::vector
+
+// shark lib
+#include "os.hh"
+
+// ATLAS
+#include "ble_loopback.hh"
+#include "boot_profile.hh"
+#include "ble_protocol.hh"
+#include "device_info.hh"
+#include "latency_probe.hh"
+#include "params.hh"
+#include "result.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  ATLASのGATTサービスのエミュレーター（マニュアル/設定モード）
+
+    ファームウェアのコールバック（core/src/mode_manual.cc）と同じ応答をする。
+    生データの転送は、ファームウェアと同じ RawSender を専用のタスクで動かし、
+    転送の間は短い接続間隔・DLE・2M PHY を接続に要求する。
+    インスタンスごとに独立しているので、複数の機器を同時に動かせる。
+*/
+class AtlasEmulator
+    : public GattServer
+{
+public:
+    AtlasEmulator();
+
+    /*!
+        @brief  生データ転送タスクを開始する（タスクから呼ぶ）
+        @param[in]  priority  タスクの優先度（ファームウェアは1）
+    */
+    void begin(std::uint8_t priority = 1);
+
+    // GattServer
+    void onConnect(BleLoopback& link) override;
+    void onDisconnect() override;
+    void onMTUChange(std::uint16_t mtu) override;
+    void onConnParamsUpdate(std::uint16_t interval) override;
+    void onPhyUpdate(std::uint8_t phy) override;
+    void onDataLengthChange(std::uint16_t length) override;
+    bool onRead(Characteristic chr, std::vector<std::uint8_t>& value) override;
+    bool onWrite(Characteristic chr, const std::uint8_t* data, std::size_t size) override;
+    void onSubscribe(Characteristic chr, bool enabled) override;
+
+public:
+    DeviceInfo deviceInfo;              //!< デバイス情報
+    Params params;                      //!< パラメータ
+    Result result;                      //!< 解析結果
+    LatencyReport latency;              //!< 遅延の計測結果
+    BootReport boot;                    //!< 起動の段階ごとの時刻
+    std::vector<std::uint8_t> rawData;  //!< 生データファイルの内容
+    std::uint32_t shoots = 0;           //!< 手動射出の指令の回数
+    bool autoMode = false;              //!< オートモードへの切り替えの指令があったか
+    bool bulkTransfer = true;           //!< 転送の間、接続パラメータの変更を要求するか
+
+    std::atomic_uint32_t transfers = 0; //!< 生データの転送を始めた回数
+    std::atomic_uint32_t completed = 0; //!< 全てACKされた転送の回数
+    std::atomic_uint32_t sentBytes = 0; //!< 通知で送った生データのバイト数（再送を含む）
+
+private:
+    class RawPort;
+
+    //! 生データ転送タスク
+    static void taskDataTrans(void* arg);
+
+    //! バルク転送の開始・終了（接続パラメータの変更を要求する）
+    void beginBulkTransfer();
+    void endBulkTransfer();
+
+private:
+    BleLoopback* _link = nullptr;
+    shark::os::StaticQueue<RawCtrlCommand, 4> _queueDataTrans;          // 送信開始・再開
+    shark::os::StaticQueue<std::uint16_t, RAW_WINDOW_SIZE> _queueDataAck;   // ACK受信用
+    shark::os::StaticTask<4096> _taskDataTrans;                         // データ転送タスク
+    std::atomic_bool _notifyEnabled = false;    // 送信可否
+    std::atomic_uint16_t _mtu = 23;             // 接続中のMTU
+    std::atomic_uint16_t _connInterval = 0;     // 接続間隔 [1.25ms]
+    std::atomic_uint8_t _phy = LINK_PHY_1M;     // PHY
+    std::atomic_uint16_t _dataLength = LINK_DEFAULT_DATA_LENGTH;    // LLの最大ペイロード
+    RawTransferReport _rawReport;               // 直前の転送の結果
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -0,0 +1,192 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "bbp_synth.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max, std::min
+#include <cmath>        // std::pow, std::lround
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// フレームヘッダ（BBPAnalyzer と同じ）
+constexpr std::uint8_t HEADER_ATTACH_DETACH = 0xA0;
+constexpr std::uint8_t HEADER_LIST_FIRST    = 0xB0;
+constexpr std::uint8_t HEADER_LIST_LAST     = 0xB6;
+constexpr std::uint8_t HEADER_CHECKSUM      = 0xB7;
+constexpr std::uint8_t HEADER_PROF_FIRST    = 0x70;
+constexpr std::uint8_t HEADER_PROF_LAST     = 0x73;
+
+// シュートパワーリストの最大件数
+constexpr std::size_t MAX_SP_LIST = 50;
+
+// ベイバトルパスのユニークID（ダミー）
+constexpr std::uint8_t UNIQUE_ID[6] = {0x5A, 0x4D, 0x00, 0x00, 0x00, 0x01};
+
+// 空のフレーム
+shark::BBPData makeFrame(std::uint8_t header)
+{
+    shark::BBPData frame;
+    frame.clear();
+    frame.data()[0] = header;
+    return frame;
+}
+
+// 16ビット値をリトルエンディアンで書き込む
+void put16(shark::BBPData& frame, int offset, std::uint16_t value)
+{
+    frame.data()[offset] = value & 0xFF;
+    frame.data()[offset + 1] = value >> 8;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+std::uint16_t LaunchModel::profile(
+    std::mt19937& rng,
+    std::uint16_t* profile
+) const {
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // ランチャーの回転数 [rpm] の時間変化
+    auto spAt = [this](double t) {
+        double sp;
+        if (t < this->pullTime) {
+            double x = t / this->pullTime;
+            sp = this->startSP
+               + (this->peakSP - this->startSP) * std::pow(x, this->pullCurve);
+        }
+        else {
+            sp = this->peakSP - this->decay * (t - this->pullTime);
+        }
+
+        // 紐の巻き戻りによる三角形状の再加速
+        double dt = std::abs(t - (this->pullTime + this->rewindDelay));
+        if (this->rewindBump > 0 && dt < this->rewindWidth) {
+            sp += this->peakSP * this->rewindBump * (1.0 - dt / this->rewindWidth);
+        }
+        return std::max(sp, 300.0);
+    };
+
+    std::uint16_t maxSP = 0;
+    double t = 0;
+    for (int i = 0; i < 32; ++i) {
+        // 1回転に掛かる時間は、その回転中のSPで決まる
+        double dt = 60000.0 / spAt(t);
+        double dtMid = 60000.0 / spAt(t + dt * 0.5);
+        t += dtMid;
+
+        // センサー（8μs間隔）で計測される反射回数 = dt[ms] * 125
+        double refs = dtMid * 125 * (1.0 + this->noise * gauss(rng));
+        auto nRefs = static_cast<std::uint16_t>(
+            std::min(65535L, std::max(1L, std::lround(refs)))
+        );
+
+        // 計測抜け
+        if (this->dropout > 0 && uniform(rng) < this->dropout) {
+            nRefs = 0;
+        }
+        profile[i] = nRefs;
+
+        // BBPはプロファイル上の最大SPを記録する（巻き戻りのピークも含む）
+        if (nRefs > 0) {
+            auto sp = static_cast<std::uint16_t>(60000 / (nRefs / 125.0));
+            maxSP = std::max(maxSP, sp);
+        }
+    }
+    return maxSP;
+}
+
+//-----------------------------------------------------------------------------
+
+BBPFrameGenerator::BBPFrameGenerator(std::uint32_t seed)
+    : _rng(seed)
+{
+}
+
+void BBPFrameGenerator::_attachDetach(
+    std::uint8_t stateBey,
+    std::vector<shark::BBPData>& frames
+) {
+    auto frame = makeFrame(HEADER_ATTACH_DETACH);
+    frame.data()[1] = 0x3A;
+    frame.data()[3] = stateBey;
+    put16(frame, 7, _maxSP);
+    put16(frame, 9, _counter);
+    for (int i = 0; i < 6; ++i) {
+        frame.data()[11 + i] = UNIQUE_ID[i];
+    }
+    frames.push_back(frame);
+}
+
+void BBPFrameGenerator::enableELR(std::vector<shark::BBPData>& frames)
+{
+    _flag = 0x10;
+    _attachDetach(_flag, frames);
+}
+
+SyntheticShot BBPFrameGenerator::shot(
+    const LaunchModel& model,
+    std::vector<shark::BBPData>& frames,
+    bool corrupt
+) {
+    SyntheticShot shot;
+    shot.origSP = model.profile(_rng, shot.profile);
+
+    // BBP側の記録の更新
+    _counter += 1;
+    _maxSP = std::max(_maxSP, shot.origSP);
+    _spList.push_back(shot.origSP);
+    if (_spList.size() > MAX_SP_LIST) {
+        _spList.pop_front();
+    }
+
+    // ベイの装着 → 射出
+    _attachDetach(_flag | 0x04, frames);
+    _attachDetach(_flag, frames);
+
+    // シュートパワーリスト（B0-B6）
+    std::vector<shark::BBPData> list;
+    for (auto h = HEADER_LIST_FIRST; h <= HEADER_LIST_LAST; ++h) {
+        list.push_back(makeFrame(h));
+    }
+    for (std::size_t k = 0; k < _spList.size(); ++k) {
+        put16(list[k >> 3], static_cast<int>((k & 7) * 2 + 1), _spList[k]);
+    }
+    auto& last = list.back();
+    put16(last, 7, _maxSP);
+    put16(last, 9, _counter);
+    last.data()[11] = static_cast<std::uint8_t>(_spList.size());
+
+    // チェックサム（B0-B6の1-16バイト目の合計の下位8ビット）
+    std::uint32_t sum = 0;
+    for (const auto& frame : list) {
+        for (int i = 1; i < shark::BBPData::LENGTH; ++i) {
+            sum += frame.at(i);
+        }
+    }
+    auto checksum = makeFrame(HEADER_CHECKSUM);
+    checksum.data()[16] = static_cast<std::uint8_t>(sum + (corrupt ? 1 : 0));
+
+    frames.insert(frames.end(), list.begin(), list.end());
+    frames.push_back(checksum);
+
+    // SPプロファイル（70-73）
+    for (auto h = HEADER_PROF_FIRST; h <= HEADER_PROF_LAST; ++h) {
+        auto frame = makeFrame(h);
+        for (int i = 0; i < 8; ++i) {
+            put16(frame, i * 2 + 1, shot.profile[(h - HEADER_PROF_FIRST) * 8 + i]);
+        }
+        frames.push_back(frame);
+    }
+    return shot;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
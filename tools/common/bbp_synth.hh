@@ -0,0 +1,103 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_BBP_SYNTH_HH
+#define ATLAS_TOOLS_BBP_SYNTH_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t, std::uint16_t, std::uint32_t
+#include <deque>    // std::deque
+#include <random>   // std::mt19937
+#include <vector>   // std::vector
+
+// shark lib
+#include "bbp_data.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  ランチャーの引き（シュート）の物理モデル
+
+    ランチャーの回転数（SP）の時間変化を以下のようにモデル化する。
+    - 引き始め〜ピーク: sp(t) = startSP + (peakSP - startSP) * (t / pullTime)^pullCurve
+    - ピーク以降: decay [rpm/ms] で減速
+    - ストリングランチャーの紐の巻き戻りによる再加速（rewindBump）
+    - センサーノイズ（相対標準偏差）と計測抜け（プロファイル値0）
+*/
+struct LaunchModel
+{
+    double peakSP = 10000;      //!< ピークSP [rpm]
+    double startSP = 1500;      //!< 引き始めのSP [rpm]
+    double pullTime = 120;      //!< 引き始めからピークまでの時間 [ms]
+    double pullCurve = 1.5;     //!< 加速カーブの指数（1で等加速）
+    double decay = 8;           //!< ピーク以降の減速 [rpm/ms]
+    double rewindBump = 0;      //!< 巻き戻りによる再加速の大きさ（ピークSP比）
+    double rewindDelay = 15;    //!< ピークから再加速の頂点までの時間 [ms]
+    double rewindWidth = 10;    //!< 再加速の幅 [ms]
+    double noise = 0;           //!< センサーノイズ（相対標準偏差）
+    double dropout = 0;         //!< 計測抜けの確率
+
+    /*!
+        @brief  SPプロファイル（1回転あたりの反射計測回数, 32点）を生成する
+        @param[in]   rng      乱数生成器
+        @param[out]  profile  プロファイル
+        @return  BBPが記録するSP（プロファイル上の最大SP）
+    */
+    std::uint16_t profile(std::mt19937& rng, std::uint16_t* profile) const;
+};
+
+//! 生成した1シュートの情報
+struct SyntheticShot
+{
+    std::uint16_t origSP;           //!< BBPが記録するSP
+    std::uint16_t profile[32];      //!< SPプロファイル
+};
+
+/*!
+    @brief  ベイバトルパスのnotifyデータ列を生成するクラス
+
+    BBPAnalyzer が受け取るのと同じ順序・形式（A0, B0-B7, 70-73）でフレームを生成する。
+    シュートパワーリストはBBPと同様に直近50件を保持し、チェックサムも計算する。
+*/
+class BBPFrameGenerator
+{
+public:
+    explicit BBPFrameGenerator(std::uint32_t seed = 1);
+
+    //! 電動ランチャー連動の有効化（BBPのダブルクリック）フレームを追加する
+    void enableELR(std::vector<shark::BBPData>& frames);
+
+    /*!
+        @brief  1シュート分のフレーム列（装着, 射出, B0-B7, 70-73）を追加する
+        @param[in]   model    物理モデル
+        @param[out]  frames   フレームの追加先
+        @param[in]   corrupt  チェックサムを壊すか
+        @return  生成したシュートの情報
+    */
+    SyntheticShot shot(
+        const LaunchModel& model,
+        std::vector<shark::BBPData>& frames,
+        bool corrupt = false
+    );
+
+    //! 乱数生成器を返す
+    inline std::mt19937& rng() noexcept {
+        return _rng;
+    }
+
+private:
+    //! A0（ベイの着脱）フレームを追加する
+    void _attachDetach(std::uint8_t stateBey, std::vector<shark::BBPData>& frames);
+
+    std::mt19937 _rng;                  //!< 乱数生成器
+    std::deque<std::uint16_t> _spList;  //!< シュートパワーリスト（最大50件）
+    std::uint16_t _counter = 0;         //!< シュートカウンター
+    std::uint16_t _maxSP = 0;           //!< 最大シュートパワー
+    std::uint8_t _flag = 0;             //!< 電動ランチャー連動フラグ（0x00 / 0x10）
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
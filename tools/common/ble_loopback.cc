@@ -0,0 +1,366 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "ble_loopback.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::clamp, std::max, std::min
+#include <cstring>      // std::memcpy
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+namespace os = shark::os;
+
+// 切断を知らせる通知（受信側のキューに積む）
+constexpr auto DISCONNECTED = Characteristic::NUM_CHARACTERISTICS;
+
+// 購読のビット
+inline std::uint32_t bitOf(Characteristic chr)
+{
+    return 1UL << static_cast<std::uint8_t>(chr);
+}
+
+// パケット間隔（T_IFS） [us]
+constexpr std::uint32_t T_IFS = 150;
+
+// L2CAPのヘッダー [bytes]
+constexpr std::size_t L2CAP_HEADER_SIZE = 4;
+
+// ATTの要求・応答のPDU（ハンドルと短い値）の大きさの目安 [bytes]
+constexpr std::size_t ATT_REQUEST_SIZE = 3;
+
+// 接続間隔の単位 [us]
+constexpr std::uint32_t INTERVAL_UNIT = 1250;
+
+// LLのパケット1つの無線の時間 [us]（プリアンブル・アクセスアドレス・ヘッダー・CRCを含む）
+inline std::uint32_t packetTime(std::size_t payload, std::uint8_t phy)
+{
+    return phy == LINK_PHY_2M
+        ? static_cast<std::uint32_t>(2 + 4 + 2 + payload + 3) * 4
+        : static_cast<std::uint32_t>(1 + 4 + 2 + payload + 3) * 8;
+}
+
+} // namespace
+
+BleLoopback::BleLoopback(GattServer& server, const LinkConfig& config)
+    : _server(server),
+      _config(config),
+      _txStorage(config.txBuffers * sizeof(GattNotification)),
+      _rxStorage(RX_LENGTH * sizeof(GattNotification))
+{
+}
+
+void BleLoopback::begin()
+{
+    _tx.begin(_config.txBuffers, sizeof(GattNotification), _txStorage.data());
+    _rx.begin(RX_LENGTH, sizeof(GattNotification), _rxStorage.data());
+    _att.begin();
+    _event.begin();
+    _att.send(1);
+
+    _interval.store(_config.interval);
+    _timer.begin("connEvent", onEvent, this);
+    _timer.startPeriodic(_config.interval);
+}
+
+void BleLoopback::connect()
+{
+    if (_connected.load()) {
+        return;
+    }
+    _tx.reset();
+    _rx.reset();
+    _subscribed.store(0);
+
+    // 接続間隔・LLの最大ペイロード・PHYはセントラルの決めた初期値に戻る
+    _pendingEvents.store(0);
+    _pendingInterval.store(0);
+    _pendingDataLength.store(0);
+    _pendingPhy.store(0);
+    _dataLength.store(LINK_DEFAULT_DATA_LENGTH);
+    _phy.store(LINK_PHY_1M);
+    _carry = 0;
+    if (_interval.exchange(_config.interval) != _config.interval) {
+        _timer.stop();
+        _timer.startPeriodic(_config.interval);
+    }
+
+    _generation += 1;
+    _connected.store(true);
+
+    _server.onConnect(*this);
+    _server.onMTUChange(_config.mtu);
+}
+
+void BleLoopback::disconnect()
+{
+    if (!_connected.exchange(false)) {
+        return;
+    }
+    _generation += 1;
+    _subscribed.store(0);
+
+    // 送信バッファと受信済みの通知を捨て、通知を待つクライアントを起こす
+    _tx.reset();
+    _rx.reset();
+    GattNotification notification {DISCONNECTED, 0, {}};
+    _rx.send(&notification);
+
+    _server.onDisconnect();
+
+    // 接続イベントを待つ要求を失敗させる
+    if (_waiting.exchange(false)) {
+        _event.send(1);
+    }
+}
+
+bool BleLoopback::notify(Characteristic chr, const std::uint8_t* data, std::size_t size)
+{
+    if (!_connected.load()) {
+        return false;
+    }
+    if (!(_subscribed.load() & bitOf(chr))) {
+        return true;
+    }
+
+    // MTUを超える分は切り詰められる（NimBLEと同じ）
+    GattNotification notification;
+    notification.chr = chr;
+    notification.size = static_cast<std::uint16_t>(
+        std::min<std::size_t>(size, _config.mtu - ATT_NOTIFY_OVERHEAD));
+    std::memcpy(notification.data, data, notification.size);
+
+    if (!_tx.send(&notification, 0)) {
+        return false;
+    }
+    _notifications += 1;
+    return true;
+}
+
+void BleLoopback::updateConnParams(std::uint16_t minInterval, std::uint16_t maxInterval)
+{
+    if (!_connected.load() || minInterval > maxInterval) {
+        return;
+    }
+    // セントラルは範囲の中で受け入れられる最短の接続間隔を選ぶ
+    const std::uint32_t interval = std::min(
+        std::max<std::uint32_t>(minInterval * INTERVAL_UNIT, _config.minInterval),
+        std::max<std::uint32_t>(maxInterval * INTERVAL_UNIT, _config.minInterval)
+    );
+    _pendingInterval.store(interval);
+    _pendingEvents.store(PROCEDURE_EVENTS);
+}
+
+void BleLoopback::setDataLen(std::uint16_t octets)
+{
+    if (!_connected.load()) {
+        return;
+    }
+    _pendingDataLength.store(std::clamp(
+        octets, LINK_DEFAULT_DATA_LENGTH,
+        std::max(_config.maxDataLength, LINK_DEFAULT_DATA_LENGTH)
+    ));
+    _pendingEvents.store(std::max<std::uint32_t>(_pendingEvents.load(), 2));
+}
+
+void BleLoopback::updatePhy(bool use2M)
+{
+    if (!_connected.load()) {
+        return;
+    }
+    _pendingPhy.store(use2M && _config.phy2M ? LINK_PHY_2M : LINK_PHY_1M);
+    _pendingEvents.store(PROCEDURE_EVENTS);
+}
+
+std::uint32_t BleLoopback::pduTime(std::size_t size, std::uint16_t dataLength, std::uint8_t phy)
+{
+    // L2CAPのヘッダーを付けてLLの最大ペイロードで分割し、
+    // パケットごとにセントラル（空のパケット）とペリフェラルが1往復する
+    std::size_t rest = size + L2CAP_HEADER_SIZE;
+    std::uint32_t time = 0;
+    while (rest > 0) {
+        const std::size_t length = std::min<std::size_t>(rest, dataLength);
+        time += packetTime(0, phy) + T_IFS + packetTime(length, phy) + T_IFS;
+        rest -= length;
+    }
+    return time;
+}
+
+//=============================================================================
+// GattTransport
+//=============================================================================
+
+bool BleLoopback::read(Characteristic chr, std::vector<std::uint8_t>& value)
+{
+    return this->request(Op::READ, chr, nullptr, 0, &value);
+}
+
+bool BleLoopback::write(Characteristic chr, const std::uint8_t* data, std::size_t size)
+{
+    return this->request(Op::WRITE, chr, data, size, nullptr);
+}
+
+bool BleLoopback::subscribe(Characteristic chr, bool enable)
+{
+    const std::uint8_t value = enable ? 1 : 0;
+    return this->request(Op::SUBSCRIBE, chr, &value, 1, nullptr);
+}
+
+bool BleLoopback::waitNotification(GattNotification& notification, std::uint32_t timeout)
+{
+    if (!_connected.load() && _rx.count() == 0) {
+        return false;
+    }
+    if (!_rx.receive(&notification, timeout)) {
+        return false;
+    }
+    return notification.chr != DISCONNECTED;
+}
+
+std::uint16_t BleLoopback::mtu() const
+{
+    return _config.mtu;
+}
+
+bool BleLoopback::isConnected() const
+{
+    return _connected.load();
+}
+
+//=============================================================================
+// ATTの要求・接続イベント
+//=============================================================================
+
+bool BleLoopback::request(
+    Op op,
+    Characteristic chr,
+    const std::uint8_t* data,
+    std::size_t size,
+    std::vector<std::uint8_t>* value
+) {
+    // 要求は同時に1つだけ
+    std::uint8_t token;
+    _att.receive(token);
+
+    // 要求のPDU（書き込みは値を含む）
+    const std::uint32_t generation = _generation.load();
+    bool ok = _connected.load() && this->waitEvent(generation, ATT_REQUEST_SIZE + size);
+    if (ok) {
+        _requests += 1;
+        const auto properties = characteristicSpec(chr).properties;
+        switch (op) {
+        case Op::READ: {
+            value->clear();
+            ok = (properties & property::READ) && _server.onRead(chr, *value);
+            // MTU-1 バイトより長ければ、残りを読む要求を繰り返す
+            const std::size_t chunk = _config.mtu - 1;
+            for (std::size_t pos = chunk; ok && pos <= value->size(); pos += chunk) {
+                ok = this->waitEvent(generation, 1 + chunk) &&
+                     this->waitEvent(generation, ATT_REQUEST_SIZE + 2);
+                _requests += 1;
+            }
+            // 最後の応答の大きさ
+            size = ok ? value->size() % chunk : 0;
+            break;
+        }
+        case Op::WRITE:
+            ok = (properties & property::WRITE) &&
+                 size + ATT_NOTIFY_OVERHEAD <= _config.mtu &&
+                 _server.onWrite(chr, data, size);
+            break;
+        case Op::SUBSCRIBE:
+            ok = (properties & property::NOTIFY);
+            if (ok) {
+                if (data[0]) {
+                    _subscribed |= bitOf(chr);
+                }
+                else {
+                    _subscribed &= ~bitOf(chr);
+                }
+                _server.onSubscribe(chr, data[0] != 0);
+            }
+            break;
+        }
+
+        // 応答は次の接続イベントで返る
+        ok = this->waitEvent(generation, 1 + (op == Op::READ ? size : 0)) && ok;
+    }
+
+    _att.send(token);
+    return ok;
+}
+
+bool BleLoopback::waitEvent(std::uint32_t generation, std::size_t pduSize)
+{
+    _waitingPdu.store(static_cast<std::uint32_t>(pduSize));
+    _waiting.store(true);
+    std::uint8_t token;
+    _event.receive(token);
+    return _connected.load() && _generation.load() == generation;
+}
+
+void BleLoopback::applyUpdates()
+{
+    if (_pendingEvents.load() == 0 || --_pendingEvents > 0) {
+        return;
+    }
+
+    if (const auto length = _pendingDataLength.exchange(0)) {
+        if (_dataLength.exchange(length) != length) {
+            _server.onDataLengthChange(length);
+        }
+    }
+    if (const auto phy = _pendingPhy.exchange(0)) {
+        if (_phy.exchange(phy) != phy) {
+            _server.onPhyUpdate(phy);
+        }
+    }
+    if (const auto interval = _pendingInterval.exchange(0)) {
+        if (_interval.exchange(interval) != interval) {
+            _timer.stop();
+            _timer.startPeriodic(interval);
+            _server.onConnParamsUpdate(static_cast<std::uint16_t>(interval / INTERVAL_UNIT));
+        }
+    }
+}
+
+void BleLoopback::onEvent(void* arg)
+{
+    auto& self = *static_cast<BleLoopback*>(arg);
+    const std::uint16_t dataLength = self._dataLength.load();
+    const std::uint8_t phy = self._phy.load();
+
+    // 接続イベントの長さ（前の接続イベントからはみ出した分を引く）
+    const std::uint32_t interval = self._interval.load();
+    const std::uint32_t length = self._config.eventLength
+        ? std::min(self._config.eventLength, interval) : interval;
+    std::int64_t budget = static_cast<std::int64_t>(length) - T_IFS - self._carry;
+
+    // ATTの要求・応答（切断中なら失敗させるために起こす）
+    if (self._waiting.exchange(false)) {
+        budget -= pduTime(self._waitingPdu.load(), dataLength, phy);
+        self._event.send(1);
+    }
+    if (!self._connected.load()) {
+        self._carry = 0;
+        return;
+    }
+
+    // 通知（最後の通知が収まらなければ次の接続イベントに続きを送る。
+    // クライアントの受信側が一杯なら次の接続イベントまで待つ）
+    GattNotification notification;
+    while (budget > 0 && self._rx.count() < RX_LENGTH && self._tx.receive(&notification, 0)) {
+        budget -= pduTime(notification.size + ATT_NOTIFY_OVERHEAD, dataLength, phy);
+        self._rx.send(&notification, 0);
+    }
+    self._carry = budget < 0 ? std::min<std::int64_t>(-budget, interval) : 0;
+
+    self.applyUpdates();
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
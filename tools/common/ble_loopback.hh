@@ -0,0 +1,251 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_BLE_LOOPBACK_HH
+#define ATLAS_TOOLS_BLE_LOOPBACK_HH
+
+// C++標準ライブラリ
+#include <atomic>   // std::atomic_bool, std::atomic_uint8_t, std::atomic_uint16_t, std::atomic_uint32_t
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t, std::uint16_t, std::uint32_t, std::int64_t, std::uint64_t
+#include <vector>   // std::vector
+
+// shark lib
+#include "os.hh"
+
+// ATLAS
+#include "atlas_client.hh"
+#include "ble_protocol.hh"
+
+/*
+    ホスト上の擬似的なBLE接続
+
+    OSの抽象化層（os.hh）の上で、ペリフェラル（GattServer）とクライアント（AtlasClient）を
+    1本の接続でつなぐ。ホストの os_sim.cc と組み合わせると仮想時刻で動くので、
+    無線なしで同期のスループット・再開・同時操作を調べられる。
+
+    - 通信は接続間隔ごとの接続イベントでだけ行う（周期タイマー）
+    - 1回の接続イベントで送れるのは、無線の時間が接続イベントの長さに収まる分まで。
+      ATTのPDUはL2CAPのヘッダーを付けてLLの最大ペイロード（接続時は27バイト）で分割し、
+      分割したパケットごとに、セントラルの空のパケットとの往復とパケット間隔（150us）を数える。
+      収まらなかった分は次の接続イベントに回る
+    - ATTの要求は同時に1つだけ（BLEと同じ）。要求は次の接続イベントで送られ、
+      応答はその次の接続イベントで返る。MTU-1 バイトより長い値の読み出しは、
+      残りを読む要求（Read Blob）を繰り返す
+    - ペリフェラルは接続間隔・LLの最大ペイロード・PHYの変更を要求できる。
+      セントラルの対応する範囲（LinkConfig）で、数回の接続イベントの後に変わる
+    - 通知はMTU-3バイトで切り詰める。送信バッファ（LinkConfig::txBuffers 個）が
+      一杯なら notify() は false を返す
+    - 切断すると送信バッファ・受信済みの通知・購読を捨て、待っている操作は失敗する
+*/
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 接続の設定（セントラルが決める・対応する値）
+struct LinkConfig
+{
+    std::uint16_t mtu = ATLAS_MTU_SIZE;     //!< ATTのMTU
+    std::uint32_t interval = 30000;         //!< 接続したときの接続間隔 [us]
+    std::uint32_t minInterval = 7500;       //!< 受け入れる最短の接続間隔 [us]
+    std::uint32_t eventLength = 0;          //!< 接続イベントの最大の長さ [us]（0なら接続間隔いっぱい）
+    std::uint16_t maxDataLength = 251;      //!< 受け入れるLLの最大ペイロード [bytes]（27ならDLEなし）
+    bool phy2M = true;                      //!< 2M PHYに対応しているか
+    std::uint8_t txBuffers = 12;            //!< ペリフェラルの送信バッファ（通知の数）
+};
+
+//! PHY（NimBLEの BLE_GAP_LE_PHY_* と同じ値）
+constexpr std::uint8_t LINK_PHY_1M = 1;
+constexpr std::uint8_t LINK_PHY_2M = 2;
+
+//! LLの最大ペイロードの既定値（Data Length Extension を使わないとき） [bytes]
+constexpr std::uint16_t LINK_DEFAULT_DATA_LENGTH = 27;
+
+class BleLoopback;
+
+/*!
+    @brief  ペリフェラル（サーバー）側のコールバック
+
+    読み書きのコールバックは、要求を送ったクライアントのタスクから呼ばれる。
+*/
+class GattServer
+{
+public:
+    //! 接続された（link で通知を送る）
+    virtual void onConnect(BleLoopback& link) = 0;
+
+    //! 切断された
+    virtual void onDisconnect() = 0;
+
+    //! MTUが決まった
+    virtual void onMTUChange(std::uint16_t mtu) = 0;
+
+    //! 接続間隔が変わった [1.25ms]
+    virtual void onConnParamsUpdate(std::uint16_t interval) = 0;
+
+    //! PHYが変わった
+    virtual void onPhyUpdate(std::uint8_t phy) = 0;
+
+    //! LLの最大ペイロードが変わった [bytes]
+    virtual void onDataLengthChange(std::uint16_t length) = 0;
+
+    //! 読み出し（読めなければ false）
+    virtual bool onRead(Characteristic chr, std::vector<std::uint8_t>& value) = 0;
+
+    //! 書き込み（書けなければ false）
+    virtual bool onWrite(Characteristic chr, const std::uint8_t* data, std::size_t size) = 0;
+
+    //! 購読された / やめた
+    virtual void onSubscribe(Characteristic chr, bool enabled) = 0;
+
+protected:
+    ~GattServer() = default;
+};
+
+/*!
+    @brief  ペリフェラルとクライアントをつなぐ擬似的なBLE接続
+
+    クライアントには GattTransport として見え、ペリフェラルは notify() で通知を送る。
+*/
+class BleLoopback
+    : public GattTransport
+{
+public:
+    BleLoopback(GattServer& server, const LinkConfig& config);
+
+    //! キュー・接続イベントのタイマーを作る（タスクから呼ぶ）
+    void begin();
+
+    //! 接続する（MTUの交換も済ませる）
+    void connect();
+
+    //! 切断する
+    void disconnect();
+
+    /*!
+        @brief  通知を送る（ペリフェラルから呼ぶ）
+        @return 送信バッファに積めたか（未接続・送信バッファが一杯なら false。
+                購読されていなければ送らずに true）
+    */
+    bool notify(Characteristic chr, const std::uint8_t* data, std::size_t size);
+
+    /*!
+        @brief  接続間隔の変更を要求する（ペリフェラルから呼ぶ）
+        @param[in]  minInterval  下限 [1.25ms]
+        @param[in]  maxInterval  上限 [1.25ms]（セントラルの最短の接続間隔が長ければ、それになる）
+    */
+    void updateConnParams(std::uint16_t minInterval, std::uint16_t maxInterval);
+
+    //! LLの最大ペイロードの変更を要求する（ペリフェラルから呼ぶ）
+    void setDataLen(std::uint16_t octets);
+
+    //! 2M PHYへの変更を要求する（ペリフェラルから呼ぶ）
+    void updatePhy(bool use2M);
+
+    //! 現在の接続間隔 [us]
+    inline std::uint32_t interval() const noexcept {
+        return _interval.load();
+    }
+
+    //! 現在のLLの最大ペイロード [bytes]
+    inline std::uint16_t dataLength() const noexcept {
+        return _dataLength.load();
+    }
+
+    //! 現在のPHY
+    inline std::uint8_t phy() const noexcept {
+        return _phy.load();
+    }
+
+    /*!
+        @brief  ATTのPDUを送る無線の時間 [us]
+        @param[in]  size        PDUのバイト数（通知なら値 + ATT_NOTIFY_OVERHEAD）
+        @param[in]  dataLength  LLの最大ペイロード
+        @param[in]  phy         PHY
+    */
+    static std::uint32_t pduTime(std::size_t size, std::uint16_t dataLength, std::uint8_t phy);
+
+    //! 接続の設定
+    inline const LinkConfig& config() const noexcept {
+        return _config;
+    }
+
+    //! 送った通知の数
+    inline std::uint64_t notifications() const noexcept {
+        return _notifications.load();
+    }
+
+    //! ATTの要求の数（Read Blob を含む）
+    inline std::uint64_t requests() const noexcept {
+        return _requests.load();
+    }
+
+    // GattTransport
+    bool read(Characteristic chr, std::vector<std::uint8_t>& value) override;
+    bool write(Characteristic chr, const std::uint8_t* data, std::size_t size) override;
+    bool subscribe(Characteristic chr, bool enable) override;
+    bool waitNotification(GattNotification& notification, std::uint32_t timeout) override;
+    std::uint16_t mtu() const override;
+    bool isConnected() const override;
+
+private:
+    //! ATTの要求
+    enum class Op : std::uint8_t
+    {
+        READ,
+        WRITE,
+        SUBSCRIBE
+    };
+
+    //! 要求を送って応答を待つ
+    bool request(Op op, Characteristic chr,
+                 const std::uint8_t* data, std::size_t size,
+                 std::vector<std::uint8_t>* value);
+
+    //! ATTのPDU（pduSize バイト）を送る次の接続イベントを待つ（接続 generation のままなら true）
+    bool waitEvent(std::uint32_t generation, std::size_t pduSize);
+
+    //! 接続パラメータの変更を反映する（接続イベントから呼ぶ）
+    void applyUpdates();
+
+    //! 接続イベント（タイマーのコールバック）
+    static void onEvent(void* arg);
+
+private:
+    //! 受信側のキューの長さ（クライアントが受け取るまで、これ以上は送らない）
+    static constexpr std::uint32_t RX_LENGTH = 64;
+
+    //! 接続パラメータ・PHYの変更が反映されるまでの接続イベントの数
+    static constexpr std::uint32_t PROCEDURE_EVENTS = 6;
+
+    GattServer& _server;
+    const LinkConfig _config;
+
+    shark::os::Queue _tx;                       // 送信バッファ（GattNotification）
+    shark::os::Queue _rx;                       // 受信した通知（GattNotification）
+    shark::os::StaticQueue<std::uint8_t, 1> _att;       // ATTの要求の権利
+    shark::os::StaticQueue<std::uint8_t, 1> _event;     // 要求を送る接続イベントの知らせ
+    shark::os::Timer _timer;                    // 接続イベント
+    std::vector<std::uint8_t> _txStorage;
+    std::vector<std::uint8_t> _rxStorage;
+
+    std::atomic_bool _connected = false;        // 接続中か
+    std::atomic_uint32_t _generation = 0;       // 接続の番号（切断で失敗させる）
+    std::atomic_bool _waiting = false;          // 接続イベントを待つ要求があるか
+    std::atomic_uint32_t _waitingPdu = 0;       // 待っている要求・応答のPDUのバイト数
+    std::atomic_uint32_t _interval = 0;         // 接続間隔 [us]
+    std::atomic_uint16_t _dataLength = LINK_DEFAULT_DATA_LENGTH;    // LLの最大ペイロード
+    std::atomic_uint8_t _phy = LINK_PHY_1M;     // PHY
+    std::atomic_uint32_t _pendingInterval = 0;  // 変更を要求された接続間隔 [us]（0なら要求なし）
+    std::atomic_uint16_t _pendingDataLength = 0;    // 変更を要求されたLLの最大ペイロード
+    std::atomic_uint8_t _pendingPhy = 0;        // 変更を要求されたPHY
+    std::atomic_uint32_t _pendingEvents = 0;    // 変更が反映されるまでの接続イベントの数
+    std::int64_t _carry = 0;                    // 前の接続イベントから持ち越した無線の時間 [us]
+    std::atomic_uint32_t _subscribed = 0;       // 購読中のキャラクタリスティック（ビット）
+    std::atomic<std::uint64_t> _notifications = 0;
+    std::atomic<std::uint64_t> _requests = 0;
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
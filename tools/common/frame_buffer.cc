@@ -0,0 +1,318 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "frame_buffer.hh"
+
+// C++標準ライブラリ
+#include <algorithm>    // std::fill, std::swap
+#include <cstdio>       // std::snprintf
+#include <cstdlib>      // std::abs
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// クラシックフォント（5x7、' '〜'~'）。1バイトが1列、LSBが上
+constexpr char FONT_FIRST = 0x20;
+constexpr char FONT_LAST = 0x7E;
+constexpr std::uint8_t FONT[][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, // ' ' '!'
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14}, // '"' '#'
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, // '$' '%'
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, // '&' '''
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00}, // '(' ')'
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08}, // '*' '+'
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, // ',' '-'
+    {0x00, 0x00, 0x60, 0x60, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02}, // '.' '/'
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, // '0' '1'
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, // '2' '3'
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, // '4' '5'
+    {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07}, // '6' '7'
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, // '8' '9'
+    {0x00, 0x00, 0x14, 0x00, 0x00}, {0x00, 0x40, 0x34, 0x00, 0x00}, // ':' ';'
+    {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14}, // '<' '='
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, // '>' '?'
+    {0x3E, 0x41, 0x5D, 0x59, 0x4E}, {0x7C, 0x12, 0x11, 0x12, 0x7C}, // '@' 'A'
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22}, // 'B' 'C'
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, // 'D' 'E'
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x73}, // 'F' 'G'
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, // 'H' 'I'
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, // 'J' 'K'
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x1C, 0x02, 0x7F}, // 'L' 'M'
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E}, // 'N' 'O'
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, // 'P' 'Q'
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x26, 0x49, 0x49, 0x49, 0x32}, // 'R' 'S'
+    {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, // 'T' 'U'
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, // 'V' 'W'
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03}, // 'X' 'Y'
+    {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41}, // 'Z' '['
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, // '\' ']'
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40}, // '^' '_'
+    {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40}, // '`' 'a'
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, // 'b' 'c'
+    {0x38, 0x44, 0x44, 0x28, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18}, // 'd' 'e'
+    {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78}, // 'f' 'g'
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, // 'h' 'i'
+    {0x20, 0x40, 0x40, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00}, // 'j' 'k'
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78}, // 'l' 'm'
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, // 'n' 'o'
+    {0xFC, 0x18, 0x24, 0x24, 0x18}, {0x18, 0x24, 0x24, 0x18, 0xFC}, // 'p' 'q'
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24}, // 'r' 's'
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, // 't' 'u'
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C}, // 'v' 'w'
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C}, // 'x' 'y'
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, // 'z' '{'
+    {0x00, 0x00, 0x77, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, // '|' '}'
+    {0x02, 0x01, 0x02, 0x04, 0x02},                                 // '~'
+};
+static_assert(sizeof(FONT) / sizeof(FONT[0]) == FONT_LAST - FONT_FIRST + 1,
+              "font table does not cover ' ' to '~'");
+
+// 文字セルの大きさ（5x7の文字 + 1ドットの間隔）
+constexpr std::int16_t CHAR_W = 6;
+constexpr std::int16_t CHAR_H = 8;
+
+} // namespace
+
+FrameBuffer::FrameBuffer(std::uint8_t width, std::uint8_t height)
+    : _width(width),
+      _height(height),
+      _buffer(static_cast<std::size_t>(width) * ((height + 7) / 8), 0)
+{
+}
+
+void FrameBuffer::clearDisplay()
+{
+    std::fill(_buffer.begin(), _buffer.end(), 0);
+}
+
+bool FrameBuffer::getPixel(std::int16_t x, std::int16_t y) const
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+        return false;
+    }
+    return (_buffer[x + (y / 8) * _width] >> (y & 7)) & 1;
+}
+
+void FrameBuffer::drawPixel(std::int16_t x, std::int16_t y, std::uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+        return;
+    }
+    std::uint8_t& b = _buffer[x + (y / 8) * _width];
+    const std::uint8_t bit = 1 << (y & 7);
+    switch (color) {
+    case 0:  b &= ~bit; break;
+    case 1:  b |= bit;  break;
+    default: b ^= bit;  break;
+    }
+}
+
+void FrameBuffer::drawBitmap(
+    std::int16_t x,
+    std::int16_t y,
+    const std::uint8_t* bitmap,
+    std::int16_t w,
+    std::int16_t h,
+    std::uint16_t color
+) {
+    const std::int16_t byteWidth = (w + 7) / 8;
+    for (std::int16_t j = 0; j < h; j += 1) {
+        const std::uint8_t* row = bitmap + j * byteWidth;
+        for (std::int16_t i = 0; i < w; i += 1) {
+            if (row[i / 8] & (0x80 >> (i & 7))) {
+                this->drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+}
+
+void FrameBuffer::drawLine(
+    std::int16_t x0,
+    std::int16_t y0,
+    std::int16_t x1,
+    std::int16_t y1,
+    std::uint16_t color
+) {
+    // Adafruit GFX と同じブレゼンハムのアルゴリズム
+    const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    const std::int16_t dx = x1 - x0;
+    const std::int16_t dy = std::abs(y1 - y0);
+    const std::int16_t ystep = y0 < y1 ? 1 : -1;
+    std::int16_t err = dx / 2;
+    for (; x0 <= x1; x0 += 1) {
+        if (steep) {
+            this->drawPixel(y0, x0, color);
+        }
+        else {
+            this->drawPixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void FrameBuffer::drawRect(
+    std::int16_t x,
+    std::int16_t y,
+    std::int16_t w,
+    std::int16_t h,
+    std::uint16_t color
+) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    this->fillRect(x, y, w, 1, color);
+    this->fillRect(x, y + h - 1, w, 1, color);
+    this->fillRect(x, y, 1, h, color);
+    this->fillRect(x + w - 1, y, 1, h, color);
+}
+
+void FrameBuffer::fillRect(
+    std::int16_t x,
+    std::int16_t y,
+    std::int16_t w,
+    std::int16_t h,
+    std::uint16_t color
+) {
+    for (std::int16_t j = y; j < y + h; j += 1) {
+        for (std::int16_t i = x; i < x + w; i += 1) {
+            this->drawPixel(i, j, color);
+        }
+    }
+}
+
+void FrameBuffer::write(char c)
+{
+    // Adafruit GFX と同じく、右端で折り返す
+    if (c == '\n') {
+        _cursorX = 0;
+        _cursorY += _textSize * CHAR_H;
+        return;
+    }
+    if (c == '\r') {
+        return;
+    }
+    if (_cursorX + _textSize * CHAR_W > _width) {
+        _cursorX = 0;
+        _cursorY += _textSize * CHAR_H;
+    }
+    this->_drawChar(_cursorX, _cursorY, c);
+    _cursorX += _textSize * CHAR_W;
+}
+
+void FrameBuffer::print(const char* text)
+{
+    for (; *text; text += 1) {
+        this->write(*text);
+    }
+}
+
+void FrameBuffer::print(std::int32_t number)
+{
+    char buf[12];
+    std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(number));
+    this->print(buf);
+}
+
+void FrameBuffer::_drawChar(std::int16_t x, std::int16_t y, char c)
+{
+    // フォントにない文字は描かない（背景は透過なので何もしない）
+    if (c < FONT_FIRST || c > FONT_LAST) {
+        return;
+    }
+    const std::uint8_t* glyph = FONT[c - FONT_FIRST];
+    for (std::int16_t i = 0; i < 5; i += 1) {
+        std::uint8_t line = glyph[i];
+        for (std::int16_t j = 0; j < CHAR_H; j += 1, line >>= 1) {
+            if (line & 1) {
+                this->fillRect(x + i * _textSize, y + j * _textSize,
+                               _textSize, _textSize, _textColor);
+            }
+        }
+    }
+}
+
+std::string FrameBuffer::toPBM() const
+{
+    // 点灯しているドットを1（黒）とする
+    char header[32];
+    const int n = std::snprintf(header, sizeof(header), "P4\n%u %u\n", _width, _height);
+    std::string data(header, n);
+    const std::int16_t rowBytes = (_width + 7) / 8;
+    for (std::int16_t y = 0; y < _height; y += 1) {
+        for (std::int16_t b = 0; b < rowBytes; b += 1) {
+            std::uint8_t v = 0;
+            for (std::int16_t i = 0; i < 8; i += 1) {
+                if (this->getPixel(b * 8 + i, y)) {
+                    v |= 0x80 >> i;
+                }
+            }
+            data.push_back(static_cast<char>(v));
+        }
+    }
+    return data;
+}
+
+bool FrameBuffer::fromPBM(const std::string& data)
+{
+    // ヘッダ："P4" 幅 高さ（空白・コメント区切り）の後、空白1文字で画像データ
+    std::size_t pos = 0;
+    auto nextToken = [&]() {
+        while (pos < data.size()) {
+            if (data[pos] == '#') {
+                while (pos < data.size() && data[pos] != '\n') {
+                    pos += 1;
+                }
+            }
+            else if (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n') {
+                pos += 1;
+            }
+            else {
+                break;
+            }
+        }
+        const std::size_t begin = pos;
+        while (pos < data.size() && data[pos] > ' ') {
+            pos += 1;
+        }
+        return data.substr(begin, pos - begin);
+    };
+    if (nextToken() != "P4") {
+        return false;
+    }
+    const int w = std::atoi(nextToken().c_str());
+    const int h = std::atoi(nextToken().c_str());
+    pos += 1;
+    const std::int16_t rowBytes = (_width + 7) / 8;
+    if (w != _width || h != _height || data.size() < pos + rowBytes * _height) {
+        return false;
+    }
+
+    this->clearDisplay();
+    for (std::int16_t y = 0; y < _height; y += 1) {
+        for (std::int16_t x = 0; x < _width; x += 1) {
+            const auto v = static_cast<std::uint8_t>(data[pos + y * rowBytes + x / 8]);
+            if (v & (0x80 >> (x & 7))) {
+                this->drawPixel(x, y, 1);
+            }
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark
@@ -0,0 +1,152 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef SHARK_MINISTER_FRAME_BUFFER_HH
+#define SHARK_MINISTER_FRAME_BUFFER_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t, std::int16_t
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+namespace shark {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  ホスト（PC）上のメモリに描画するモノクロディスプレイ
+
+    MonochromeDisplay<T> が使う Adafruit ドライバのメソッドだけを実装する。
+    バッファの配置（ページ単位、1バイト = 縦8ドット）と描画結果は
+    Adafruit GFX と同じになるようにしてある。文字はクラシックフォント（5x7）。
+*/
+class FrameBuffer
+{
+public:
+    FrameBuffer(std::uint8_t width, std::uint8_t height);
+
+    //! 開始（アドレスは使わない）
+    inline bool begin(std::uint8_t /*screen_addr*/) {
+        return true;
+    }
+
+    //! バッファをクリアする
+    void clearDisplay();
+
+    //! 画面への反映（回数を数えるだけ）
+    inline void display() {
+        _displayCount += 1;
+    }
+
+    inline std::uint8_t* getBuffer() {
+        return _buffer.data();
+    }
+
+    inline const std::uint8_t* getBuffer() const {
+        return _buffer.data();
+    }
+
+    inline std::uint8_t width() const {
+        return _width;
+    }
+
+    inline std::uint8_t height() const {
+        return _height;
+    }
+
+    inline std::uint32_t displayCount() const {
+        return _displayCount;
+    }
+
+    //! 点の色（0 or 1）を返す。範囲外は0
+    bool getPixel(std::int16_t x, std::int16_t y) const;
+
+    //! 点を描画する（0: 黒、1: 白、2: 反転）
+    void drawPixel(std::int16_t x, std::int16_t y, std::uint16_t color);
+
+    //! 1行 (w+7)/8 バイト、MSBが左のビットマップを描画する（0のビットは透過）
+    void drawBitmap(
+        std::int16_t x,
+        std::int16_t y,
+        const std::uint8_t* bitmap,
+        std::int16_t w,
+        std::int16_t h,
+        std::uint16_t color
+    );
+
+    void drawLine(
+        std::int16_t x0,
+        std::int16_t y0,
+        std::int16_t x1,
+        std::int16_t y1,
+        std::uint16_t color
+    );
+
+    void drawRect(
+        std::int16_t x,
+        std::int16_t y,
+        std::int16_t w,
+        std::int16_t h,
+        std::uint16_t color
+    );
+
+    void fillRect(
+        std::int16_t x,
+        std::int16_t y,
+        std::int16_t w,
+        std::int16_t h,
+        std::uint16_t color
+    );
+
+    inline void setTextColor(std::uint16_t color) {
+        _textColor = color;
+    }
+
+    inline void setTextSize(std::uint8_t size) {
+        _textSize = size > 0 ? size : 1;
+    }
+
+    inline void setCursor(std::int16_t x, std::int16_t y) {
+        _cursorX = x;
+        _cursorY = y;
+    }
+
+    //! 文字を1つ書き、カーソルを進める
+    void write(char c);
+
+    void print(const char* text);
+    void print(std::int32_t number);
+
+    /*!
+        @brief  PBM（P4、バイナリ）形式に変換する
+        @return PBMファイルの内容
+    */
+    std::string toPBM() const;
+
+    /*!
+        @brief  PBM（P4）形式の画像を読み込む
+        @param[in]  data    PBMファイルの内容
+        @return     画像のサイズがこのバッファと一致すれば true
+    */
+    bool fromPBM(const std::string& data);
+
+private:
+    std::uint8_t _width;
+    std::uint8_t _height;
+
+    //! ページ単位のバッファ（buffer[x + (y/8)*width] の bit (y%8)）
+    std::vector<std::uint8_t> _buffer;
+
+    std::uint16_t _textColor = 1;
+    std::uint8_t _textSize = 1;
+    std::int16_t _cursorX = 0;
+    std::int16_t _cursorY = 0;
+
+    std::uint32_t _displayCount = 0;
+
+    void _drawChar(std::int16_t x, std::int16_t y, char c);
+};
+
+//-----------------------------------------------------------------------------
+} // namespace shark
+#endif
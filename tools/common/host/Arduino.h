@@ -0,0 +1,118 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    ホスト（PC）でファームウェアのソースをビルドするための Arduino.h の代わり
+
+    画面表示などのコードが使う最小限（PROGMEM・F()・Serial と FreeRTOS のバイナリセマフォ）
+    だけを用意する。ツールのビルドで -Itools/common/host を指定して使う。
+*/
+#ifndef ATLAS_TOOLS_HOST_ARDUINO_H
+#define ATLAS_TOOLS_HOST_ARDUINO_H
+
+// C++標準ライブラリ
+#include <condition_variable>   // std::condition_variable
+#include <cstdarg>              // va_list
+#include <cstddef>              // std::size_t
+#include <cstdint>              // std::uint8_t
+#include <cstdio>               // std::vprintf, std::fwrite
+#include <mutex>                // std::mutex
+#include <thread>               // std::thread::id
+
+// フラッシュ配置の指定（ホストでは通常のメモリ）
+#define  PROGMEM
+#define  pgm_read_byte(addr)  (*reinterpret_cast<const std::uint8_t*>(addr))
+#define  F(str)               (str)
+
+//-----------------------------------------------------------------------------
+// シリアル（標準出力に書く）
+//-----------------------------------------------------------------------------
+
+struct HostSerial
+{
+    inline void begin(unsigned long /*baud*/) {}
+
+    inline void println(const char* str) {
+        std::printf("%s\n", str);
+    }
+
+    inline int printf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        const int n = std::vprintf(format, args);
+        va_end(args);
+        return n;
+    }
+
+    inline std::size_t write(const std::uint8_t* data, std::size_t size) {
+        return std::fwrite(data, 1, size, stdout);
+    }
+};
+
+inline HostSerial Serial;
+
+//-----------------------------------------------------------------------------
+// FreeRTOS のバイナリセマフォ
+//-----------------------------------------------------------------------------
+
+typedef std::uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define  pdTRUE          1
+#define  pdFALSE         0
+#define  portMAX_DELAY   0xFFFFFFFFu
+
+struct HostSemaphore
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool available = false;
+    std::thread::id owner;  // 取得したスレッド
+};
+
+/*
+    実行中のスレッドが取得しているセマフォの数
+
+    OSのシミュレーター（os_sim.cc）は、これが0でないタスクを切り替えない
+    （取得したままのタスクを止めると、他のタスクがセマフォを待ったまま進まなくなる）。
+*/
+inline thread_local int hostSemaphoresHeld = 0;
+
+typedef HostSemaphore* SemaphoreHandle_t;
+
+//! セマフォを作る（取得済みの状態。ホストのツールは終了まで使うので開放しない）
+inline SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+    return new HostSemaphore;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t smp)
+{
+    {
+        std::lock_guard<std::mutex> lock(smp->mutex);
+        if (smp->available) {
+            return pdFALSE;
+        }
+        smp->available = true;
+        if (smp->owner == std::this_thread::get_id()) {
+            smp->owner = std::thread::id();
+            hostSemaphoresHeld -= 1;
+        }
+    }
+    smp->cv.notify_one();
+    return pdTRUE;
+}
+
+//! セマフォを取得する（ホストではタイムアウトせずに待つ）
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t smp, TickType_t /*ticks*/)
+{
+    std::unique_lock<std::mutex> lock(smp->mutex);
+    smp->cv.wait(lock, [smp] { return smp->available; });
+    smp->available = false;
+    smp->owner = std::this_thread::get_id();
+    hostSemaphoresHeld += 1;
+    return pdTRUE;
+}
+
+#endif  // #ifndef ATLAS_TOOLS_HOST_ARDUINO_H
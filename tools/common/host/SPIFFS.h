@@ -0,0 +1,49 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    ホスト（PC）でファームウェアのソースをビルドするための SPIFFS.h の代わり
+
+    ファイルは開けない（open は常に失敗する）。保存・読み込みを
+    試みるだけのコードをビルドするためのもの。
+*/
+#ifndef ATLAS_TOOLS_HOST_SPIFFS_H
+#define ATLAS_TOOLS_HOST_SPIFFS_H
+
+// C++標準ライブラリ
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint8_t
+
+class File
+{
+public:
+    inline explicit operator bool() const noexcept {
+        return false;
+    }
+
+    inline std::size_t write(const std::uint8_t* /*data*/, std::size_t /*size*/) {
+        return 0;
+    }
+
+    inline std::size_t read(std::uint8_t* /*data*/, std::size_t /*size*/) {
+        return 0;
+    }
+
+    inline void close() {}
+};
+
+struct HostSPIFFS
+{
+    inline File open(const char* /*path*/, const char* /*mode*/ = "r") {
+        return File();
+    }
+
+    inline bool exists(const char* /*path*/) {
+        return false;
+    }
+};
+
+inline HostSPIFFS SPIFFS;
+
+#endif  // #ifndef ATLAS_TOOLS_HOST_SPIFFS_H
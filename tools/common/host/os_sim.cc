@@ -0,0 +1,817 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    OSの抽象化層（os.hh / gpio.hh）のホスト（PC）の実装
+
+    実機の os.cc / gpio.cc の代わりにリンクする。動作の約束事は sim.hh を参照。
+*/
+#include "os.hh"
+#include "gpio.hh"
+#include "sim.hh"
+
+// C++標準ライブラリ
+#include <algorithm>            // std::max, std::min
+#include <condition_variable>   // std::condition_variable
+#include <cstdint>              // INT64_MAX
+#include <cstdio>               // std::fprintf, std::fflush
+#include <cstdlib>              // std::_Exit
+#include <cstring>              // std::memcpy
+#include <deque>                // std::deque
+#include <mutex>                // std::mutex, std::unique_lock
+#include <random>               // std::mt19937, std::exponential_distribution
+#include <thread>               // std::thread
+#include <vector>               // std::vector
+
+// Arduino（ホストの代替）
+#include <Arduino.h>            // hostSemaphoresHeld
+
+namespace shark::os {
+//-----------------------------------------------------------------------------
+
+namespace detail {
+
+struct HostTask
+{
+    enum class State : std::uint8_t
+    {
+        READY,      // 実行可能
+        RUNNING,    // 実行中
+        BLOCKED,    // 待ち
+    };
+
+    const char* name;
+    std::uint8_t priority;
+    TaskFunction func;
+    void* arg;
+    State state = State::READY;
+    std::uint64_t order = 0;            // 実行可能になった順番（同じ優先度の順）
+    std::int64_t wakeAt = INT64_MAX;    // 待ちの期限 [us]
+    const void* waitingOn = nullptr;    // 待っている対象（キュー・通知・タイマー）
+    bool notified = false;              // 通知
+    bool spawned = false;               // spawn() で開始した（関数から戻ってよい）
+};
+
+struct HostQueue
+{
+    std::uint32_t length;
+    std::uint32_t itemSize;
+    std::deque<std::vector<std::uint8_t>> items;
+};
+
+struct HostTimer
+{
+    const char* name;
+    TimerCallback callback;
+    void* arg;
+    bool active = false;
+    std::int64_t nominal = 0;   // 発火時刻 [us]
+    std::int64_t fireAt = 0;    // コールバックを呼ぶ時刻（発火時刻 + 遅れ） [us]
+    std::uint64_t period = 0;   // 周期 [us]（0なら1度だけ）
+    std::uint64_t seq = 0;      // 同じ時刻に発火するタイマーの順番
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::HostTask;
+using detail::HostQueue;
+using detail::HostTimer;
+using State = HostTask::State;
+using KernelLock = std::unique_lock<std::mutex>;
+
+// 期限なし
+constexpr std::int64_t NEVER = INT64_MAX;
+
+struct Kernel
+{
+    std::mutex mutex;
+    std::condition_variable baton;  // 実行中のタスクが変わったことを知らせる
+    std::vector<HostTask*> tasks;
+    std::vector<HostTimer*> timers;
+    HostTask* running = nullptr;
+    HostTask* timerTask = nullptr;
+    std::int64_t now = 0;           // 仮想時刻 [us]
+    std::uint64_t order = 0;
+    std::uint64_t timerSeq = 0;
+    std::uint64_t switches = 0;
+    std::uint64_t preemptions = 0;
+    sim::Config config;
+    std::mt19937 rng;
+    bool started = false;
+};
+
+// 終了まで使う（他のタスクのスレッドが待ったまま終了するので、破棄しない）
+Kernel& kernel()
+{
+    static Kernel* k = new Kernel;
+    return *k;
+}
+
+thread_local HostTask* tSelf = nullptr;
+
+const char* stateName(const HostTask& task)
+{
+    switch (task.state) {
+    case State::READY:   return "ready";
+    case State::RUNNING: return "running";
+    case State::BLOCKED: return "blocked";
+    }
+    return "?";
+}
+
+// 各タスクの状態を出力して終了する（カーネルのロック中に呼ぶ）
+[[noreturn]] void fail(const char* what)
+{
+    auto& k = kernel();
+    std::fflush(stdout);
+    std::fprintf(stderr, "os_sim: %s (t = %lld us)\n", what, static_cast<long long>(k.now));
+    for (const HostTask* task : k.tasks) {
+        const char* on = "-";
+        if (task->state == State::BLOCKED) {
+            on = task->waitingOn == task ? "notify"
+               : task->waitingOn == &k.timers ? "timer"
+               : task->waitingOn ? "queue"
+               : "delay";
+        }
+        std::fprintf(stderr, "  %-16s prio %2u  %-8s %-7s wake %s%lld\n",
+                     task->name, task->priority, stateName(*task), on,
+                     task->wakeAt == NEVER ? "never " : "",
+                     task->wakeAt == NEVER ? 0LL : static_cast<long long>(task->wakeAt));
+    }
+    std::fflush(stderr);
+    std::_Exit(1);
+}
+
+// 平均 mean の指数分布の時間 [us]
+std::int64_t randomDelay(std::uint32_t mean)
+{
+    if (mean == 0) {
+        return 0;
+    }
+    std::exponential_distribution<double> dist(1.0 / mean);
+    return static_cast<std::int64_t>(dist(kernel().rng));
+}
+
+HostTask& self()
+{
+    if (!tSelf) {
+        fail("OS function called from a thread that is not a task");
+    }
+    return *tSelf;
+}
+
+void makeReady(HostTask& task)
+{
+    task.state = State::READY;
+    task.wakeAt = NEVER;
+    task.waitingOn = nullptr;
+    task.order = ++kernel().order;
+}
+
+// 期限の来たタスクを実行可能にする
+void wakeExpired()
+{
+    auto& k = kernel();
+    for (HostTask* task : k.tasks) {
+        if (task->state == State::BLOCKED && task->wakeAt <= k.now) {
+            makeReady(*task);
+        }
+    }
+}
+
+// 対象を待っているタスクを実行可能にする（条件は待っていた側で確かめ直す）
+void wakeWaiting(const void* object)
+{
+    for (HostTask* task : kernel().tasks) {
+        if (task->state == State::BLOCKED && task->waitingOn == object) {
+            makeReady(*task);
+        }
+    }
+}
+
+HostTask* highestReady()
+{
+    HostTask* best = nullptr;
+    for (HostTask* task : kernel().tasks) {
+        if (task->state == State::READY &&
+            (!best || task->priority > best->priority ||
+             (task->priority == best->priority && task->order < best->order))
+        ) {
+            best = task;
+        }
+    }
+    return best;
+}
+
+// 次に実行するタスク（実行可能なタスクがなければ、次の期限まで時刻を進める）
+HostTask* nextTask()
+{
+    auto& k = kernel();
+    HostTask* next = highestReady();
+    while (!next) {
+        // 実行可能なタスクがなければ、次の期限まで時刻を進める
+        std::int64_t wake = NEVER;
+        for (const HostTask* task : k.tasks) {
+            if (task->state == State::BLOCKED) {
+                wake = std::min(wake, task->wakeAt);
+            }
+        }
+        if (wake == NEVER) {
+            fail("deadlock: every task waits forever");
+        }
+        k.now = std::max(k.now, wake);
+        wakeExpired();
+        next = highestReady();
+    }
+    return next;
+}
+
+// 実行権を渡し、自分が選ばれるまで待つ（me は READY か BLOCKED にしておく）
+void dispatch(KernelLock& lock, HostTask& me)
+{
+    auto& k = kernel();
+    HostTask* next = nextTask();
+    if (next != &me) {
+        k.switches += 1;
+    }
+    next->state = State::RUNNING;
+    k.running = next;
+    k.baton.notify_all();
+    k.baton.wait(lock, [&k, &me] { return k.running == &me; });
+}
+
+// 優先度の高いタスクが実行可能なら切り替える
+void preemptIfNeeded(KernelLock& lock, HostTask& me)
+{
+    if (hostSemaphoresHeld > 0) {
+        return;
+    }
+    const HostTask* next = highestReady();
+    if (next && next->priority > me.priority) {
+        kernel().preemptions += 1;
+        me.state = State::READY;
+        me.order = ++kernel().order;
+        dispatch(lock, me);
+    }
+}
+
+// OSの関数の入口（処理時間だけ時刻を進め、期限の来た優先度の高いタスクに切り替える）
+HostTask& enter(KernelLock& lock)
+{
+    auto& k = kernel();
+    HostTask& me = self();
+    k.now += randomDelay(k.config.callCost);
+    wakeExpired();
+    preemptIfNeeded(lock, me);
+    return me;
+}
+
+// 待ちに入る
+void block(KernelLock& lock, HostTask& me, std::int64_t wakeAt, const void* waitingOn)
+{
+    if (hostSemaphoresHeld > 0) {
+        fail("blocking call while holding a semaphore");
+    }
+    me.state = State::BLOCKED;
+    me.wakeAt = wakeAt;
+    me.waitingOn = waitingOn;
+    dispatch(lock, me);
+}
+
+// ms [ms] 後のティックの時刻 [us]
+std::int64_t tickAfter(std::uint32_t ms)
+{
+    return (kernel().now / 1000 + ms) * 1000;
+}
+
+// 待ち時間 [ms] の期限 [us]
+std::int64_t timeoutAt(std::uint32_t ms)
+{
+    return ms == FOREVER ? NEVER : tickAfter(ms);
+}
+
+// タスクのスレッド（選ばれるまで待ってから関数を実行する）
+void runTask(HostTask* task)
+{
+    auto& k = kernel();
+    {
+        KernelLock lock(k.mutex);
+        k.baton.wait(lock, [&k, task] { return k.running == task; });
+        tSelf = task;
+    }
+    task->func(task->arg);
+
+    KernelLock lock(k.mutex);
+    if (!task->spawned) {
+        fail("task function returned");
+    }
+
+    // 使い捨てのタスクは、一覧から外して実行権を渡す（スレッドはそのまま終わる）
+    k.tasks.erase(std::find(k.tasks.begin(), k.tasks.end(), task));
+    HostTask* next = nextTask();
+    k.switches += 1;
+    next->state = State::RUNNING;
+    k.running = next;
+    k.baton.notify_all();
+    tSelf = nullptr;
+    delete task;
+}
+
+HostTask* createTask(TaskFunction func, const char* name, void* arg, std::uint8_t priority,
+                     bool spawned = false)
+{
+    auto* task = new HostTask {name, priority, func, arg};
+    task->spawned = spawned;
+    makeReady(*task);
+    kernel().tasks.push_back(task);
+    std::thread(runTask, task).detach();
+    return task;
+}
+
+// 発火待ちのタイマータスクの期限を早める
+void retimeTimerTask(std::int64_t fireAt)
+{
+    HostTask* task = kernel().timerTask;
+    if (task->state == State::BLOCKED) {
+        task->wakeAt = std::min(task->wakeAt, fireAt);
+    }
+}
+
+void armTimer(HostTimer& timer, std::uint64_t timeout, std::uint64_t period)
+{
+    auto& k = kernel();
+    timer.active = true;
+    timer.period = period;
+    timer.nominal = k.now + static_cast<std::int64_t>(timeout);
+    timer.fireAt = timer.nominal + randomDelay(k.config.timerLatency);
+    timer.seq = ++k.timerSeq;
+    retimeTimerTask(timer.fireAt);
+}
+
+// タイマータスク（発火時刻の早い順にコールバックを呼ぶ）
+void taskTimer(void*)
+{
+    auto& k = kernel();
+    KernelLock lock(k.mutex);
+    HostTask& me = self();
+    while (true) {
+        HostTimer* next = nullptr;
+        for (HostTimer* timer : k.timers) {
+            if (timer->active &&
+                (!next || timer->fireAt < next->fireAt ||
+                 (timer->fireAt == next->fireAt && timer->seq < next->seq))
+            ) {
+                next = timer;
+            }
+        }
+        if (!next || next->fireAt > k.now) {
+            block(lock, me, next ? next->fireAt : NEVER, &k.timers);
+            continue;
+        }
+
+        if (next->period) {
+            next->nominal += static_cast<std::int64_t>(next->period);
+            next->fireAt = next->nominal + randomDelay(k.config.timerLatency);
+        }
+        else {
+            next->active = false;
+        }
+
+        // コールバックはOSの関数を呼ぶので、ロックの外で呼ぶ
+        const TimerCallback callback = next->callback;
+        void* arg = next->arg;
+        lock.unlock();
+        callback(arg);
+        lock.lock();
+    }
+}
+
+} // namespace
+
+//=============================================================================
+// シミュレーションの操作
+//=============================================================================
+
+void sim::begin(std::uint8_t priority, const Config& config)
+{
+    auto& k = kernel();
+    KernelLock lock(k.mutex);
+    if (k.started) {
+        fail("sim::begin called twice");
+    }
+    k.started = true;
+    k.config = config;
+    k.rng.seed(config.seed);
+
+    auto* main = new HostTask {"main", priority, nullptr, nullptr};
+    main->state = State::RUNNING;
+    k.tasks.push_back(main);
+    k.running = main;
+    tSelf = main;
+
+    k.timerTask = createTask(taskTimer, "timer", nullptr, TIMER_TASK_PRIORITY);
+}
+
+std::uint64_t sim::switches()
+{
+    auto& k = kernel();
+    KernelLock lock(k.mutex);
+    return k.switches;
+}
+
+std::uint64_t sim::preemptions()
+{
+    auto& k = kernel();
+    KernelLock lock(k.mutex);
+    return k.preemptions;
+}
+
+void sim::exit(int code)
+{
+    std::fflush(stdout);
+    std::fflush(stderr);
+    std::_Exit(code);
+}
+
+//=============================================================================
+// 時刻・待機
+//=============================================================================
+
+std::int64_t now()
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    return kernel().now;
+}
+
+std::uint32_t millis()
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    return static_cast<std::uint32_t>(kernel().now / 1000);
+}
+
+void delay(std::uint32_t ms)
+{
+    if (ms == 0) {
+        yield();
+        return;
+    }
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    block(lock, me, tickAfter(ms), nullptr);
+}
+
+void delayUntil(std::uint32_t& lastWake, std::uint32_t period)
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    const std::uint32_t wake = lastWake + period;
+    const auto remaining = static_cast<std::int32_t>(
+        wake - static_cast<std::uint32_t>(kernel().now / 1000)
+    );
+    // 起床時刻を過ぎていれば待たない（FreeRTOSと同じく、周期は前回の起床時刻から数える）
+    if (remaining > 0) {
+        block(lock, me, tickAfter(static_cast<std::uint32_t>(remaining)), nullptr);
+    }
+    lastWake = wake;
+}
+
+void yield()
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    const HostTask* next = highestReady();
+    if (next && next->priority >= me.priority) {
+        me.state = State::READY;
+        me.order = ++kernel().order;
+        dispatch(lock, me);
+    }
+}
+
+bool takeNotify(std::uint32_t timeout)
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    const std::int64_t deadline = timeoutAt(timeout);
+    while (!me.notified) {
+        if (timeout == 0 || kernel().now >= deadline) {
+            return false;
+        }
+        block(lock, me, deadline, &me);
+    }
+    me.notified = false;
+    return true;
+}
+
+//=============================================================================
+// タスク
+//=============================================================================
+
+bool Task::start(
+    TaskFunction func,
+    const char* name,
+    void* arg,
+    std::uint8_t priority,
+    std::uint8_t* /*stack*/,
+    std::uint32_t /*stackSize*/
+) {
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    _control.handle = createTask(func, name, arg, priority);
+
+    // 優先度の高いタスクを作ったら、すぐに切り替わる
+    preemptIfNeeded(lock, me);
+    return true;
+}
+
+void Task::notify()
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    HostTask* task = _control.handle;
+    if (!task) {
+        return;
+    }
+    task->notified = true;
+    if (task->state == State::BLOCKED && task->waitingOn == task) {
+        makeReady(*task);
+    }
+    preemptIfNeeded(lock, me);
+}
+
+bool spawn(
+    TaskFunction func,
+    const char* name,
+    void* arg,
+    std::uint8_t priority,
+    std::uint32_t /*stackSize*/
+) {
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    createTask(func, name, arg, priority, true);
+
+    // 優先度の高いタスクを作ったら、すぐに切り替わる
+    preemptIfNeeded(lock, me);
+    return true;
+}
+
+//=============================================================================
+// キュー
+//=============================================================================
+
+bool Queue::begin(std::uint32_t length, std::uint32_t itemSize, std::uint8_t* /*storage*/)
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    _control.handle = new HostQueue {length, itemSize, {}};
+    return true;
+}
+
+bool Queue::send(const void* item, std::uint32_t timeout)
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    HostQueue* queue = _control.handle;
+    if (!queue) {
+        return false;
+    }
+
+    const std::int64_t deadline = timeoutAt(timeout);
+    while (queue->items.size() >= queue->length) {
+        if (timeout == 0 || kernel().now >= deadline) {
+            return false;
+        }
+        block(lock, me, deadline, queue);
+    }
+
+    const auto* bytes = static_cast<const std::uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    wakeWaiting(queue);
+    preemptIfNeeded(lock, me);
+    return true;
+}
+
+bool Queue::receive(void* item, std::uint32_t timeout)
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    HostQueue* queue = _control.handle;
+    if (!queue) {
+        return false;
+    }
+
+    const std::int64_t deadline = timeoutAt(timeout);
+    while (queue->items.empty()) {
+        if (timeout == 0 || kernel().now >= deadline) {
+            return false;
+        }
+        block(lock, me, deadline, queue);
+    }
+
+    std::memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    wakeWaiting(queue);
+    preemptIfNeeded(lock, me);
+    return true;
+}
+
+std::uint32_t Queue::count() const
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    return _control.handle ? static_cast<std::uint32_t>(_control.handle->items.size()) : 0;
+}
+
+void Queue::reset()
+{
+    KernelLock lock(kernel().mutex);
+    HostTask& me = enter(lock);
+    if (HostQueue* queue = _control.handle) {
+        queue->items.clear();
+        wakeWaiting(queue);
+        preemptIfNeeded(lock, me);
+    }
+}
+
+//=============================================================================
+// タイマー
+//=============================================================================
+
+bool Timer::begin(const char* name, TimerCallback callback, void* arg)
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    if (!_control.handle) {
+        _control.handle = new HostTimer {name, callback, arg};
+        kernel().timers.push_back(_control.handle);
+    }
+    return true;
+}
+
+bool Timer::startOnce(std::uint64_t timeout)
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    HostTimer* timer = _control.handle;
+    if (!timer || timer->active) {
+        return false;
+    }
+    armTimer(*timer, timeout, 0);
+    return true;
+}
+
+bool Timer::startPeriodic(std::uint64_t period)
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    HostTimer* timer = _control.handle;
+    if (!timer || timer->active || period == 0) {
+        return false;
+    }
+    armTimer(*timer, period, period);
+    return true;
+}
+
+void Timer::stop()
+{
+    KernelLock lock(kernel().mutex);
+    enter(lock);
+    if (HostTimer* timer = _control.handle) {
+        timer->active = false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark::os
+
+namespace shark::gpio {
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// 扱うピンの数
+constexpr std::uint8_t NUM_PINS = 64;
+
+struct Pin
+{
+    PinMode mode = PinMode::IN;
+    bool level = false;
+    std::uint8_t duty = 0;
+    Isr isr = nullptr;
+    void* arg = nullptr;
+};
+
+Pin gPins[NUM_PINS];
+sim::PwmObserver gObserver = nullptr;
+void* gObserverArg = nullptr;
+
+Pin& pinAt(std::uint8_t pin)
+{
+    if (pin >= NUM_PINS) {
+        os::fail("GPIO pin number out of range");
+    }
+    return gPins[pin];
+}
+
+} // namespace
+
+void mode(std::uint8_t pin, PinMode mode)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    Pin& p = pinAt(pin);
+    p.mode = mode;
+    if (mode == PinMode::IN_PULLUP) {
+        p.level = true;
+    }
+}
+
+bool read(std::uint8_t pin)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    return pinAt(pin).level;
+}
+
+void write(std::uint8_t pin, bool level)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    pinAt(pin).level = level;
+}
+
+void pwm(std::uint8_t pin, std::uint8_t duty)
+{
+    sim::PwmObserver observer;
+    void* arg;
+    std::int64_t time;
+    {
+        os::KernelLock lock(os::kernel().mutex);
+        pinAt(pin).duty = duty;
+        observer = gObserver;
+        arg = gObserverArg;
+        time = os::kernel().now;
+    }
+    if (observer) {
+        observer(pin, duty, time, arg);
+    }
+}
+
+void attachChange(std::uint8_t pin, Isr isr, void* arg)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    Pin& p = pinAt(pin);
+    p.isr = isr;
+    p.arg = arg;
+}
+
+//=============================================================================
+// シミュレーションの操作
+//=============================================================================
+
+void sim::setPwmObserver(PwmObserver observer, void* arg)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    gObserver = observer;
+    gObserverArg = arg;
+}
+
+std::uint8_t sim::duty(std::uint8_t pin)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    return pinAt(pin).duty;
+}
+
+bool sim::level(std::uint8_t pin)
+{
+    os::KernelLock lock(os::kernel().mutex);
+    return pinAt(pin).level;
+}
+
+void sim::setInput(std::uint8_t pin, bool level)
+{
+    Isr isr = nullptr;
+    void* arg = nullptr;
+    {
+        os::KernelLock lock(os::kernel().mutex);
+        os::enter(lock);
+        Pin& p = pinAt(pin);
+        if (p.level == level) {
+            return;
+        }
+        p.level = level;
+        isr = p.isr;
+        arg = p.arg;
+    }
+
+    // 割り込み（呼び出し元のタスクで呼び、終わったら優先度の高いタスクに切り替える）
+    if (isr) {
+        isr(arg);
+        os::KernelLock lock(os::kernel().mutex);
+        os::preemptIfNeeded(lock, os::self());
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace shark::gpio
@@ -0,0 +1,88 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    OSの抽象化層（os.hh / gpio.hh）のホスト実装（os_sim.cc）の操作
+
+    タスクは std::thread で動かすが、同時に動くのは常に1つだけで、
+    FreeRTOSと同じく「実行可能な中で最も優先度の高いタスク（同じ優先度なら先着順）」を選ぶ。
+    時刻は仮想時刻で、全タスクが待ちに入ると次の起床時刻まで一気に進む
+    （実時間を待たないので、何秒もかかる射出を1回数ミリ秒で再現できる）。
+
+    - OSの関数を呼ぶたびに、その処理時間として仮想時刻を進める（Config::callCost）。
+      そのときに優先度の高いタスクの起床時刻が来ていれば、呼び出し元から切り替える
+      （セマフォを取得しているタスクは切り替えない）
+    - タイマーのコールバックは最も優先度の高いタイマータスクから呼ぶ。
+      発火時刻からコールバックまでの遅れは Config::timerLatency
+    - 処理時間と遅れは指数分布の乱数で、同じ seed なら同じ結果になる
+    - 全タスクが無期限の待ちに入ったら、デッドロックとして各タスクの状態を出力して終了する
+    - spawn() で開始したタスクは、関数から戻ると一覧から外れる（それ以外のタスクが
+      戻ったらエラーとして終了する）
+*/
+#ifndef ATLAS_TOOLS_HOST_SIM_HH
+#define ATLAS_TOOLS_HOST_SIM_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t, std::uint32_t, std::int64_t, std::uint64_t
+
+namespace shark::os::sim {
+//-----------------------------------------------------------------------------
+
+//! シミュレーションの設定
+struct Config
+{
+    std::uint32_t seed = 1;             //!< 乱数の種
+    std::uint32_t callCost = 0;         //!< OSの関数1回の平均処理時間 [us]（0なら時間を進めない）
+    std::uint32_t timerLatency = 0;     //!< タイマーの発火からコールバックまでの平均の遅れ [us]
+};
+
+//! タイマータスクの優先度（ESPタイマーのタスクと同じく最も高い）
+constexpr std::uint8_t TIMER_TASK_PRIORITY = 22;
+
+/*!
+    @brief  シミュレーションを開始する（main から1度だけ呼ぶ）
+    @param[in]  priority  呼び出し元のスレッドを、この優先度のタスクとして扱う
+    @param[in]  config    設定
+*/
+void begin(std::uint8_t priority, const Config& config);
+
+//! タスクを切り替えた回数
+std::uint64_t switches();
+
+//! OSの関数の途中でタスクを切り替えた（横取りした）回数
+std::uint64_t preemptions();
+
+//! 出力を書き出して終了する（他のタスクのスレッドは止めたまま捨てる）
+[[noreturn]] void exit(int code);
+
+//-----------------------------------------------------------------------------
+} // namespace shark::os::sim
+
+namespace shark::gpio::sim {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  PWM出力の監視
+    @param[in]  pin   ピン番号
+    @param[in]  duty  デューティ比
+    @param[in]  time  出力した時刻（仮想時刻） [us]
+    @param[in]  arg   setPwmObserver() に渡した引数
+*/
+using PwmObserver = void (*)(std::uint8_t pin, std::uint8_t duty, std::int64_t time, void* arg);
+
+//! PWM出力の監視を設定する（出力したタスクから、ロックの外で呼ばれる）
+void setPwmObserver(PwmObserver observer, void* arg);
+
+//! 現在のデューティ比
+std::uint8_t duty(std::uint8_t pin);
+
+//! 現在の出力（HIGHなら true）
+bool level(std::uint8_t pin);
+
+//! 入力を変化させる（変化したら、割り込みを呼び出し元のタスクで呼ぶ）
+void setInput(std::uint8_t pin, bool level);
+
+//-----------------------------------------------------------------------------
+} // namespace shark::gpio::sim
+#endif
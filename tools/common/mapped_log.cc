@@ -0,0 +1,66 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "mapped_log.hh"
+
+// POSIX
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap, madvise
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+MappedLog::~MappedLog()
+{
+    this->close();
+}
+
+bool MappedLog::open(const std::string& path, std::string& error)
+{
+    this->close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        error = "cannot stat " + path;
+        ::close(fd);
+        return false;
+    }
+
+    // 空ファイルはマップしない
+    if (st.st_size > 0) {
+        void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            error = "cannot map " + path;
+            ::close(fd);
+            return false;
+        }
+        ::madvise(p, st.st_size, MADV_SEQUENTIAL);
+        _data = static_cast<const unsigned char*>(p);
+        _size = static_cast<std::size_t>(st.st_size);
+    }
+
+    // マップ後はファイル記述子は不要
+    ::close(fd);
+    return true;
+}
+
+void MappedLog::close()
+{
+    if (_data) {
+        ::munmap(const_cast<unsigned char*>(_data), _size);
+    }
+    _data = nullptr;
+    _size = 0;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
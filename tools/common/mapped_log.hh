@@ -0,0 +1,64 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_MAPPED_LOG_HH
+#define ATLAS_TOOLS_MAPPED_LOG_HH
+
+// C++標準ライブラリ
+#include <cstddef>  // std::size_t
+#include <cstring>  // std::memcpy
+#include <string>   // std::string
+
+// ATLAS
+#include "raw_log.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  生データファイルをメモリマップして読み出すクラス
+
+    ファイル上のレコードはホストと同じリトルエンディアンの uint16 列なので、
+    デコードはレコード単位の memcpy だけで済む（コンパイラがベクトル命令に展開する）。
+*/
+class MappedLog
+{
+public:
+    MappedLog() = default;
+    ~MappedLog();
+
+    MappedLog(const MappedLog&) = delete;
+    MappedLog& operator=(const MappedLog&) = delete;
+
+    /*!
+        @brief  ファイルを開いてメモリマップする
+        @param[in]   path   ファイルパス
+        @param[out]  error  失敗時のエラーメッセージ
+        @return  成否
+    */
+    bool open(const std::string& path, std::string& error);
+
+    //! マップを解除する
+    void close();
+
+    //! レコード数を返す。末尾の不完全なレコードは含まない
+    inline std::size_t size() const noexcept {
+        return _size / sizeof(RawRecord);
+    }
+
+    //! 指定番号のレコードを返す
+    inline RawRecord at(std::size_t index) const noexcept {
+        RawRecord record;
+        std::memcpy(&record, _data + index * sizeof(RawRecord), sizeof(RawRecord));
+        return record;
+    }
+
+private:
+    const unsigned char* _data = nullptr;   //!< マップ先頭
+    std::size_t _size = 0;                  //!< ファイルサイズ
+};
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
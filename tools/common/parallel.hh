@@ -0,0 +1,63 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_PARALLEL_HH
+#define ATLAS_TOOLS_PARALLEL_HH
+
+// C++標準ライブラリ
+#include <algorithm>    // std::min, std::max
+#include <atomic>       // std::atomic_size_t
+#include <thread>       // std::thread
+#include <vector>       // std::vector
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 既定の並列数（CPUコア数）を返す
+inline unsigned defaultConcurrency()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/*!
+    @brief  0からn-1までの各インデックスに対して関数を並列に実行する
+
+    各ワーカーは共有カウンタから次の未処理インデックスを1つずつ取り出すため、
+    処理時間にばらつきのあるジョブ（ファイルサイズの違いなど）でも
+    空いたワーカーが残りのジョブを引き取って負荷が均される。
+
+    @param[in]  n        ジョブ数
+    @param[in]  threads  ワーカー数
+    @param[in]  fn       void(std::size_t index) の関数オブジェクト
+
+    @return  実際に使用したワーカー数
+*/
+template <typename F>
+unsigned parallelFor(std::size_t n, unsigned threads, F&& fn)
+{
+    const unsigned numWorkers = static_cast<unsigned>(
+        std::min<std::size_t>(std::max(1u, threads), std::max<std::size_t>(n, 1))
+    );
+
+    std::atomic_size_t next{0};
+    auto worker = [&] {
+        for (auto i = next++; i < n; i = next++) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 1; w < numWorkers; ++w) {
+        workers.emplace_back(worker);
+    }
+    worker();   // 呼び出しスレッドもワーカーとして働く
+    for (auto& t : workers) {
+        t.join();
+    }
+    return numWorkers;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
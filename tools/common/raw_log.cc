@@ -0,0 +1,40 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "raw_log.hh"
+
+// C++標準ライブラリ
+#include <fstream>  // std::ifstream
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+bool loadRawLog(
+    const std::string& path,
+    std::vector<RawRecord>& records,
+    std::string& error
+) {
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    // レコード数の計算
+    const auto size = static_cast<std::size_t>(ifs.tellg());
+    records.resize(size / sizeof(RawRecord));
+    ifs.seekg(0);
+
+    // 一括読み込み
+    if (!ifs.read(reinterpret_cast<char*>(records.data()),
+                  records.size() * sizeof(RawRecord))) {
+        error = "failed to read " + path;
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -0,0 +1,40 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_RAW_LOG_HH
+#define ATLAS_TOOLS_RAW_LOG_HH
+
+// C++標準ライブラリ
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+// ATLAS
+#include "raw_record.hh"
+
+// 生データファイルはリトルエンディアンのuint16をそのまま並べた形式
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "ATLAS host tools require a little-endian host"
+#endif
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+/*!
+    @brief  生データファイル（/raw.dat）を読み込む
+
+    @param[in]   path     ファイルパス
+    @param[out]  records  読み込んだレコード
+    @param[out]  error    失敗時のエラーメッセージ
+
+    @return  読み込みの成否。末尾の不完全なレコードは読み捨てる
+*/
+bool loadRawLog(
+    const std::string& path,
+    std::vector<RawRecord>& records,
+    std::string& error
+);
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -0,0 +1,56 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#include "shot_analytics.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+std::vector<LogSegment> splitSessions(const MappedLog& log)
+{
+    std::vector<LogSegment> segments;
+    const std::size_t n = log.size();
+
+    std::size_t first = 0;
+    std::uint16_t prevTotal = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto total = log.at(i).total;
+        if (i > first && total <= prevTotal) {
+            segments.push_back({first, i - first});
+            first = i;
+        }
+        prevTotal = total;
+    }
+    if (first < n) {
+        segments.push_back({first, n - first});
+    }
+    return segments;
+}
+
+Result summarize(
+    const MappedLog& log,
+    const LogSegment& segment,
+    EvalSource source
+) {
+    Result result;
+    result.initialize();
+
+    const std::size_t last = segment.first + segment.count;
+    for (std::size_t i = segment.first; i < last; ++i) {
+        const auto rec = log.at(i);
+        if (source == EvalSource::RECOMPUTED) {
+            std::uint16_t acc1 = 0, acc2 = 0;
+            result.update(rec.origSP, rec.profile, acc1, acc2);
+        }
+        else {
+            // onBeyLaunched と同じ順序で統計を更新する
+            result.statsOrig.update(rec.origSP);
+            result.statsEval.update(rec.evalSP);
+        }
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
@@ -0,0 +1,55 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+#ifndef ATLAS_TOOLS_SHOT_ANALYTICS_HH
+#define ATLAS_TOOLS_SHOT_ANALYTICS_HH
+
+// C++標準ライブラリ
+#include <cstddef>  // std::size_t
+#include <vector>   // std::vector
+
+// ATLAS
+#include "result.hh"
+#include "mapped_log.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 生データファイル上のレコード区間
+struct LogSegment
+{
+    std::size_t first;  //!< 先頭レコード番号
+    std::size_t count;  //!< レコード数
+};
+
+//! evalSPの取得方法
+enum class EvalSource
+{
+    RECORDED,   //!< 生データに記録されたevalSPを使う（実機の result.dat と一致）
+    RECOMPUTED  //!< プロファイルを Result::update で再解析する
+};
+
+/*!
+    @brief  生データをセッションごとに分割する
+
+    累計シュート数は統計データの初期化で0に戻るため、
+    累計シュート数が直前のレコード以下になった位置をセッションの境界とする。
+*/
+std::vector<LogSegment> splitSessions(const MappedLog& log);
+
+/*!
+    @brief  区間内のレコードから統計情報を計算する
+
+    統計計算にはファームウェアと同じ Statistics / Result を使うため、
+    `EvalSource::RECORDED` のときは実機と同じ値になる。
+*/
+Result summarize(
+    const MappedLog& log,
+    const LogSegment& segment,
+    EvalSource source
+);
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -0,0 +1,105 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    BBPAnalyzer と Result::update のファジングハーネス（libFuzzer）
+
+    入力のバイト列を2通りに解釈して、解析と統計更新に流す。
+
+    - 17バイトごとに区切ったnotifyフレーム列として BBPAnalyzer::analyze に流し、
+      FINISHED になったらオートモードと同じく Result::update に渡す
+    - 66バイトごとに区切った（SP 2バイト + プロファイル 32×2バイト）レコード列として、
+      Result::update に直接渡す（BBPAnalyzer が作らない値の組み合わせも試す）
+
+    FUZZ_STANDALONE を定義すると、libFuzzer なしでコーパスのファイルを
+    1つずつ流す main を持つ（gcc のサニタイザでの確認用）。
+*/
+
+// C++標準ライブラリ
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint16_t
+#include <cstring>      // std::memcpy
+
+// shark lib
+#include "bbp_analyzer.hh"
+
+// ATLAS
+#include "result.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+//! Result::update に直接渡すレコードの長さ
+constexpr std::size_t RECORD_LENGTH = 2 + 32 * 2;
+
+//! notifyフレーム列として解析する
+void fuzzAnalyzer(const std::uint8_t* data, std::size_t size, atlas::Result& result)
+{
+    shark::BBPAnalyzer analyzer;
+    for (std::size_t pos = 0; pos + shark::BBPData::LENGTH <= size; pos += shark::BBPData::LENGTH) {
+        shark::BBPData frame;
+        std::memcpy(frame.data(), data + pos, shark::BBPData::LENGTH);
+        if (analyzer.analyze(frame) == shark::BBPState::FINISHED) {
+            std::uint16_t acc1 = 0, acc2 = 0;
+            result.update(analyzer.sp(), analyzer.raw(), acc1, acc2);
+            analyzer.clear();
+        }
+    }
+}
+
+//! SPとプロファイルのレコード列として統計を更新する
+void fuzzResult(const std::uint8_t* data, std::size_t size, atlas::Result& result)
+{
+    for (std::size_t pos = 0; pos + RECORD_LENGTH <= size; pos += RECORD_LENGTH) {
+        std::uint16_t sp;
+        std::uint16_t profile[32];
+        std::memcpy(&sp, data + pos, sizeof(sp));
+        std::memcpy(profile, data + pos + sizeof(sp), sizeof(profile));
+
+        std::uint16_t acc1 = 0, acc2 = 0;
+        result.update(sp, profile, acc1, acc2);
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    atlas::Result result;
+    result.initialize();
+    fuzzAnalyzer(data, size, result);
+
+    result.initialize();
+    fuzzResult(data, size, result);
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+// C++標準ライブラリ
+#include <cstdio>       // std::fopen, std::fread, std::printf
+#include <vector>       // std::vector
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        FILE* fp = std::fopen(argv[i], "rb");
+        if (!fp) {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        std::vector<std::uint8_t> buf;
+        std::uint8_t chunk[4096];
+        std::size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+            buf.insert(buf.end(), chunk, chunk + n);
+        }
+        std::fclose(fp);
+
+        LLVMFuzzerTestOneInput(buf.data(), buf.size());
+        std::printf("%s: %zu bytes\n", argv[i], buf.size());
+    }
+    return 0;
+}
+#endif
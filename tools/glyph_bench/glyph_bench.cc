@@ -0,0 +1,218 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    数字の描画（numberW9 / numberW18）の比較ツール
+
+    従来の描画（sprintf で文字列にし、1桁ずつ drawBitmap で1ドットずつ描く）と、
+    ファームウェアの描画（整数演算で桁に分解し、縦1列ずつバッファに直接書き込む）を
+    メモリ上の128x64のバッファで比較する。
+
+    - 乱数の数値・座標（画面端のはみ出しを含む）で、両者の描画結果が一致すること
+    - 統計ページ（_showStats の6つの数値）とSP表示（numberW18）の描画時間
+
+    描画結果が異なれば終了コード1を返す。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdint>      // std::uint32_t
+#include <cstdio>       // std::printf, std::sprintf
+#include <cstdlib>      // std::atoi, std::atol
+#include <cstring>      // std::memcmp
+#include <random>       // std::mt19937
+#include <string>       // std::string
+
+// shark lib
+#include "frame_buffer.hh"
+#include "monochrome_display.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+using Display = shark::MonochromeDisplay<shark::FrameBuffer>;
+
+constexpr std::uint8_t WIDTH = 128;
+constexpr std::uint8_t HEIGHT = 64;
+
+//! コマンドライン引数
+struct Options
+{
+    unsigned repeat = 100000;   //!< 描画時間の計測の繰り返し回数
+    unsigned cases = 100000;    //!< 描画結果の比較の回数
+    std::uint32_t seed = 1;     //!< 乱数シード
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -n REPEAT         pages rendered per path for timing (default: 100000)\n"
+        "  -c CASES          random cases for the pixel comparison (default: 100000)\n"
+        "  -s SEED           random seed (default: 1)\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-n" && hasValue) {
+            opts.repeat = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-c" && hasValue) {
+            opts.cases = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-s" && hasValue) {
+            opts.seed = static_cast<std::uint32_t>(std::atol(argv[++i]));
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! 従来の描画（MonochromeDisplay::_numberImg の以前の実装と同じ）
+void legacyNumber(
+    shark::FrameBuffer& fb,
+    std::int16_t x,
+    std::int16_t y,
+    std::uint32_t number,
+    std::int16_t numDigits,
+    std::int16_t w,
+    std::int16_t h,
+    const std::uint8_t** images
+) {
+    char buf[21];
+    std::int16_t n = std::sprintf(buf, "%u", number);
+    if (numDigits > 0) {
+        for (std::int16_t i = n-1; i >= 0; i -= 1) {
+            fb.drawBitmap(x + w * (i + numDigits - n), y,
+                          images[buf[i] - '0'], w, h, 1);
+        }
+    }
+    else {
+        for (std::int16_t i = 0; i < n; i += 1) {
+            fb.drawBitmap(x + w * i, y, images[buf[i] - '0'], w, h, 1);
+        }
+    }
+}
+
+//! 統計ページの数値（View::_showStats と同じ座標・桁数）
+struct StatsValues
+{
+    std::uint32_t latest, total, mean, stdev, max, min;
+};
+
+void statsLegacy(shark::FrameBuffer& fb, const StatsValues& v)
+{
+    legacyNumber(fb, 28, 16, v.latest, 5, 9, 14, shark::digitsW9);
+    legacyNumber(fb, 91, 16, v.total, 0, 9, 14, shark::digitsW9);
+    legacyNumber(fb, 28, 33, v.mean, 5, 9, 14, shark::digitsW9);
+    legacyNumber(fb, 83, 33, v.stdev, 0, 9, 14, shark::digitsW9);
+    legacyNumber(fb, 28, 50, v.max, 5, 9, 14, shark::digitsW9);
+    legacyNumber(fb, 83, 50, v.min, 0, 9, 14, shark::digitsW9);
+}
+
+void statsBlit(Display& disp, const StatsValues& v)
+{
+    disp.numberW9(28, 16, v.latest, 5);
+    disp.numberW9(91, 16, v.total);
+    disp.numberW9(28, 33, v.mean, 5);
+    disp.numberW9(83, 33, v.stdev);
+    disp.numberW9(28, 50, v.max, 5);
+    disp.numberW9(83, 50, v.min);
+}
+
+bool sameBuffer(const shark::FrameBuffer& a, const shark::FrameBuffer& b)
+{
+    return std::memcmp(a.getBuffer(), b.getBuffer(), WIDTH * HEIGHT / 8) == 0;
+}
+
+//! f を n 回実行した1回あたりの時間 [us]
+template <class F>
+double measure(unsigned n, F f)
+{
+    const auto t0 = Clock::now();
+    for (unsigned i = 0; i < n; ++i) {
+        f(i);
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / n;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    shark::FrameBuffer legacy(WIDTH, HEIGHT);
+    Display disp(WIDTH, HEIGHT);
+    disp.begin(0);
+    const auto& blit = disp.driver();
+
+    // 描画結果の比較
+    std::mt19937 rng(opts.seed);
+    unsigned mismatches = 0;
+    for (unsigned c = 0; c < opts.cases; ++c) {
+        const bool large = rng() & 1;
+        const auto x = static_cast<std::int16_t>(static_cast<int>(rng() % 160) - 16);
+        const auto y = static_cast<std::int16_t>(static_cast<int>(rng() % 96) - 16);
+        const std::uint32_t number = rng() >> (rng() % 32);
+        const auto numDigits = static_cast<std::int16_t>(rng() % 7);
+
+        legacy.clearDisplay();
+        disp.clear();
+        if (large) {
+            legacyNumber(legacy, x, y, number, numDigits, 18, 24, shark::digitsW18);
+            disp.numberW18(x, y, number, numDigits);
+        }
+        else {
+            legacyNumber(legacy, x, y, number, numDigits, 9, 14, shark::digitsW9);
+            disp.numberW9(x, y, number, numDigits);
+        }
+        if (!sameBuffer(legacy, blit)) {
+            if (mismatches == 0) {
+                std::printf("mismatch: %s x=%d y=%d number=%u digits=%d\n",
+                            large ? "W18" : "W9", x, y, number, numDigits);
+            }
+            ++mismatches;
+        }
+    }
+
+    // 描画時間（数値は毎回変える。上書きしても時間は変わらないのでクリアしない）
+    auto values = [](unsigned i) {
+        return StatsValues{8000 + i % 4000, i % 1000, 9000 + i % 500, 300 + i % 700,
+                           12000 + i % 3000, 6000 + i % 900};
+    };
+    const double statsOld = measure(opts.repeat, [&](unsigned i) {
+        statsLegacy(legacy, values(i));
+    });
+    const double statsNew = measure(opts.repeat, [&](unsigned i) {
+        statsBlit(disp, values(i));
+    });
+    const double spOld = measure(opts.repeat, [&](unsigned i) {
+        legacyNumber(legacy, 35, 26, 8000 + i % 4000, 5, 18, 24, shark::digitsW18);
+    });
+    const double spNew = measure(opts.repeat, [&](unsigned i) {
+        disp.numberW18(35, 26, 8000 + i % 4000, 5);
+    });
+
+    std::printf("%u random cases, %u mismatch(es)\n", opts.cases, mismatches);
+    std::printf("%-22s %12s %12s %8s\n", "", "legacy[us]", "blit[us]", "speedup");
+    std::printf("%-22s %12.3f %12.3f %7.1fx\n", "stats page (6 x W9)", statsOld, statsNew, statsOld / statsNew);
+    std::printf("%-22s %12.3f %12.3f %7.1fx\n", "SP (1 x W18)", spOld, spNew, spOld / spNew);
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    画像の圧縮ツール
+
+    モノクロのPBM（P4）を、ディスプレイのRAMと同じページ単位の並びに変換して
+    PackBits で圧縮し、ファームウェアに組み込むC++の配列（shark::PackedBitmap）を生成する。
+
+    - 圧縮前（Adafruit GFX 形式）と圧縮後のバイト数（フラッシュの使用量）
+    - ファームウェアの展開（blitPacked）の描画結果が、圧縮前の drawBitmap と
+      一致すること（画面端のはみ出し・色の指定を含む）
+    - drawBitmap と blitPacked の描画時間
+
+    描画結果が異なれば終了コード1を返す。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max, std::min
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdint>      // std::uint8_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::atoi
+#include <cstring>      // std::memcmp
+#include <fstream>      // std::ifstream, std::ofstream
+#include <iterator>     // std::istreambuf_iterator
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// shark lib
+#include "frame_buffer.hh"
+#include "packed_bitmap.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::int16_t WIDTH = 128;
+constexpr std::int16_t HEIGHT = 64;
+
+//! コマンドライン引数
+struct Options
+{
+    std::string output;             //!< 生成するC++ファイル（空なら生成しない）
+    unsigned repeat = 10000;        //!< 描画時間の計測の繰り返し回数
+    std::vector<std::string> inputs;    //!< PBMファイル
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options] IMAGE.pbm...\n"
+        "  -o FILE           write the packed arrays to FILE (C++ source)\n"
+        "  -n REPEAT         draws per image for timing (default: 10000)\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            opts.output = argv[++i];
+        }
+        else if (arg == "-n" && hasValue) {
+            opts.repeat = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (!arg.empty() && arg[0] != '-') {
+            opts.inputs.push_back(arg);
+        }
+        else {
+            return false;
+        }
+    }
+    return !opts.inputs.empty();
+}
+
+//! 画像
+struct Image
+{
+    std::string name;               //!< 配列名（ファイル名の拡張子を除いたもの）
+    std::int16_t width = 0;
+    std::int16_t height = 0;
+    std::vector<std::uint8_t> raw;      //!< Adafruit GFX 形式（1行 (w+7)/8 バイト、MSBが左）
+    std::vector<std::uint8_t> packed;   //!< ページ単位の並びを PackBits で圧縮したもの
+};
+
+//! PBM（P4）を読み込む。P4 の画像データは Adafruit GFX 形式と同じ並び
+bool readPBM(const std::string& path, Image& img)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        return false;
+    }
+    const std::string data{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+
+    std::size_t pos = 0;
+    auto nextToken = [&]() {
+        while (pos < data.size()) {
+            if (data[pos] == '#') {
+                while (pos < data.size() && data[pos] != '\n') {
+                    pos += 1;
+                }
+            }
+            else if (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\r' || data[pos] == '\n') {
+                pos += 1;
+            }
+            else {
+                break;
+            }
+        }
+        const std::size_t begin = pos;
+        while (pos < data.size() && data[pos] > ' ') {
+            pos += 1;
+        }
+        return data.substr(begin, pos - begin);
+    };
+    if (nextToken() != "P4") {
+        return false;
+    }
+    img.width = static_cast<std::int16_t>(std::atoi(nextToken().c_str()));
+    img.height = static_cast<std::int16_t>(std::atoi(nextToken().c_str()));
+    pos += 1;
+    const std::size_t size = static_cast<std::size_t>((img.width + 7) / 8) * img.height;
+    if (img.width <= 0 || img.width > 255 || img.height <= 0 || img.height > 255
+        || data.size() < pos + size) {
+        return false;
+    }
+    img.raw.assign(data.begin() + pos, data.begin() + pos + size);
+
+    // 配列名
+    std::string base = path.substr(path.find_last_of('/') + 1);
+    img.name = base.substr(0, base.find_last_of('.'));
+    return true;
+}
+
+//! Adafruit GFX 形式を、ページ単位の並び（1バイト = 縦8ドット、LSBが上）に変換する
+std::vector<std::uint8_t> toPages(const Image& img)
+{
+    const std::int16_t byteWidth = (img.width + 7) / 8;
+    const std::int16_t pages = (img.height + 7) / 8;
+    std::vector<std::uint8_t> out;
+    for (std::int16_t p = 0; p < pages; p += 1) {
+        for (std::int16_t i = 0; i < img.width; i += 1) {
+            std::uint8_t b = 0;
+            for (std::int16_t j = 0; j < 8; j += 1) {
+                const std::int16_t y = p * 8 + j;
+                if (y < img.height && (img.raw[y * byteWidth + i / 8] & (0x80 >> (i & 7)))) {
+                    b |= 1 << j;
+                }
+            }
+            out.push_back(b);
+        }
+    }
+    return out;
+}
+
+//! PackBits で圧縮する（2バイト以上の連続は繰り返し、それ以外はそのまま）
+std::vector<std::uint8_t> packBits(const std::vector<std::uint8_t>& in)
+{
+    std::vector<std::uint8_t> out;
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+    while (i < n) {
+        // 繰り返し
+        std::size_t run = 1;
+        while (i + run < n && in[i + run] == in[i] && run < 128) {
+            run += 1;
+        }
+        if (run >= 2) {
+            out.push_back(static_cast<std::uint8_t>(1 - static_cast<int>(run)));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+
+        // そのまま（次の繰り返しの手前まで）
+        std::size_t len = 1;
+        while (i + len < n && len < 128
+               && !(i + len + 1 < n && in[i + len] == in[i + len + 1])) {
+            len += 1;
+        }
+        out.push_back(static_cast<std::uint8_t>(len - 1));
+        out.insert(out.end(), in.begin() + i, in.begin() + i + len);
+        i += len;
+    }
+    return out;
+}
+
+inline shark::PackedBitmap packedOf(const Image& img)
+{
+    return shark::PackedBitmap{
+        img.packed.data(),
+        static_cast<std::uint16_t>(img.packed.size()),
+        static_cast<std::uint8_t>(img.width),
+        static_cast<std::uint8_t>(img.height)
+    };
+}
+
+//! 背景を決まった模様で埋める（消す・反転も確認できるように）
+void fillPattern(shark::FrameBuffer& fb)
+{
+    std::uint8_t* buf = fb.getBuffer();
+    std::uint32_t x = 2463534242u;
+    for (int i = 0; i < WIDTH * HEIGHT / 8; ++i) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = static_cast<std::uint8_t>(x);
+    }
+}
+
+//! 画面端のはみ出しや、ページの境界をまたぐ位置で drawBitmap と比較する。異なる回数を返す
+unsigned verify(const Image& img)
+{
+    const std::int16_t w = img.width;
+    const std::int16_t h = img.height;
+    const std::int16_t xs[] = {
+        static_cast<std::int16_t>(-w / 2), 0, 3, static_cast<std::int16_t>(WIDTH - w),
+        static_cast<std::int16_t>(WIDTH - w / 2)
+    };
+    std::vector<std::int16_t> ys = {
+        static_cast<std::int16_t>(-h / 2), -3, static_cast<std::int16_t>(HEIGHT - h),
+        static_cast<std::int16_t>(HEIGHT - h / 2 + 3)
+    };
+    for (std::int16_t y = 0; y < 8; y += 1) {
+        ys.push_back(y);
+    }
+
+    const auto packed = packedOf(img);
+    shark::FrameBuffer expected(WIDTH, HEIGHT);
+    shark::FrameBuffer actual(WIDTH, HEIGHT);
+    unsigned mismatches = 0;
+    for (std::uint16_t color = 0; color < 3; color += 1) {
+        for (auto x : xs) {
+            for (auto y : ys) {
+                fillPattern(expected);
+                fillPattern(actual);
+                expected.drawBitmap(x, y, img.raw.data(), w, h, color);
+                shark::blitPacked(actual.getBuffer(), WIDTH, HEIGHT, x, y, packed, color);
+                if (std::memcmp(expected.getBuffer(), actual.getBuffer(), WIDTH * HEIGHT / 8) != 0) {
+                    if (mismatches == 0) {
+                        std::printf("mismatch: %s x=%d y=%d color=%u\n",
+                                    img.name.c_str(), x, y, color);
+                    }
+                    mismatches += 1;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+//! f を n 回実行した1回あたりの時間 [us]
+template <class F>
+double measure(unsigned n, F f)
+{
+    const auto t0 = Clock::now();
+    for (unsigned i = 0; i < n; ++i) {
+        f();
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / n;
+}
+
+//! 生成するC++ファイル
+std::string generate(const std::vector<Image>& images)
+{
+    std::string out =
+        "/*\n"
+        "    \xC2\xA9 2025,2026  @shark_minister\n"
+        "    Released under the MIT License, see accompaying LICENSE.txt.\n"
+        "*/\n"
+        "/*\n"
+        "    tools/image_pack で core/assets/images のPBMから生成したファイル。\n"
+        "    直接編集せず、画像を変えて生成し直すこと（tools/README.md）。\n"
+        "*/\n"
+        "#include \"images.hh\"\n"
+        "\n"
+        "namespace atlas {\n"
+        "namespace img {\n"
+        "//-----------------------------------------------------------------------------\n"
+        "\n"
+        "namespace {\n";
+
+    char line[128];
+    for (const auto& img : images) {
+        std::snprintf(line, sizeof(line), "\n// %dx%dpx, %zu -> %zu bytes\n",
+                      img.width, img.height, img.raw.size(), img.packed.size());
+        out += line;
+        out += "const std::uint8_t " + img.name + "Data[] PROGMEM = {";
+        for (std::size_t i = 0; i < img.packed.size(); ++i) {
+            std::snprintf(line, sizeof(line), "%s0x%02x%s",
+                          i % 16 == 0 ? "\n    " : " ", img.packed[i],
+                          i + 1 < img.packed.size() ? "," : "");
+            out += line;
+        }
+        out += "\n};\n";
+    }
+    out += "\n} // namespace\n\n";
+
+    for (const auto& img : images) {
+        std::snprintf(line, sizeof(line), ", sizeof(%sData), %d, %d};\n",
+                      img.name.c_str(), img.width, img.height);
+        out += "const shark::PackedBitmap " + img.name + " = {" + img.name + "Data" + line;
+    }
+    out +=
+        "\n"
+        "//-----------------------------------------------------------------------------\n"
+        "} // namespace img\n"
+        "} // namespace atlas\n";
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Image> images;
+    for (const auto& path : opts.inputs) {
+        Image img;
+        if (!readPBM(path, img)) {
+            std::fprintf(stderr, "cannot read %s\n", path.c_str());
+            return 2;
+        }
+        img.packed = packBits(toPages(img));
+        images.push_back(img);
+    }
+
+    // 圧縮率・描画結果の比較・描画時間（画面の中央に描く）
+    shark::FrameBuffer fb(WIDTH, HEIGHT);
+    unsigned mismatches = 0;
+    std::size_t totalRaw = 0;
+    std::size_t totalPacked = 0;
+    std::printf("%-20s %8s %6s %7s %7s %14s %12s\n",
+                "image", "size", "raw", "packed", "ratio", "drawBitmap[us]", "packed[us]");
+    for (const auto& img : images) {
+        mismatches += verify(img);
+
+        const auto packed = packedOf(img);
+        const auto x = static_cast<std::int16_t>((WIDTH - img.width) / 2);
+        const auto y = static_cast<std::int16_t>((HEIGHT - img.height) / 2);
+        const double rawUs = measure(opts.repeat, [&]() {
+            fb.drawBitmap(x, y, img.raw.data(), img.width, img.height, 1);
+        });
+        const double packedUs = measure(opts.repeat, [&]() {
+            shark::blitPacked(fb.getBuffer(), WIDTH, HEIGHT, x, y, packed, 1);
+        });
+
+        totalRaw += img.raw.size();
+        totalPacked += img.packed.size();
+        const std::string size = std::to_string(img.width) + "x" + std::to_string(img.height);
+        std::printf("%-20s %8s %6zu %7zu %6.0f%% %14.3f %12.3f\n",
+                    img.name.c_str(), size.c_str(), img.raw.size(), img.packed.size(),
+                    100.0 * img.packed.size() / img.raw.size(), rawUs, packedUs);
+    }
+    // 圧縮後は画像ごとに PackedBitmap（ESP32では8バイト）も置く
+    const std::size_t descriptors = images.size() * 8;
+    std::printf("total: raw %zu bytes, packed %zu + %zu bytes, saved %ld bytes of flash\n",
+                totalRaw, totalPacked, descriptors,
+                static_cast<long>(totalRaw) - static_cast<long>(totalPacked + descriptors));
+    std::printf("%u mismatch(es)\n", mismatches);
+
+    if (!opts.output.empty()) {
+        std::ofstream ofs(opts.output, std::ios::binary);
+        const std::string src = generate(images);
+        ofs.write(src.data(), src.size());
+        if (!ofs) {
+            std::fprintf(stderr, "cannot write %s\n", opts.output.c_str());
+            return 2;
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
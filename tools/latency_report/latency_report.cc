@@ -0,0 +1,263 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    遅延の計測結果の表示ツール
+
+    マニュアル/設定モードで遅延の計測結果のキャラクタリスティック（ATLAS_CHR_LATENCY）
+    から読み出した値（LatencyReport、core/include/latency_probe.hh）を表にする。
+    -b なら起動の段階ごとの時刻のキャラクタリスティック（ATLAS_CHR_BOOT）から読み出した値
+    （BootReport、core/include/boot_profile.hh）を時刻の順に表にする。
+
+    入力はバイナリのファイル、または16進数のテキスト（-x。BLEのアプリが表示する
+    "0x05-18-00-..." のような形式。数字以外の区切りは読み飛ばす）。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max, std::sort
+#include <cctype>       // std::isxdigit, std::isdigit, std::tolower
+#include <cstdint>      // std::uint8_t, std::uint32_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstring>      // std::memcpy
+#include <fstream>      // std::ifstream
+#include <iostream>     // std::cin
+#include <iterator>     // std::istreambuf_iterator
+#include <string>       // std::string
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+
+// ATLAS
+#include "boot_profile.hh"
+#include "latency_probe.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using atlas::BootReport;
+using atlas::LatencyHistogram;
+using atlas::LatencyReport;
+
+//! 計測点の説明
+const char* const PROBE_LABELS[] = {
+#define ATLAS_PROBE_LABEL(name, label) label,
+    ATLAS_LATENCY_PROBES(ATLAS_PROBE_LABEL)
+#undef ATLAS_PROBE_LABEL
+};
+
+//! 起動の段階の説明
+const char* const STAGE_LABELS[] = {
+#define ATLAS_BOOT_STAGE_LABEL(name, label) label,
+    ATLAS_BOOT_STAGES(ATLAS_BOOT_STAGE_LABEL)
+#undef ATLAS_BOOT_STAGE_LABEL
+};
+
+//! コマンドライン引数
+struct Options
+{
+    std::string input = "-";    //!< 入力ファイル（- なら標準入力）
+    bool hex = false;           //!< 16進数のテキストかどうか
+    bool histogram = false;     //!< ヒストグラムを表示するかどうか
+    bool boot = false;          //!< 起動の段階ごとの時刻かどうか
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options] [FILE]\n"
+        "  -x                input is hex text (e.g. copied from a BLE app)\n"
+        "  -H                also print the histogram of each probe\n"
+        "  -b                input is the boot report (boot characteristic)\n"
+        "  FILE              value read from the latency characteristic (default: stdin)\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-x") {
+            opts.hex = true;
+        }
+        else if (arg == "-H") {
+            opts.histogram = true;
+        }
+        else if (arg == "-b") {
+            opts.boot = true;
+        }
+        else if (arg == "-" || arg[0] != '-') {
+            opts.input = arg;
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! 16進数のテキストをバイト列にする（"0x" と区切りは読み飛ばす）
+std::string fromHex(const std::string& text)
+{
+    std::string out;
+    int nibbles = 0;
+    unsigned value = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '0' && i + 1 < text.size() && (text[i + 1] == 'x' || text[i + 1] == 'X')) {
+            i += 1;
+            continue;
+        }
+        if (!std::isxdigit(static_cast<unsigned char>(c))) {
+            continue;
+        }
+        value = value * 16 + (std::isdigit(static_cast<unsigned char>(c))
+            ? c - '0'
+            : std::tolower(static_cast<unsigned char>(c)) - 'a' + 10);
+        if (++nibbles == 2) {
+            out += static_cast<char>(value);
+            nibbles = 0;
+            value = 0;
+        }
+    }
+    return out;
+}
+
+//! ビンの範囲の表示（"512-1023us" など）
+std::string bucketRange(std::uint8_t k, std::uint8_t numBuckets)
+{
+    const unsigned long lo = (k == 0) ? 0 : 1UL << k;
+    if (k + 1 == numBuckets) {
+        return ">=" + std::to_string(lo) + "us";
+    }
+    return std::to_string(lo) + "-" + std::to_string((2UL << k) - 1) + "us";
+}
+
+void printHistogram(const LatencyHistogram& h, std::uint8_t numBuckets)
+{
+    std::uint32_t peak = 0;
+    for (std::uint8_t k = 0; k < numBuckets; ++k) {
+        peak = std::max<std::uint32_t>(peak, h.buckets[k]);
+    }
+    if (peak == 0) {
+        return;
+    }
+    for (std::uint8_t k = 0; k < numBuckets; ++k) {
+        if (h.buckets[k] == 0) {
+            continue;
+        }
+        const int width = static_cast<int>((40.0 * h.buckets[k] + peak - 1) / peak);
+        std::printf("    %22s %6u %s\n", bucketRange(k, numBuckets).c_str(),
+                    h.buckets[k], std::string(width, '#').c_str());
+    }
+}
+
+//! 起動の段階ごとの時刻を、時刻の順に表示する（裏のタスクの段階は他と前後する）
+int printBoot(const std::string& data)
+{
+    if (data.size() < 4) {
+        std::fprintf(stderr, "too short (%zu bytes)\n", data.size());
+        return 1;
+    }
+    const auto numStages = static_cast<std::uint8_t>(data[0]);
+    if (numStages > 16 || data.size() < 4 + numStages * sizeof(std::uint32_t)) {
+        std::fprintf(stderr, "unexpected size (%zu bytes, %u stages)\n", data.size(), numStages);
+        return 1;
+    }
+    std::uint16_t failed;
+    std::memcpy(&failed, data.data() + 2, sizeof(failed));
+
+    std::vector<std::pair<std::uint32_t, std::uint8_t>> stamps;
+    for (std::uint8_t i = 0; i < numStages; ++i) {
+        std::uint32_t stamp;
+        std::memcpy(&stamp, data.data() + 4 + i * sizeof(stamp), sizeof(stamp));
+        stamps.emplace_back(stamp, i);
+    }
+    std::sort(stamps.begin(), stamps.end(), [](const auto& a, const auto& b) {
+        // 到達していない段階（0）は最後に
+        return (a.first == 0) != (b.first == 0) ? b.first == 0 : a < b;
+    });
+
+    std::printf("%-24s %10s %10s\n", "stage", "at [ms]", "+ [ms]");
+    std::uint32_t prev = 0;
+    for (const auto& [stamp, i] : stamps) {
+        const std::string label = i < BootReport::NUM_STAGES
+            ? STAGE_LABELS[i]
+            : "stage " + std::to_string(i);
+        if (stamp == 0) {
+            std::printf("%-24s %10s %10s\n", label.c_str(), "-", "-");
+            continue;
+        }
+        std::printf("%-24s %10.1f %10.1f%s\n", label.c_str(), stamp / 1000.0,
+                    (stamp - prev) / 1000.0, (failed >> i) & 1 ? "  failed" : "");
+        prev = stamp;
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string data;
+    if (opts.input == "-") {
+        data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+    else {
+        std::ifstream ifs(opts.input, std::ios::binary);
+        if (!ifs) {
+            std::fprintf(stderr, "cannot read %s\n", opts.input.c_str());
+            return 2;
+        }
+        data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    if (opts.hex) {
+        data = fromHex(data);
+    }
+    if (opts.boot) {
+        return printBoot(data);
+    }
+
+    // ヘッダ（計測点・ビンの数が違うファームウェアにも対応する）
+    if (data.size() < 4) {
+        std::fprintf(stderr, "too short (%zu bytes)\n", data.size());
+        return 1;
+    }
+    const auto numProbes = static_cast<std::uint8_t>(data[0]);
+    const auto numBuckets = static_cast<std::uint8_t>(data[1]);
+    const std::size_t probeSize = 5 * sizeof(std::uint32_t) + numBuckets * sizeof(std::uint16_t);
+    if (numBuckets > LatencyHistogram::NUM_BUCKETS || data.size() < 4 + numProbes * probeSize) {
+        std::fprintf(stderr, "unexpected size (%zu bytes, %u probes, %u buckets)\n",
+                     data.size(), numProbes, numBuckets);
+        return 1;
+    }
+
+    std::printf("%-22s %8s %9s %9s %9s %9s  [us]\n", "probe", "count", "min", "p50", "p99", "max");
+    for (std::uint8_t i = 0; i < numProbes; ++i) {
+        LatencyHistogram h {};
+        const char* src = data.data() + 4 + i * probeSize;
+        std::memcpy(&h, src, 5 * sizeof(std::uint32_t));
+        std::memcpy(h.buckets, src + 5 * sizeof(std::uint32_t), numBuckets * sizeof(std::uint16_t));
+
+        const std::string label = i < LatencyReport::NUM_PROBES
+            ? PROBE_LABELS[i]
+            : "probe " + std::to_string(i);
+        if (h.count == 0) {
+            std::printf("%-22s %8u %9s %9s %9s %9s\n", label.c_str(), 0u, "-", "-", "-", "-");
+            continue;
+        }
+        std::printf("%-22s %8u %9u %9u %9u %9u\n", label.c_str(),
+                    h.count, h.min, h.p50, h.p99, h.max);
+        if (opts.histogram) {
+            printHistogram(h, numBuckets);
+        }
+    }
+    return 0;
+}
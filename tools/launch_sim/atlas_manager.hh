@@ -0,0 +1,148 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    ホスト（PC）で射出シーケンサー（launch_sequencer.cc）を動かすための AtlasManager の代わり
+
+    モーター（MotorDriver）とシーケンサーはファームウェアのものをそのまま使い、
+    GPIO・タイマー・タスクは os_sim.cc の仮想のものにする。音声と画面表示は
+    呼ばれた時刻を記録するだけのものに置き換える。
+    -Itools/launch_sim を -Icore/include より先に指定して、
+    ファームウェアの atlas_manager.hh の代わりに読み込ませる。
+*/
+#ifndef ATLAS_MANAGER_HH
+#define ATLAS_MANAGER_HH
+
+// C++標準ライブラリ
+#include <cstdint>  // std::uint8_t, std::int32_t, std::int64_t
+
+// shark lib
+#include "motor_driver.hh"
+#include "os.hh"
+
+// ATLAS
+#include "setting.hh"
+#include "latency_probe.hh"     // 計測点
+#include "launch_sequencer.hh"  // 射出シーケンサー
+#include "motor_calibration.hh" // SP較正
+#include "params.hh"            // パラメータ
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+//! 音声プレイヤー（再生開始までの遅れを仮想時刻で再現する）
+class SimAudioPlayer
+{
+public:
+    inline bool isEnabled() const noexcept {
+        return this->enabled;
+    }
+
+    inline void play(std::uint8_t fileNumber) {
+        this->lastFile = fileNumber;
+        this->lastPlay = shark::os::now();
+        this->plays += 1;
+    }
+
+    inline void stop() {}
+
+    //! 再生開始までの時間を測る（latency [ms] だけ待って、その値を返す）
+    inline std::int32_t measureLatency(std::uint8_t fileNumber, std::uint32_t timeoutMs) {
+        if (this->latency > timeoutMs) {
+            shark::os::delay(timeoutMs);
+            return -1;
+        }
+        shark::os::delay(this->latency);
+        this->play(fileNumber);
+        return static_cast<std::int32_t>(this->latency);
+    }
+
+public:
+    bool enabled = true;            //!< プレイヤーが接続されているかどうか
+    std::uint32_t latency = 0;      //!< 再生開始までの時間 [ms]
+    std::uint8_t lastFile = 0;      //!< 最後に再生したファイル
+    std::int64_t lastPlay = 0;      //!< 最後に再生した時刻 [us]
+    std::uint32_t plays = 0;        //!< 再生した回数
+};
+
+//! 画面表示（シーケンサーが呼ぶ表示の時刻を記録する）
+class SimView
+{
+public:
+    //! カウントダウンの段階の数（"Ready Set", "3", "2", "1", "Go", "SHOOT"）
+    static constexpr int NUM_STEPS = 6;
+
+    inline void autoModeCountdown(int step) {
+        if (0 <= step && step < NUM_STEPS) {
+            this->countdown[step] = shark::os::now();
+        }
+    }
+
+    inline void autoModeAborted() {
+        this->aborted = shark::os::now();
+    }
+
+    //! 記録を消去する（射出ごとに呼ぶ）
+    inline void clear() {
+        for (auto& t : this->countdown) {
+            t = -1;
+        }
+        this->aborted = -1;
+    }
+
+public:
+    std::int64_t countdown[NUM_STEPS] {-1, -1, -1, -1, -1, -1};  //!< 各段階の表示時刻 [us]
+    std::int64_t aborted = -1;                                  //!< 中止の表示時刻 [us]
+};
+
+//! 遅延の計測（シーケンサーが記録する射出からモーター停止までの時間を残す）
+class SimLatency
+{
+public:
+    inline void record(Probe probe, std::uint32_t us) noexcept {
+        if (probe == Probe::SHOT_TO_STOP) {
+            this->lastShotToStop = us;
+        }
+    }
+
+public:
+    std::uint32_t lastShotToStop = 0;   //!< 直近の射出からモーター停止までの時間 [us]
+};
+
+class AtlasManager
+{
+public:
+    inline static AtlasManager& instance() {
+        static AtlasManager instance;
+        return instance;
+    }
+
+public:
+    //! 制御パラメータ
+    Params params;
+
+    //! SP較正
+    MotorCalibration calib;
+
+    //! モーター
+    shark::MotorDriver motors[NUM_MOTORS];
+
+    //! 射出シーケンサー
+    LaunchSequencer launcher;
+
+    //! 音声プレイヤー
+    SimAudioPlayer player;
+
+    //! 画面表示
+    SimView view;
+
+    //! 遅延の計測
+    SimLatency latency;
+};
+
+extern AtlasManager& ATLAS;
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
@@ -0,0 +1,501 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    射出シーケンスのシミュレーター
+
+    ファームウェアの射出シーケンサー（core/src/launch_sequencer.cc）とモーター制御
+    （MotorDriver）を、OSの抽象化層のホスト実装（tools/common/host/os_sim.cc）の
+    仮想時刻の上で動かし、オートモードの射出を何千回も繰り返して次を調べる。
+
+    - モーター停止の誤差（目標時刻との差）とジッター、射出指令から停止までの時間
+    - カウントダウンの各段階の表示間隔のずれ
+    - 競合の検出（いずれも見つかれば終了コード1）
+      - 停止後にPWMが出力される（加速タイマーと停止の競合）
+      - 猶予時間内の中止が効かない / 猶予時間後の中止で止まる
+      - カウントダウン中の射出指令で2回目の射出が始まる
+      - 射出の終わり際（IDLEになった後）に送った射出指令が失われる
+      - 射出が終わらない（デッドロックは os_sim.cc が検出して終了する）
+    - 実時間あたりの射出回数（スループット）
+
+    メインのスレッドはBLEのタスク（優先度 BLE_PRIORITY）の役をする。
+    射出の終わり際の指令は、BLEの受信と同じくタイマーのタスクから送る。
+    同じ seed なら同じ結果になる。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::sort, std::max, std::min
+#include <chrono>       // std::chrono::steady_clock
+#include <cmath>        // std::sqrt
+#include <cstdint>      // std::uint32_t, std::int64_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::strtoul, std::strtod
+#include <random>       // std::mt19937, std::uniform_*
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// shark lib
+#include "gpio.hh"
+#include "os.hh"
+#include "sim.hh"
+
+// ATLAS
+#include "atlas_manager.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+AtlasManager& ATLAS = AtlasManager::instance();
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+using atlas::ATLAS;
+using atlas::LaunchCommand;
+using atlas::LaunchState;
+namespace os = shark::os;
+namespace gpio = shark::gpio;
+
+// BLEのタスクの優先度（シーケンサーより高い）
+constexpr std::uint8_t BLE_PRIORITY = 20;
+
+// モーターのピン番号（仮想のGPIO）
+constexpr std::uint8_t PIN_ENABLE = 1;
+constexpr std::uint8_t PIN_PWM[2][2] = {{2, 3}, {4, 5}};   // {L, R}
+
+// 猶予時間の境界で、中止が効くかどうかを問わない幅 [us]
+constexpr std::int64_t ABORT_MARGIN = 5000;
+
+// 射出が始まるまでの最大時間 [ms]
+constexpr std::uint32_t START_TIMEOUT = 50;
+
+//! コマンドライン引数
+struct Options
+{
+    std::uint32_t launches = 1000;      //!< 射出の回数
+    os::sim::Config sim {1, 20, 40};    //!< シミュレーションの設定
+    double abortRate = 0.2;             //!< 中止指令を送る射出の割合
+    double spuriousRate = 0.2;          //!< カウントダウン中に射出指令を重ねて送る割合
+    double chainRate = 0.5;             //!< 射出の終わり際に次の射出指令を送る割合
+    std::uint32_t chainWindow = 300;    //!< モーター停止から終わり際の指令までの最大時間 [us]
+    std::uint32_t audioLatency = 80;    //!< 音声の再生開始までの時間 [ms]
+    bool verbose = false;               //!< 違反をすべて表示するかどうか
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -n LAUNCHES       number of launches (default: 1000)\n"
+        "  -s SEED           random seed (default: 1)\n"
+        "  -c US             mean CPU time per OS call (default: 20)\n"
+        "  -t US             mean timer dispatch latency (default: 40)\n"
+        "  -a RATE           fraction of launches with an abort (default: 0.2)\n"
+        "  -d RATE           fraction with a duplicate start during countdown (default: 0.2)\n"
+        "  -e RATE           fraction followed by a start right after the motor stop (default: 0.5)\n"
+        "  -w US             window after the motor stop for that start (default: 300)\n"
+        "  -l MS             audio start latency (default: 80)\n"
+        "  -v                print every violation\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-v") {
+            opts.verbose = true;
+        }
+        else if (!hasValue) {
+            return false;
+        }
+        else if (arg == "-n") {
+            opts.launches = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-s") {
+            opts.sim.seed = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-c") {
+            opts.sim.callCost = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-t") {
+            opts.sim.timerLatency = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-a") {
+            opts.abortRate = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-d") {
+            opts.spuriousRate = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-e") {
+            opts.chainRate = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-w") {
+            opts.chainWindow = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-l") {
+            opts.audioLatency = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else {
+            return false;
+        }
+    }
+    return opts.launches > 0;
+}
+
+//-----------------------------------------------------------------------------
+// 違反の記録
+//-----------------------------------------------------------------------------
+
+struct Violations
+{
+    std::uint32_t count = 0;
+    bool verbose = false;
+
+    void add(std::uint32_t launch, const char* what) {
+        if (count < 10 || verbose) {
+            std::printf("violation: launch %u: %s (t = %.3f s)\n",
+                        launch, what, os::now() / 1e6);
+        }
+        count += 1;
+    }
+};
+
+Violations gViolations;
+std::uint32_t gLaunch = 0;  // 実行中の射出の番号
+
+//-----------------------------------------------------------------------------
+// PWM出力の監視（停止後の出力を検出する）
+//-----------------------------------------------------------------------------
+
+struct PwmMonitor
+{
+    bool stopped = false;           // 停止（デューティ比0）を出力したかどうか
+    std::int64_t lastStop = -1;     // 最後に停止を出力した時刻 [us]
+    std::uint32_t outputs = 0;      // 0以外を出力した回数
+};
+
+PwmMonitor gPwm;
+
+// 射出の終わり際に送る射出指令
+struct Chain
+{
+    bool enabled = false;           // 今回の射出の後に送るかどうか
+    std::uint32_t offset = 0;       // モーター停止からの時間 [us]
+    bool posted = false;            // 送ったかどうか
+    bool wasIdle = false;           // 送ったときにシーケンサーが待機中だったかどうか
+    std::int64_t postedAt = -1;     // 送った時刻 [us]
+};
+
+Chain gChain;
+os::Timer gChainTimer;
+
+void onChainTimer(void*)
+{
+    // BLEの受信と同じく、状態を見ずに指令を送る
+    gChain.wasIdle = ATLAS.launcher.state() == LaunchState::IDLE;
+    gChain.postedAt = os::now();
+    gChain.posted = ATLAS.launcher.post(LaunchCommand::AUTO_START);
+}
+
+void onPwm(std::uint8_t /*pin*/, std::uint8_t duty, std::int64_t time, void*)
+{
+    if (duty == 0) {
+        if (!gPwm.stopped && gChain.enabled && !gChain.posted) {
+            gChainTimer.startOnce(gChain.offset);
+        }
+        gPwm.stopped = true;
+        gPwm.lastStop = time;
+        return;
+    }
+
+    gPwm.outputs += 1;
+    if (ATLAS.launcher.state() == LaunchState::COUNTDOWN) {
+        // 次の射出の加速
+        gPwm.stopped = false;
+    }
+    else if (gPwm.stopped) {
+        gViolations.add(gLaunch, "PWM output after the motor stop");
+    }
+}
+
+//-----------------------------------------------------------------------------
+// 集計
+//-----------------------------------------------------------------------------
+
+struct Samples
+{
+    std::vector<std::int64_t> values;
+
+    void add(std::int64_t v) {
+        values.push_back(v);
+    }
+
+    void print(const char* name) {
+        if (values.empty()) {
+            std::printf("%-22s (no samples)\n", name);
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        double sum = 0;
+        double sum2 = 0;
+        for (const auto v : values) {
+            sum += v;
+            sum2 += static_cast<double>(v) * v;
+        }
+        const double n = static_cast<double>(values.size());
+        const double mean = sum / n;
+        const double sd = std::sqrt(std::max(0.0, sum2 / n - mean * mean));
+        const auto at = [this](double q) {
+            return static_cast<long long>(values[static_cast<std::size_t>(q * (values.size() - 1))]);
+        };
+        std::printf("%-22s min %7lld  p50 %7lld  p99 %7lld  max %7lld  mean %9.1f  sd %8.1f\n",
+                    name, at(0.0), at(0.5), at(0.99), at(1.0), mean, sd);
+    }
+};
+
+//-----------------------------------------------------------------------------
+// 射出
+//-----------------------------------------------------------------------------
+
+// 条件が満たされるまで待つ（timeout [ms] を過ぎたら false）
+template <typename Pred>
+bool waitFor(Pred pred, std::uint32_t timeout, std::uint32_t poll = 1)
+{
+    const std::uint32_t start = os::millis();
+    while (!pred()) {
+        if (os::millis() - start >= timeout) {
+            return false;
+        }
+        os::delay(poll);
+    }
+    return true;
+}
+
+void setup(const Options& opts)
+{
+    ATLAS.params.initialize();
+    ATLAS.calib.initialize();
+    ATLAS.player.latency = opts.audioLatency;
+
+    for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+        ATLAS.motors[i].configure(PIN_PWM[i][0], PIN_PWM[i][1], PIN_ENABLE, 1000);
+        ATLAS.motors[i].setRamp(
+            static_cast<shark::RampCurve>(MOTOR_RAMP_CURVE),
+            MOTOR_RAMP_STEP_MS
+        );
+    }
+    gpio::sim::setPwmObserver(onPwm, nullptr);
+    gChainTimer.begin("chain", onChainTimer, nullptr);
+    ATLAS.launcher.begin();
+}
+
+// 音声の同期調整時間の較正（パラメータに再生開始までの時間が入る）
+void calibrateSync(const Options& opts)
+{
+    ATLAS.launcher.post(LaunchCommand::SYNC_CALIBRATE);
+    waitFor([] { return ATLAS.launcher.state() != LaunchState::IDLE; }, START_TIMEOUT);
+    if (!waitFor([] { return ATLAS.launcher.state() == LaunchState::IDLE; }, 10000, 10)) {
+        gViolations.add(0, "sync calibration did not finish");
+    }
+    const std::uint32_t expected = std::min<std::uint32_t>((opts.audioLatency + 1) / 2 * 2,
+                                                           SYNC_ADJ_UPPER_LIMIT);
+    if (ATLAS.params.syncAdj() != expected) {
+        gViolations.add(0, "sync calibration stored a wrong value");
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+    gViolations.verbose = opts.verbose;
+
+    os::sim::begin(BLE_PRIORITY, opts.sim);
+    setup(opts);
+    calibrateSync(opts);
+
+    const std::int64_t grace = 1000LL * ATLAS.params.latency();
+    const std::int64_t interval = 1000LL * COUNTDOWN_INTERVAL;
+    const std::int64_t syncAdj = 1000LL * ATLAS.params.syncAdj();
+
+    std::mt19937 rng(opts.sim.seed ^ 0x5eedU);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    Samples stopError;      // モーター停止の誤差 [us]
+    Samples shotToStop;     // 射出指令からモーター停止まで [us]
+    Samples stepError;      // カウントダウンの表示間隔のずれ [us]
+    Samples abortLatency;   // 中止指令から中止の表示まで [us]
+    std::uint32_t completed = 0;
+    std::uint32_t aborted = 0;
+    std::uint32_t chainedStarts = 0;
+    std::uint32_t chainedDropped = 0;
+
+    const auto wallStart = Clock::now();
+    const std::int64_t simStart = os::now();
+
+    bool preposted = false;     // 前の射出の終わり際に送った指令で始まったかどうか
+    std::int64_t t0 = 0;        // 射出指令を送った時刻 [us]
+    for (gLaunch = 1; gLaunch <= opts.launches; ++gLaunch) {
+        // 今回の射出の計画
+        const bool doAbort = coin(rng) < opts.abortRate;
+        const auto abortAt = static_cast<std::int64_t>(coin(rng) * 2 * grace);
+        const bool doSpurious = !doAbort && coin(rng) < opts.spuriousRate;
+        gChain = Chain {};
+        gChain.enabled = !doAbort && coin(rng) < opts.chainRate;
+        gChain.offset = static_cast<std::uint32_t>(coin(rng) * opts.chainWindow);
+
+        const std::uint32_t countBefore = ATLAS.launcher.timing().count;
+        if (!preposted) {
+            t0 = os::now();
+            ATLAS.launcher.post(LaunchCommand::AUTO_START);
+        }
+        gPwm.outputs = 0;
+
+        // 開始待ち（"Ready Set"の表示）
+        if (!waitFor([t0] { return ATLAS.view.countdown[0] >= t0; }, START_TIMEOUT)) {
+            gViolations.add(gLaunch, "launch did not start");
+            preposted = false;
+            waitFor([] { return ATLAS.launcher.state() == LaunchState::IDLE; }, 10000, 10);
+            continue;
+        }
+        const std::int64_t ready = ATLAS.view.countdown[0];
+
+        // 中止指令（猶予時間の前後）
+        std::int64_t abortPosted = -1;
+        if (doAbort) {
+            os::delay(static_cast<std::uint32_t>(abortAt / 1000));
+            abortPosted = os::now();
+            ATLAS.launcher.post(LaunchCommand::ABORT);
+        }
+
+        // カウントダウン中の射出指令（破棄されるはず）
+        if (doSpurious) {
+            waitFor([] { return ATLAS.launcher.state() == LaunchState::COUNTDOWN; }, 5000);
+            os::delay(static_cast<std::uint32_t>(coin(rng) * 3 * COUNTDOWN_INTERVAL));
+            ATLAS.launcher.post(LaunchCommand::AUTO_START);
+        }
+
+        // 終了待ち（停止を記録するか、中止を表示する）
+        const bool finished = waitFor([countBefore, t0] {
+            return ATLAS.launcher.timing().count != countBefore || ATLAS.view.aborted >= t0;
+        }, 10000, 5);
+        if (!finished) {
+            gViolations.add(gLaunch, "launch did not finish");
+            waitFor([] { return ATLAS.launcher.state() == LaunchState::IDLE; }, 10000, 10);
+            preposted = false;
+            continue;
+        }
+
+        const bool wasAborted = ATLAS.view.aborted >= t0;
+        if (doAbort) {
+            const std::int64_t sinceReady = abortPosted - ready;
+            if (sinceReady < grace - ABORT_MARGIN && !wasAborted) {
+                gViolations.add(gLaunch, "abort within the grace time was ignored");
+            }
+            if (sinceReady > grace + ABORT_MARGIN && wasAborted) {
+                gViolations.add(gLaunch, "abort after the grace time stopped the launch");
+            }
+        }
+        else if (wasAborted) {
+            gViolations.add(gLaunch, "launch aborted without an abort command");
+        }
+
+        if (wasAborted) {
+            aborted += 1;
+            abortLatency.add(ATLAS.view.aborted - abortPosted);
+            if (gPwm.outputs != 0) {
+                gViolations.add(gLaunch, "motor driven in an aborted launch");
+            }
+        }
+        else {
+            completed += 1;
+            if (ATLAS.launcher.timing().count != countBefore + 1) {
+                gViolations.add(gLaunch, "more than one launch recorded");
+            }
+            const auto timing = ATLAS.launcher.timing();
+            stopError.add(timing.lastError);
+            shotToStop.add(timing.lastLatency);
+
+            // カウントダウンの表示間隔（"3" → "2" → "1" → "Go"、"Go" → "SHOOT"）
+            const auto& cd = ATLAS.view.countdown;
+            for (int i = 1; i < 4; ++i) {
+                stepError.add(cd[i + 1] - cd[i] - interval);
+            }
+            stepError.add(cd[5] - cd[4] - (interval + syncAdj));
+        }
+
+        // 射出の終わり際に送った指令で、次の射出が始まったかどうか
+        preposted = false;
+        if (gChain.enabled && !wasAborted) {
+            waitFor([] { return gChain.posted || gChain.postedAt >= 0; }, 100);
+            os::delay(START_TIMEOUT);
+            if (gChain.posted && ATLAS.view.countdown[0] >= gChain.postedAt) {
+                chainedStarts += 1;
+                preposted = true;
+                t0 = gChain.postedAt;
+            }
+            else {
+                chainedDropped += 1;
+                if (gChain.wasIdle) {
+                    gViolations.add(gLaunch, "start command sent after the launch was lost");
+                }
+            }
+        }
+        if (!preposted) {
+            if (!waitFor([] { return ATLAS.launcher.state() == LaunchState::IDLE; }, 10000, 10)) {
+                gViolations.add(gLaunch, "sequencer did not return to IDLE");
+            }
+
+            // 停止したまま、PWMが出力されないこと（加速タイマーの残り）
+            os::delay(100);
+            for (std::uint32_t i = 0; i < NUM_MOTORS; ++i) {
+                if (gpio::sim::duty(PIN_PWM[i][0]) || gpio::sim::duty(PIN_PWM[i][1])) {
+                    gViolations.add(gLaunch, "PWM left on after the launch");
+                }
+            }
+        }
+    }
+
+    // 最後の射出が、終わり際の指令で始まっていれば終わるまで待つ
+    waitFor([] { return ATLAS.launcher.state() == LaunchState::IDLE; }, 10000, 10);
+
+    const double wall = std::chrono::duration<double>(Clock::now() - wallStart).count();
+    const double simSec = (os::now() - simStart) / 1e6;
+    const auto timing = ATLAS.launcher.timing();
+
+    std::printf("seed %u, call cost %u us, timer latency %u us, sync adj %u ms, %u motor(s)\n",
+                opts.sim.seed, opts.sim.callCost, opts.sim.timerLatency,
+                ATLAS.params.syncAdj(), static_cast<unsigned>(NUM_MOTORS));
+    std::printf("launches %u: completed %u, aborted %u; "
+                "starts at the end: %u began a launch, %u discarded\n",
+                opts.launches, completed, aborted, chainedStarts, chainedDropped);
+    stopError.print("stop error [us]");
+    shotToStop.print("shot -> stop [us]");
+    stepError.print("countdown step [us]");
+    abortLatency.print("abort -> shown [us]");
+    std::printf("sequencer: count %u, mean error %d us, jitter %u us, max skew %u us\n",
+                timing.count, timing.meanError, timing.jitter, timing.maxSkew);
+    std::printf("simulated %.1f s in %.2f s wall: %.0f launches/s, x%.0f, "
+                "%llu switches, %llu preemptions\n",
+                simSec, wall, opts.launches / wall, simSec / wall,
+                static_cast<unsigned long long>(os::sim::switches()),
+                static_cast<unsigned long long>(os::sim::preemptions()));
+    std::printf("%u violation(s)\n", gViolations.count);
+
+    os::sim::exit(gViolations.count ? 1 : 0);
+}
@@ -0,0 +1,58 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    ホスト（PC）で画面表示（view.cc）をビルドするための AtlasManager の代わり
+
+    画面表示が読み出すデータ（解析結果・パラメータ・状態）と View だけを持つ。
+    -Itools/render_bench を -Icore/include より先に指定して、
+    ファームウェアの atlas_manager.hh の代わりに読み込ませる。
+*/
+#ifndef ATLAS_MANAGER_HH
+#define ATLAS_MANAGER_HH
+
+// ATLAS
+#include "setting.hh"
+#include "result.hh"    // 解析結果
+#include "params.hh"    // パラメータ
+#include "state.hh"
+#include "view.hh"      // 画面表示
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+class AtlasManager
+{
+public:
+    inline static AtlasManager& instance() {
+        static AtlasManager instance;
+        return instance;
+    }
+
+    //! 統計情報を取得（ファームウェアと同じく、メイン表示のSPの統計）
+    inline const Statistics& statistics() const noexcept {
+        return this->params.mainSPView() == MainSPView::EVAL_SP
+            ? this->result.statsEval
+            : this->result.statsOrig;
+    }
+
+public:
+    //! 統計データ
+    Result result;
+
+    //! 制御パラメータ
+    Params params;
+
+    //! 接続状態
+    State state;
+
+    //! 画面表示
+    View view;
+};
+
+extern AtlasManager& ATLAS;
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+#endif
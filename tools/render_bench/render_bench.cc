@@ -0,0 +1,308 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    画面表示の検証・計測ツール
+
+    ファームウェアと同じ画面表示（View、core/src/view.cc）を、メモリ上の
+    128x64のバッファ（FrameBuffer）に描画し、すべての画面について次を行う。
+
+    - 正解画像（PBM）との比較（一致しなければ終了コード1）
+    - 1画面あたりの描画時間の計測
+    - 直前の画面から切り替えたときに、I2Cで送るバイト数の計算
+
+    -u で正解画像を作り直す（画面を意図して変えたとき）。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdint>      // std::uint16_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::atoi
+#include <cstring>      // std::memcpy
+#include <fstream>      // std::ifstream, std::ofstream
+#include <functional>   // std::function
+#include <iterator>     // std::istreambuf_iterator
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// ATLAS
+#include "atlas_manager.hh"
+
+namespace atlas {
+//-----------------------------------------------------------------------------
+
+AtlasManager& ATLAS = AtlasManager::instance();
+
+//-----------------------------------------------------------------------------
+} // namespace atlas
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+using atlas::ATLAS;
+using atlas::View;
+
+//! コマンドライン引数
+struct Options
+{
+    std::string golden = "tools/render_bench/golden";   //!< 正解画像のディレクトリ
+    std::string output;         //!< 描画結果の出力先（空なら出力しない）
+    bool update = false;        //!< 正解画像を作り直すかどうか
+    unsigned repeat = 1000;     //!< 描画時間の計測の繰り返し回数
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -g DIR            golden image directory (default: tools/render_bench/golden)\n"
+        "  -o DIR            write rendered images to DIR\n"
+        "  -u                update golden images instead of comparing\n"
+        "  -n REPEAT         renders per screen for timing (default: 1000)\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-g" && hasValue) {
+            opts.golden = argv[++i];
+        }
+        else if (arg == "-o" && hasValue) {
+            opts.output = argv[++i];
+        }
+        else if (arg == "-u") {
+            opts.update = true;
+        }
+        else if (arg == "-n" && hasValue) {
+            opts.repeat = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! 検証する画面
+struct Scene
+{
+    std::string name;                   //!< 名前（正解画像のファイル名）
+    std::function<void()> setup;        //!< 状態の設定
+    View::Request request;              //!< 描画要求
+};
+
+//! ページ番号を設定する
+void setPageA(std::uint8_t page)
+{
+    while (ATLAS.state.pageA() != page) {
+        ATLAS.state.nextPageA();
+    }
+}
+
+void setPageM(std::uint8_t page)
+{
+    while (ATLAS.state.pageM() != page) {
+        ATLAS.state.nextPageM();
+    }
+}
+
+//! メイン表示のSPを設定する（BLEで書き込むときと同じ8バイトの形式を書き換える）
+void setMainSPView(atlas::MainSPView view)
+{
+    std::uint8_t raw[sizeof(atlas::Params)];
+    std::memcpy(raw, &ATLAS.params, sizeof(raw));
+    raw[0] = (raw[0] & ~0x06) | (static_cast<std::uint8_t>(view) << 1);
+    std::memcpy(&ATLAS.params, raw, sizeof(raw));
+}
+
+//! 統計データを決まった値で埋める（どの環境でも同じ画像になるように）
+void fillResult()
+{
+    ATLAS.result.initialize();
+    std::uint32_t x = 12345;
+    for (int i = 0; i < 237; ++i) {
+        x = x * 1103515245u + 12345u;
+        const auto orig = static_cast<std::uint16_t>(7000 + (x >> 16) % 4500);
+        const auto eval = static_cast<std::uint16_t>(orig - (x >> 8) % 300);
+        ATLAS.result.statsOrig.update(orig);
+        ATLAS.result.statsEval.update(eval);
+    }
+}
+
+std::vector<Scene> makeScenes()
+{
+    using Screen = View::Screen;
+    auto autoState = [](bool bbp, bool bey, bool elr) {
+        return [=]() {
+            ATLAS.state.clear();
+            ATLAS.state.setBBP(bbp);
+            ATLAS.state.setBey(bey);
+            ATLAS.state.setELR(elr);
+            setMainSPView(atlas::MainSPView::EVAL_SP);
+        };
+    };
+
+    std::vector<Scene> scenes;
+    scenes.push_back({"splash", [] { ATLAS.state.clear(); }, {Screen::SPLASH, 0, 0, 0}});
+
+    // マニュアル/設定モード
+    for (std::uint8_t p = 0; p < MAX_PAGE_M; ++p) {
+        scenes.push_back({
+            "manual_p" + std::to_string(p),
+            [p] { ATLAS.state.clear(); ATLAS.state.setClient(true); setPageM(p); },
+            {Screen::MANUAL_STANDBY, 0, 0, 0}
+        });
+    }
+    scenes.push_back({
+        "manual_noclient",
+        [] { ATLAS.state.clear(); },
+        {Screen::MANUAL_STANDBY, 0, 0, 0}
+    });
+
+    // オートモード
+    scenes.push_back({"auto_promotion", autoState(false, false, false), {Screen::AUTO_PROMOTION, 0, 0, 0}});
+    for (std::uint8_t p = 0; p < MAX_PAGE_A; ++p) {
+        scenes.push_back({
+            "auto_p" + std::to_string(p),
+            [p, f = autoState(true, true, true)] { f(); setPageA(p); },
+            {Screen::AUTO_STANDBY, 0, 0, 0}
+        });
+    }
+    for (int i = 0; i < 6; ++i) {
+        scenes.push_back({
+            "countdown_" + std::to_string(i),
+            autoState(true, true, true),
+            {Screen::AUTO_COUNTDOWN, static_cast<std::int8_t>(i), 0, 0}
+        });
+    }
+    scenes.push_back({"auto_sp_eval", autoState(true, false, true), {Screen::AUTO_SP, 0, 142, 87}});
+    scenes.push_back({
+        "auto_sp_orig",
+        [f = autoState(true, false, true)] { f(); setMainSPView(atlas::MainSPView::ORIG_SP); },
+        {Screen::AUTO_SP, 0, 300, 91}
+    });
+    scenes.push_back({"auto_error", autoState(true, false, false), {Screen::AUTO_ERROR, 0, 0, 0}});
+    scenes.push_back({"auto_aborted", autoState(true, true, true), {Screen::AUTO_ABORTED, 0, 0, 0}});
+
+    // 統計の更新でヒストグラムのキャッシュが作り直されること（範囲が広がって軸も変わる）
+    scenes.push_back({
+        "auto_p1_updated",
+        [f = autoState(true, true, true)] {
+            f();
+            setPageA(1);
+            ATLAS.result.statsEval.update(15500);
+            ATLAS.result.statsEval.update(16100);
+        },
+        {Screen::AUTO_STANDBY, 0, 0, 0}
+    });
+    return scenes;
+}
+
+bool readFile(const std::string& path, std::string& data)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool writeFile(const std::string& path, const std::string& data)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.write(data.data(), data.size());
+    return static_cast<bool>(ofs);
+}
+
+//! 正解画像と異なるドット数を返す（読み込めなければ -1）
+int compareGolden(const std::string& path, const shark::FrameBuffer& fb)
+{
+    std::string data;
+    shark::FrameBuffer golden(fb.width(), fb.height());
+    if (!readFile(path, data) || !golden.fromPBM(data)) {
+        return -1;
+    }
+    int diff = 0;
+    for (std::int16_t y = 0; y < fb.height(); ++y) {
+        for (std::int16_t x = 0; x < fb.width(); ++x) {
+            diff += fb.getPixel(x, y) != golden.getPixel(x, y);
+        }
+    }
+    return diff;
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // 描画タスクは使わない（ディスプレイだけを開始し、render() を直接呼ぶ）
+    auto& view = ATLAS.view;
+    view.DisplayDriver::begin(SCREEN_ADDR);
+    ATLAS.params.initialize();
+    fillResult();
+
+    const auto scenes = makeScenes();
+    int failures = 0;
+    double totalUs = 0;
+
+    std::printf("%-16s %10s %8s  %s\n", "screen", "render[us]", "bytes", "golden");
+    for (const auto& scene : scenes) {
+        scene.setup();
+
+        // 描画時間
+        const auto t0 = Clock::now();
+        for (unsigned i = 0; i < opts.repeat; ++i) {
+            view.render(scene.request);
+        }
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count()
+                        / opts.repeat;
+        totalUs += us;
+
+        // 直前の画面からの転送量
+        view.show();
+        const auto bytes = view.lastFlushBytes();
+
+        // 正解画像
+        const auto& fb = view.driver();
+        const std::string file = scene.name + ".pbm";
+        std::string status;
+        if (!opts.output.empty()) {
+            writeFile(opts.output + "/" + file, fb.toPBM());
+        }
+        if (opts.update) {
+            status = writeFile(opts.golden + "/" + file, fb.toPBM()) ? "updated" : "WRITE FAILED";
+            failures += status != "updated";
+        }
+        else {
+            const int diff = compareGolden(opts.golden + "/" + file, fb);
+            if (diff == 0) {
+                status = "ok";
+            }
+            else {
+                status = diff < 0 ? "MISSING" : "DIFF " + std::to_string(diff) + " px";
+                failures += 1;
+            }
+        }
+        std::printf("%-16s %10.2f %8u  %s\n", scene.name.c_str(), us, bytes, status.c_str());
+    }
+
+    std::printf("%zu screens, mean render %.2f us, %d failure(s)\n",
+                scenes.size(), totalUs / scenes.size(), failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    生データファイル（/raw.dat）のリプレイツール
+
+    raw.dat に記録された各シュートのプロファイルを Result::update で
+    再解析し、result.dat の再計算、解析スループットの計測、
+    記録済み evalSP と再計算 evalSP の差分表示を行う。
+    複数ファイルはCPUコア数に応じて並列に処理する。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::atoi
+#include <fstream>      // std::ofstream
+#include <set>          // std::set
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// ATLAS
+#include "result.hh"
+#include "raw_log.hh"
+#include "parallel.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+//! evalSPの差分
+struct Diff
+{
+    std::size_t index;      //!< レコード番号
+    std::uint16_t total;    //!< 累計シュート数
+    std::uint16_t origSP;   //!< BBP記録のオリジナルSP
+    std::uint16_t oldSP;    //!< 記録済みのevalSP
+    std::uint16_t newSP;    //!< 再計算したevalSP
+};
+
+//! 1ファイル分の処理
+struct Job
+{
+    std::string path;                   //!< 入力ファイル
+    std::string output;                 //!< 再計算したresult.datの出力先
+    std::vector<atlas::RawRecord> records;
+    atlas::Result result;               //!< 再計算した解析結果
+    std::vector<Diff> diffs;            //!< evalSPの差分
+    double seconds = 0;                 //!< 解析に要した時間 [s]
+    std::string error;                  //!< エラーメッセージ
+};
+
+//! コマンドライン引数
+struct Options
+{
+    unsigned jobs = 0;          //!< 並列数
+    unsigned repeat = 1;        //!< ベンチマークの繰り返し回数
+    bool showDiff = false;      //!< 差分を表示するか
+    std::string outDir;         //!< result.datの出力先
+    std::vector<std::string> files;
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [-j N] [-n REPEAT] [-d] [-o DIR] raw.dat...\n"
+        "  -j N       number of worker threads (default: CPU cores)\n"
+        "  -n REPEAT  replay each file REPEAT times for benchmarking\n"
+        "  -d         print records whose evalSP changed\n"
+        "  -o DIR     write recomputed result.dat as DIR/<device>.result.dat\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            opts.jobs = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-n" && i + 1 < argc) {
+            opts.repeat = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-d") {
+            opts.showDiff = true;
+        }
+        else if (arg == "-o" && i + 1 < argc) {
+            opts.outDir = argv[++i];
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        }
+        else {
+            opts.files.push_back(arg);
+        }
+    }
+    return !opts.files.empty();
+}
+
+/*!
+    機器名をファイルパスから決める（analytics と同じ）
+    - device1/raw.dat → device1
+    - device1.dat     → device1
+*/
+std::string deviceName(const std::string& path)
+{
+    auto slash = path.find_last_of('/');
+    std::string base = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (base == "raw.dat" && slash != std::string::npos && slash > 0) {
+        auto parent = path.substr(0, slash);
+        auto p = parent.find_last_of('/');
+        return p == std::string::npos ? parent : parent.substr(p + 1);
+    }
+    auto dot = base.find_last_of('.');
+    return dot == std::string::npos ? base : base.substr(0, dot);
+}
+
+//! 1ファイル分のリプレイ
+void replay(Job& job, const Options& opts)
+{
+    if (!atlas::loadRawLog(job.path, job.records, job.error)) {
+        return;
+    }
+
+    auto t0 = Clock::now();
+    for (unsigned r = 0; r < opts.repeat; ++r) {
+        job.result.initialize();
+        for (std::size_t i = 0; i < job.records.size(); ++i) {
+            const auto& rec = job.records[i];
+            std::uint16_t acc1 = 0, acc2 = 0;
+
+            // evalSPが0のときは統計が更新されず、実機は直前の latestSP を記録するので、
+            // 同じく直前の値を引き継いで比較する
+            job.result.update(rec.origSP, rec.profile, acc1, acc2);
+            const std::uint16_t newSP = job.result.statsEval.latestSP;
+
+            if (r == 0 && newSP != rec.evalSP) {
+                job.diffs.push_back({i, rec.total, rec.origSP, rec.evalSP, newSP});
+            }
+        }
+    }
+    job.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    // 再計算したresult.datの出力
+    if (!job.output.empty()) {
+        std::ofstream ofs(job.output, std::ios::binary);
+        if (!ofs.write(reinterpret_cast<const char*>(&job.result),
+                       sizeof(atlas::Result))) {
+            job.error = "failed to write " + job.output;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (opts.jobs == 0) {
+        opts.jobs = atlas::defaultConcurrency();
+    }
+
+    // 出力先は機器名で分ける（同じ名前になるファイルは並列に上書きし合うので受け付けない）
+    std::vector<Job> jobs(opts.files.size());
+    std::set<std::string> outputs;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].path = opts.files[i];
+        if (!opts.outDir.empty()) {
+            jobs[i].output = opts.outDir + "/" + deviceName(jobs[i].path) + ".result.dat";
+            if (!outputs.insert(jobs[i].output).second) {
+                std::fprintf(stderr, "%s: duplicate output %s\n",
+                             jobs[i].path.c_str(), jobs[i].output.c_str());
+                return 2;
+            }
+        }
+    }
+
+    // ワーカーがファイルを1つずつ取り出して処理する
+    auto t0 = Clock::now();
+    const unsigned numWorkers = atlas::parallelFor(
+        jobs.size(), opts.jobs,
+        [&](std::size_t i) { replay(jobs[i], opts); }
+    );
+    const double wall = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    // 結果の表示（入力順）
+    int status = 0;
+    std::size_t totalShots = 0;
+    std::size_t totalDiffs = 0;
+    for (const auto& job : jobs) {
+        if (!job.error.empty()) {
+            std::fprintf(stderr, "%s: %s\n", job.path.c_str(), job.error.c_str());
+            status = 1;
+            if (job.records.empty()) continue;
+        }
+
+        const std::size_t shots = job.records.size() * opts.repeat;
+        totalShots += shots;
+        totalDiffs += job.diffs.size();
+
+        const auto& stats = job.result.statsEval;
+        std::printf(
+            "%s: %zu shots, %zu changed, mean %u, stdev %u, max %u, %.0f shots/s\n",
+            job.path.c_str(), job.records.size(), job.diffs.size(),
+            stats.meanSP, stats.stdevSP, stats.maxSP,
+            job.seconds > 0 ? shots / job.seconds : 0.0
+        );
+
+        if (opts.showDiff) {
+            for (const auto& d : job.diffs) {
+                std::printf("  #%zu (total %u) orig %u: eval %u -> %u\n",
+                            d.index, d.total, d.origSP, d.oldSP, d.newSP);
+            }
+        }
+    }
+
+    std::printf(
+        "total: %zu files, %zu shots, %zu changed, %.3f s, %.0f shots/s (%u threads)\n",
+        jobs.size(), totalShots, totalDiffs, wall,
+        wall > 0 ? totalShots / wall : 0.0, numWorkers
+    );
+    return status;
+}
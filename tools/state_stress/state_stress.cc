@@ -0,0 +1,205 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    アプリの状態（State）の並行アクセス検証ツール
+
+    ファームウェアと同じ State を、複数の書き込みスレッド（BLEコールバック・
+    モードのタスク・スイッチのタスクの代わり）と複数の読み出しスレッド
+    （画面表示の代わり）から同時に操作し、次を確認する。
+
+    - スナップショットが常に一貫していること（ベイの装着はBBP接続中だけ、
+      ページ番号は範囲内）
+    - ページ送りが取りこぼされないこと（最終ページ = 送った回数 mod ページ数）
+
+    あわせて読み出し・書き込みのスループットを表示する。
+    不整合があれば終了コード1を返す。
+*/
+
+// C++標準ライブラリ
+#include <algorithm>    // std::max
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
+#include <cstdint>      // std::uint64_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstdlib>      // std::atoi, std::atol
+#include <random>       // std::mt19937
+#include <string>       // std::string
+#include <thread>       // std::thread
+#include <vector>       // std::vector
+
+// ATLAS
+#include "state.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+//! コマンドライン引数
+struct Options
+{
+    unsigned writers = 4;           //!< 書き込みスレッド数
+    unsigned readers = 4;           //!< 読み出しスレッド数
+    unsigned ops = 1000000;         //!< 書き込みスレッドあたりの操作回数
+    std::uint32_t seed = 1;         //!< 乱数シード
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -w WRITERS        number of writer threads (default: 4)\n"
+        "  -r READERS        number of reader threads (default: 4)\n"
+        "  -n OPS            operations per writer (default: 1000000)\n"
+        "  -s SEED           random seed (default: 1)\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-w" && hasValue) {
+            opts.writers = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-r" && hasValue) {
+            opts.readers = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-n" && hasValue) {
+            opts.ops = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "-s" && hasValue) {
+            opts.seed = static_cast<std::uint32_t>(std::atol(argv[++i]));
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! 書き込みスレッドの集計
+struct WriterResult
+{
+    std::uint64_t nextA = 0;    //!< オートモードのページ送りの回数
+    std::uint64_t nextM = 0;    //!< マニュアルモードのページ送りの回数
+};
+
+//! 読み出しスレッドの集計
+struct ReaderResult
+{
+    std::uint64_t reads = 0;        //!< スナップショットの回数
+    std::uint64_t violations = 0;   //!< 不整合の回数
+    std::uint64_t beyReady = 0;     //!< ベイ装着を観測した回数（検証が空回りしていないことの確認）
+};
+
+// 書き込みスレッド（状態を乱数で更新する）
+void writer(atlas::State& state, unsigned ops, std::uint32_t seed, WriterResult& result)
+{
+    std::mt19937 rng(seed);
+    for (unsigned i = 0; i < ops; ++i) {
+        const auto r = rng();
+        const bool on = (r >> 8) & 1;
+        switch (r % 6) {
+        case 0: state.setBBP(on); break;
+        case 1: state.setBey(on); break;
+        case 2: state.setELR(on); break;
+        case 3: state.setClient(on); break;
+        case 4: state.nextPageA(); ++result.nextA; break;
+        case 5: state.nextPageM(); ++result.nextM; break;
+        }
+    }
+}
+
+// 読み出しスレッド（スナップショットの一貫性を検証する）
+void reader(const atlas::State& state, const std::atomic_bool& running, ReaderResult& result)
+{
+    while (running.load(std::memory_order_relaxed)) {
+        const auto s = state.snapshot();
+        ++result.reads;
+        if (s.isBeyReady()) {
+            ++result.beyReady;
+            if (!s.isBBPReady()) {
+                ++result.violations;
+            }
+        }
+        if (s.pageA() >= MAX_PAGE_A || s.pageM() >= MAX_PAGE_M) {
+            ++result.violations;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    atlas::State state;
+    state.clear();
+
+    std::vector<WriterResult> wres(opts.writers);
+    std::vector<ReaderResult> rres(opts.readers);
+    std::atomic_bool running {true};
+
+    auto t0 = Clock::now();
+    std::vector<std::thread> readers;
+    for (unsigned i = 0; i < opts.readers; ++i) {
+        readers.emplace_back(reader, std::cref(state), std::cref(running), std::ref(rres[i]));
+    }
+    std::vector<std::thread> writers;
+    for (unsigned i = 0; i < opts.writers; ++i) {
+        writers.emplace_back(writer, std::ref(state), opts.ops, opts.seed + i, std::ref(wres[i]));
+    }
+    for (auto& t : writers) {
+        t.join();
+    }
+    running.store(false);
+    for (auto& t : readers) {
+        t.join();
+    }
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    // 集計
+    std::uint64_t nextA = 0, nextM = 0;
+    for (const auto& w : wres) {
+        nextA += w.nextA;
+        nextM += w.nextM;
+    }
+    std::uint64_t reads = 0, violations = 0, beyReady = 0;
+    for (const auto& r : rres) {
+        reads += r.reads;
+        violations += r.violations;
+        beyReady += r.beyReady;
+    }
+
+    // ページ送りの取りこぼし
+    const auto s = state.snapshot();
+    const bool pageOK = s.pageA() == nextA % MAX_PAGE_A && s.pageM() == nextM % MAX_PAGE_M;
+    if (!s.isBBPReady() && s.isBeyReady()) {
+        ++violations;
+    }
+
+    const double writes = static_cast<double>(opts.ops) * opts.writers;
+    std::printf("%u writers x %u ops, %u readers, %.3f s\n",
+                opts.writers, opts.ops, opts.readers, sec);
+    std::printf("  writes     %.2f M/s\n", writes / sec / 1e6);
+    std::printf("  snapshots  %.2f M/s (bey ready in %llu)\n",
+                reads / sec / 1e6, static_cast<unsigned long long>(beyReady));
+    std::printf("  pages      A %u (expected %llu), M %u (expected %llu) %s\n",
+                s.pageA(), static_cast<unsigned long long>(nextA % MAX_PAGE_A),
+                s.pageM(), static_cast<unsigned long long>(nextM % MAX_PAGE_M),
+                pageOK ? "ok" : "LOST UPDATES");
+    std::printf("  violations %llu\n", static_cast<unsigned long long>(violations));
+
+    return (violations == 0 && pageOK) ? 0 : 1;
+}
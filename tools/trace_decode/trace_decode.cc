@@ -0,0 +1,253 @@
+/*
+    © 2025,2026  @shark_minister
+    Released under the MIT License, see accompaying LICENSE.txt.
+*/
+/*
+    トレースのデコーダ
+
+    ファームウェアのトレース（core/include/trace.hh、ATLAS_TRACE）を記録した
+    バイナリ（シリアルの受信データ、またはBLEの通知を順に連結したもの）を読み、
+    イベントを時刻順のテキストにする。
+
+    - シリアルではデバッグメッセージ（テキスト）と混ざるので、フレームの先頭を探して読む。
+      フレーム以外のバイトは -t で行ごとに表示する
+    - 通し番号が飛んでいれば、受信できなかった記録の数を表示する
+    - 記録が端末のバッファからあふれて捨てられていれば、その数を表示する
+*/
+
+// C++標準ライブラリ
+#include <cstdint>      // std::uint8_t, std::uint32_t
+#include <cstdio>       // std::printf, std::fprintf
+#include <cstring>      // std::memcpy
+#include <fstream>      // std::ifstream
+#include <iostream>     // std::cin
+#include <iterator>     // std::istreambuf_iterator
+#include <string>       // std::string
+#include <vector>       // std::vector
+
+// ATLAS
+#include "trace.hh"
+
+namespace {
+//-----------------------------------------------------------------------------
+
+using atlas::TraceEvent;
+using atlas::TraceFrameHeader;
+using atlas::TraceRecord;
+
+constexpr std::size_t NUM_EVENTS = static_cast<std::size_t>(TraceEvent::NUM_EVENTS);
+
+//! イベント名
+const char* const EVENT_NAMES[] = {
+#define ATLAS_TRACE_NAME(name, format) #name,
+    ATLAS_TRACE_EVENTS(ATLAS_TRACE_NAME)
+#undef ATLAS_TRACE_NAME
+};
+
+//! 表示形式
+const char* const EVENT_FORMATS[] = {
+#define ATLAS_TRACE_FORMAT(name, format) format,
+    ATLAS_TRACE_EVENTS(ATLAS_TRACE_FORMAT)
+#undef ATLAS_TRACE_FORMAT
+};
+
+static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) == NUM_EVENTS,
+              "event table size mismatch");
+
+//! コマンドライン引数
+struct Options
+{
+    std::string input = "-";    //!< 入力ファイル（- なら標準入力）
+    bool text = false;          //!< フレーム以外のバイトを表示するかどうか
+    bool summary = false;       //!< イベントごとの数を表示するかどうか
+};
+
+void usage(const char* prog)
+{
+    std::fprintf(stderr,
+        "usage: %s [options] [FILE]\n"
+        "  -t                also print text between frames (debug messages)\n"
+        "  -s                print the number of records per event\n"
+        "  FILE              captured serial data or BLE notifications (default: stdin)\n",
+        prog
+    );
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-t") {
+            opts.text = true;
+        }
+        else if (arg == "-s") {
+            opts.summary = true;
+        }
+        else if (arg == "-" || arg[0] != '-') {
+            opts.input = arg;
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! data[pos] からフレームを読めるか（ヘッダとすべての記録が正しいか）
+bool isFrame(const std::string& data, std::size_t pos, TraceFrameHeader& header)
+{
+    if (pos + sizeof(TraceFrameHeader) > data.size()) {
+        return false;
+    }
+    std::memcpy(&header, data.data() + pos, sizeof(header));
+    if (header.magic0 != TraceFrameHeader::MAGIC0 ||
+        header.magic1 != TraceFrameHeader::MAGIC1 ||
+        header.version != TraceFrameHeader::VERSION ||
+        header.count == 0 || header.count > TraceFrameHeader::MAX_RECORDS ||
+        pos + sizeof(header) + header.count * sizeof(TraceRecord) > data.size()
+    ) {
+        return false;
+    }
+    for (std::uint8_t i = 0; i < header.count; ++i) {
+        TraceRecord record;
+        std::memcpy(&record, data.data() + pos + sizeof(header) + i * sizeof(TraceRecord),
+                    sizeof(record));
+        if (record.event >= NUM_EVENTS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! 記録を表示する状態
+class Printer
+{
+public:
+    void record(const TraceRecord& record) {
+        // 時刻（32ビットの周回を補正する）
+        if (_count > 0 && record.time < _lastTime) {
+            _epoch += 1ULL << 32;
+        }
+        const std::uint64_t time = _epoch + record.time;
+        if (_count == 0) {
+            _first = time;
+        }
+
+        // 通し番号の欠け
+        if (_count > 0) {
+            const auto gap = static_cast<std::uint16_t>(record.seq - _lastSeq - 1);
+            if (gap != 0) {
+                std::printf("%32s ... %u record(s) missing\n", "", gap);
+                _missing += gap;
+            }
+        }
+
+        char msg[160];
+        std::snprintf(msg, sizeof(msg), EVENT_FORMATS[record.event], record.arg0, record.arg1);
+        std::printf("%12.3f ms %+10.3f  %-17s %s\n",
+                    (time - _first) / 1000.0,
+                    _count > 0 ? (time - _lastTimeFull) / 1000.0 : 0.0,
+                    EVENT_NAMES[record.event], msg);
+
+        _perEvent[record.event] += 1;
+        _lastTime = record.time;
+        _lastTimeFull = time;
+        _lastSeq = record.seq;
+        _count += 1;
+    }
+
+    void dropped(std::uint32_t total) {
+        if (total > _dropped) {
+            std::printf("%32s ... %u record(s) dropped on the device\n", "", total - _dropped);
+            _dropped = total;
+        }
+    }
+
+    void summary() const {
+        for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+            if (_perEvent[i] > 0) {
+                std::printf("%-17s %8lu\n", EVENT_NAMES[i], _perEvent[i]);
+            }
+        }
+    }
+
+    unsigned long count() const { return _count; }
+    unsigned long missing() const { return _missing; }
+    std::uint32_t droppedTotal() const { return _dropped; }
+
+private:
+    unsigned long _count = 0;
+    unsigned long _missing = 0;
+    std::uint32_t _dropped = 0;
+    std::uint64_t _epoch = 0;
+    std::uint64_t _first = 0;
+    std::uint64_t _lastTimeFull = 0;
+    std::uint32_t _lastTime = 0;
+    std::uint16_t _lastSeq = 0;
+    unsigned long _perEvent[NUM_EVENTS] = {};
+};
+
+//-----------------------------------------------------------------------------
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string data;
+    if (opts.input == "-") {
+        data.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    }
+    else {
+        std::ifstream ifs(opts.input, std::ios::binary);
+        if (!ifs) {
+            std::fprintf(stderr, "cannot read %s\n", opts.input.c_str());
+            return 2;
+        }
+        data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    Printer printer;
+    std::string text;
+    std::size_t pos = 0;
+    while (pos < data.size()) {
+        TraceFrameHeader header;
+        if (!isFrame(data, pos, header)) {
+            // フレーム以外（デバッグメッセージ）
+            const char c = data[pos++];
+            if (c == '\n') {
+                if (opts.text && !text.empty()) {
+                    std::printf("%32s | %s\n", "", text.c_str());
+                }
+                text.clear();
+            }
+            else if (c != '\r') {
+                text += c;
+            }
+            continue;
+        }
+
+        printer.dropped(header.dropped);
+        pos += sizeof(header);
+        for (std::uint8_t i = 0; i < header.count; ++i) {
+            TraceRecord record;
+            std::memcpy(&record, data.data() + pos, sizeof(record));
+            printer.record(record);
+            pos += sizeof(record);
+        }
+    }
+    if (opts.text && !text.empty()) {
+        std::printf("%32s | %s\n", "", text.c_str());
+    }
+
+    std::printf("%lu record(s), %lu missing, %u dropped on the device\n",
+                printer.count(), printer.missing(), printer.droppedTotal());
+    if (opts.summary) {
+        printer.summary();
+    }
+    return 0;
+}